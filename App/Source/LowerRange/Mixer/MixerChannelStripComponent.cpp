@@ -41,7 +41,8 @@ MixerChannelStripComponent::MixerChannelStripComponent(EditViewState &evs, te::T
     : m_evs(evs),
       m_track(track),
       m_volumeSlider(m_evs.m_edit.getMasterSliderPosParameter()),
-      m_panSlider(m_evs.m_edit.getMasterPanParameter())
+      m_panSlider(m_evs.m_edit.getMasterPanParameter()),
+      m_cpuUsage(evs, track)
 {
     m_isMasterTrack = m_track != nullptr && m_track->isMasterTrack();
     m_trackName.setText(m_track->getName(), juce::dontSendNotification);
@@ -61,6 +62,8 @@ MixerChannelStripComponent::MixerChannelStripComponent(EditViewState &evs, te::T
     m_panSlider.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
     addAndMakeVisible(m_panSlider);
 
+    addChildComponent(m_cpuUsage);
+
     // Initialize meters
     updateComponentsFromTrack();
 
@@ -99,6 +102,9 @@ MixerChannelStripComponent::MixerChannelStripComponent(EditViewState &evs, te::T
 
     if (m_isMasterTrack)
     {
+        m_loudnessMeter = std::make_unique<LoudnessMeterComponent>(LoudnessMeter::getMasterOutputMeter(m_evs.m_edit.engine), m_evs.m_applicationState);
+        addAndMakeVisible(*m_loudnessMeter);
+
         m_soloButton.setVisible(false);
         m_soloButton.setEnabled(false);
         m_armButton.setVisible(false);
@@ -270,6 +276,10 @@ void MixerChannelStripComponent::resized()
     m_armButton.setBounds(buttonArea);
 
     m_panSlider.setBounds(area.removeFromTop(50));
+    m_cpuUsage.setBounds(m_panSlider.getBounds().removeFromTop(14).reduced(4, 0));
+
+    if (m_loudnessMeter)
+        m_loudnessMeter->setBounds(area.removeFromBottom(60).reduced(2, 0));
 
     auto meterWidth = 6;
     m_volumeSlider.setBounds(area);
@@ -280,3 +290,37 @@ void MixerChannelStripComponent::resized()
     if (m_levelMeterRight)
         m_levelMeterRight->setBounds(area.removeFromRight(meterWidth).reduced(0, 13));
 }
+
+void MixerChannelStripComponent::mouseDown(const juce::MouseEvent &e)
+{
+    if (!e.mods.isPopupMenu())
+        return;
+
+    auto &profiler = m_evs.getCpuProfiler();
+
+    juce::PopupMenu m;
+    m.addItem("Show CPU usage", true, m_evs.m_showCpuUsage.get(), [this] { m_evs.m_showCpuUsage = !m_evs.m_showCpuUsage.get(); });
+    m.addSeparator();
+
+    if (profiler.isTracing())
+        m.addItem("Stop CPU trace", [&profiler] { profiler.stopTrace(); });
+    else
+        m.addItem("Start CPU trace", [&profiler] { profiler.startTrace(); });
+
+    m.addItem("Export CPU trace...", profiler.hasTrace(), false,
+              [&profiler]
+              {
+                  auto fc = std::make_shared<juce::FileChooser>("Export CPU trace", juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("cpu_trace.csv"), "*.csv");
+
+                  fc->launchAsync(juce::FileBrowserComponent::saveMode + juce::FileBrowserComponent::canSelectFiles + juce::FileBrowserComponent::warnAboutOverwriting,
+                                  [fc, &profiler](const juce::FileChooser &)
+                                  {
+                                      auto file = fc->getResult();
+
+                                      if (file != juce::File() && !profiler.writeTraceToCsv(file.withFileExtension(".csv")))
+                                          GUIHelpers::log("ERROR: could not write CPU trace to " + file.getFullPathName());
+                                  });
+              });
+
+    m.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(this));
+}
@@ -24,7 +24,9 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "UI/Controls/AutomatableParameter.h"
 #include "UI/Controls/AutomatableSlider.h"
+#include "UI/CpuUsageComponent.h"
 #include "UI/LevelMeterComponent.h"
+#include "UI/LoudnessMeterComponent.h"
 #include "Utilities/EditViewState.h"
 #include <juce_gui_basics/juce_gui_basics.h>
 
@@ -40,6 +42,7 @@ public:
 
     void paint(juce::Graphics &) override;
     void resized() override;
+    void mouseDown(const juce::MouseEvent &) override;
 
     void updateComponentsFromTrack();
 
@@ -60,6 +63,8 @@ private:
     AutomatableSliderComponent m_panSlider;
     std::unique_ptr<LevelMeterComponent> m_levelMeterLeft;
     std::unique_ptr<LevelMeterComponent> m_levelMeterRight;
+    std::unique_ptr<LoudnessMeterComponent> m_loudnessMeter; // master only
+    CpuUsageComponent m_cpuUsage;
     juce::TextButton m_muteButton, m_soloButton, m_armButton;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MixerChannelStripComponent)
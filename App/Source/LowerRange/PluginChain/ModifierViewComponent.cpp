@@ -321,7 +321,7 @@ StepModifierComponent::StepDisplay::StepDisplay(te::StepModifier &m)
     : m_modifier(m)
 {
     updateSteps();
-    startTimerHz(30);
+    startMeterUpdates(*this);
 }
 
 void StepModifierComponent::StepDisplay::paint(juce::Graphics &g)
@@ -358,19 +358,19 @@ void StepModifierComponent::StepDisplay::sliderValueChanged(juce::Slider *slider
         m_modifier.setStep(index, (float)slider->getValue());
 }
 
-void StepModifierComponent::StepDisplay::timerCallback()
+bool StepModifierComponent::StepDisplay::meterTick()
 {
-    int newStep = m_modifier.getCurrentStep();
-    if (newStep != m_currentStep)
-    {
-        m_currentStep = newStep;
-        repaint();
-    }
-
     // Also check if numSteps has changed to update slider count
     int num = (int)m_modifier.numStepsParam->getCurrentValue();
     if (num != m_sliders.size())
         updateSteps();
+
+    int newStep = m_modifier.getCurrentStep();
+    if (newStep == m_currentStep)
+        return false;
+
+    m_currentStep = newStep;
+    return true;
 }
 
 void StepModifierComponent::StepDisplay::updateSteps()
@@ -14,6 +14,7 @@
 #include "UI/Controls/AutomatableParameter.h"
 #include "UI/Controls/ParameterComponent.h"
 #include "Utilities/EditViewState.h"
+#include "Utilities/MeterHub.h"
 #include <JuceHeader.h>
 #include <tracktion_engine/tracktion_engine.h>
 
@@ -120,14 +121,14 @@ private:
     class StepDisplay
         : public juce::Component
         , public juce::Slider::Listener
-        , private juce::Timer
+        , private MeterHub::Client
     {
     public:
         StepDisplay(te::StepModifier &m);
         void paint(juce::Graphics &g) override;
         void resized() override;
         void sliderValueChanged(juce::Slider *slider) override;
-        void timerCallback() override;
+        bool meterTick() override;
         void updateSteps();
 
     private:
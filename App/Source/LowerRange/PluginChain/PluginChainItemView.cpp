@@ -156,6 +156,10 @@ PluginChainItemView::PluginChainItemView(EditViewState &evs, te::Track::Ptr t, t
             addAndMakeVisible(*m_presetManager);
         }
     }
+
+    // on top of the plugin component
+    m_cpuUsage = std::make_unique<CpuUsageComponent>(evs, m_track, m_plugin);
+    addChildComponent(*m_cpuUsage);
 }
 
 PluginChainItemView::PluginChainItemView(EditViewState &evs, te::Track::Ptr t, te::Modifier::Ptr m)
@@ -235,6 +239,7 @@ void PluginChainItemView::mouseDown(const juce::MouseEvent &e)
             {
                 m.addItem("Delete", [this] { m_plugin->deleteFromParent(); });
                 m.addItem(m_plugin->isEnabled() ? "Disable" : "Enable", [this] { m_plugin->setEnabled(!m_plugin->isEnabled()); });
+                m.addItem("Show CPU usage", true, m_evs.m_showCpuUsage.get(), [this] { m_evs.m_showCpuUsage = !m_evs.m_showCpuUsage.get(); });
             }
             else if (m_modifier)
             {
@@ -320,6 +325,9 @@ void PluginChainItemView::resized()
     area.removeFromRight(m_headerWidth); // protect rounded rect
     area.reduce(2, 2);
 
+    if (m_cpuUsage)
+        m_cpuUsage->setBounds(area.getRight() - 70, area.getBottom() - 14, 70, 14);
+
     if (m_presetManager)
         m_presetManager->setBounds(area.removeFromLeft(130));
 
@@ -13,6 +13,7 @@
 #include "LowerRange/PluginChain/ModifierViewComponent.h"
 #include "LowerRange/PluginChain/PluginViewComponent.h"
 #include "LowerRange/PluginChain/PresetManagerComponent.h"
+#include "UI/CpuUsageComponent.h"
 #include "Utilities/EditViewState.h"
 #include <JuceHeader.h>
 #include <tracktion_engine/tracktion_engine.h>
@@ -79,6 +80,7 @@ private:
     std::unique_ptr<ModifierViewComponent> m_modifierComponent;
 
     std::unique_ptr<PresetManagerComponent> m_presetManager;
+    std::unique_ptr<CpuUsageComponent> m_cpuUsage;
     BorderlessButton m_showPluginBtn;
     bool m_clickOnHeader{false};
     bool m_collapsed{false};
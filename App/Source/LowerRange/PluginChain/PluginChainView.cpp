@@ -1256,7 +1256,18 @@ void PluginChainView::handleAsyncUpdate()
 
 void PluginChainView::rebuildView()
 {
-    m_contentComp->m_rackItems.clear();
+    auto &rackItems = m_contentComp->m_rackItems;
+
+    // Take the existing views out of the array, views of plugins that are
+    // still in the chain are reused, so adding, removing or moving a single
+    // plugin doesn't recreate every plugin editor in the rack.
+    std::map<te::Plugin *, std::unique_ptr<PluginChainItemView>> oldItems;
+    for (int i = rackItems.size(); --i >= 0;)
+    {
+        std::unique_ptr<PluginChainItemView> item(rackItems.removeAndReturn(i));
+        if (auto plugin = item->getPlugin())
+            oldItems[plugin.get()] = std::move(item);
+    }
 
     if (m_track != nullptr)
     {
@@ -1269,13 +1280,23 @@ void PluginChainView::rebuildView()
 
             if (auto p = getPluginFromList(m_track->pluginList, id))
             {
+                if (auto it = oldItems.find(p.get()); it != oldItems.end())
+                {
+                    rackItems.add(it->second.release());
+                    oldItems.erase(it);
+                    continue;
+                }
+
                 auto view = std::make_unique<PluginChainItemView>(m_evs, m_track, p);
                 m_contentComp->addAndMakeVisible(view.get());
-                m_contentComp->m_rackItems.add(std::move(view));
+                rackItems.add(std::move(view));
             }
         }
     }
 
+    // views of removed plugins are deleted here
+    oldItems.clear();
+
     rebuildPluginList();
 
     if (getSelectedRackItemIndex() < 0 && m_contentComp->m_rackItems.size() > 0)
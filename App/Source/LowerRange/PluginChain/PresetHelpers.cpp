@@ -9,11 +9,20 @@
 */
 
 #include "LowerRange/PluginChain/PresetHelpers.h"
+#include "LowerRange/PluginChain/PresetLibrary.h"
 #include "Utilities/Utilities.h" // For GUIHelpers logging if needed
 
 namespace PresetHelpers
 {
 
+namespace
+{
+// "NXTP" followed by the format version and flags, then the ValueTree stream
+constexpr juce::uint32 binaryPresetMagic = 0x5054584e;
+constexpr int binaryPresetVersion = 1;
+constexpr int binaryPresetCompressedFlag = 1;
+} // namespace
+
 juce::String getPluginPresetFolder(te::Plugin &plugin)
 {
     if (auto *ep = dynamic_cast<te::ExternalPlugin *>(&plugin))
@@ -48,39 +57,101 @@ juce::File getPresetDirectory(PluginPresetInterface &interface)
 
 bool tryLoadInitPreset(PluginPresetInterface &interface)
 {
-    auto presetDir = getPresetDirectory(interface);
-    auto presetFile = presetDir.getChildFile("init.nxtpreset");
+    // The library caches the parsed init preset, so inserting the same
+    // plugin type again doesn't touch the disk.
+    auto presetState = PresetLibrary::getInstance()->getPresetState(getPresetDirectory(interface), "init");
+
+    if (!presetState.isValid())
+        return false;
+
+    // Validate that the preset matches the plugin type
+    if (presetState.hasType(juce::Identifier("PLUGIN")) && presetState.getProperty("type") == interface.getPluginTypeName())
+    {
+        // Apply the state
+        interface.restorePluginState(presetState);
+
+        // Update interface metadata
+        interface.setInitialPresetLoaded(true);
+        interface.setLastLoadedPresetName("init");
+
+        return true;
+    }
+
+    GUIHelpers::log("Error loading init preset: Type mismatch. Expected " + interface.getPluginTypeName());
+    return false;
+}
+
+juce::ValueTree readPresetFile(const juce::File &file)
+{
+    juce::FileInputStream in(file);
+    if (!in.openedOk())
+    {
+        GUIHelpers::log("Error opening preset " + file.getFullPathName());
+        return {};
+    }
 
-    if (presetFile.existsAsFile())
+    if (in.getTotalLength() >= 12 && (juce::uint32) in.readInt() == binaryPresetMagic)
     {
-        // Use XmlDocument::parse for robust XML parsing
-        if (auto xml = std::unique_ptr<juce::XmlElement>(juce::XmlDocument::parse(presetFile)))
+        auto version = in.readInt();
+        auto flags = in.readInt();
+
+        if (version > binaryPresetVersion)
         {
-            juce::ValueTree presetState = juce::ValueTree::fromXml(*xml);
-
-            // Validate that the preset matches the plugin type
-            if (presetState.hasType(juce::Identifier("PLUGIN")) && presetState.getProperty("type") == interface.getPluginTypeName())
-            {
-                // Apply the state
-                interface.restorePluginState(presetState);
-
-                // Update interface metadata
-                interface.setInitialPresetLoaded(true);
-                interface.setLastLoadedPresetName("init");
-
-                return true;
-            }
-            else
-            {
-                GUIHelpers::log("Error loading init preset: Type mismatch. Expected " + interface.getPluginTypeName());
-            }
+            GUIHelpers::log("Preset " + file.getFileName() + " was written by a newer version (format " + juce::String(version) + ")");
+            return {};
+        }
+
+        if (flags & binaryPresetCompressedFlag)
+        {
+            juce::GZIPDecompressorInputStream gzip(in);
+            return juce::ValueTree::readFromStream(gzip);
+        }
+
+        return juce::ValueTree::readFromStream(in);
+    }
+
+    in.setPosition(0);
+
+    if (auto xml = juce::XmlDocument::parse(in.readEntireStreamAsString()))
+        return juce::ValueTree::fromXml(*xml);
+
+    GUIHelpers::log("Error parsing preset XML in " + file.getFullPathName());
+    return {};
+}
+
+bool writePresetFile(const juce::File &file, const juce::ValueTree &state, bool binary, bool compress)
+{
+    if (!binary)
+    {
+        if (auto xml = state.createXml())
+            return xml->writeTo(file, {});
+
+        return false;
+    }
+
+    juce::TemporaryFile temp(file);
+
+    {
+        juce::FileOutputStream out(temp.getFile());
+        if (!out.openedOk())
+            return false;
+
+        out.writeInt((int) binaryPresetMagic);
+        out.writeInt(binaryPresetVersion);
+        out.writeInt(compress ? binaryPresetCompressedFlag : 0);
+
+        if (compress)
+        {
+            juce::GZIPCompressorOutputStream gzip(out);
+            state.writeToStream(gzip);
         }
         else
         {
-            GUIHelpers::log("Error parsing init preset XML for " + interface.getPluginTypeName());
+            state.writeToStream(out);
         }
     }
-    return false;
+
+    return temp.overwriteTargetFileWithTemporary();
 }
 
 } // namespace PresetHelpers
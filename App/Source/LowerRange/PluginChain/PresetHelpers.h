@@ -37,4 +37,21 @@ juce::String getPluginPresetFolder(te::Plugin &plugin);
  * @return true if an init preset was found and successfully loaded, false otherwise.
  */
 bool tryLoadInitPreset(PluginPresetInterface &interface);
+
+/**
+ * Reads a .nxtpreset file. Binary presets are recognised by their magic
+ * header, everything else is parsed as XML.
+ *
+ * @return the preset state, or an invalid tree if the file couldn't be read.
+ */
+juce::ValueTree readPresetFile(const juce::File &file);
+
+/**
+ * Writes a preset either as XML or in the binary format, which stores the
+ * ValueTree binary stream behind a small versioned header and can be
+ * gzip compressed. Both formats use the .nxtpreset extension.
+ *
+ * @return true if the file was written.
+ */
+bool writePresetFile(const juce::File &file, const juce::ValueTree &state, bool binary, bool compress = true);
 } // namespace PresetHelpers
\ No newline at end of file
@@ -0,0 +1,268 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#include "LowerRange/PluginChain/PresetLibrary.h"
+#include "LowerRange/PluginChain/PresetHelpers.h"
+#include "Utilities/Utilities.h"
+
+JUCE_IMPLEMENT_SINGLETON(PresetLibrary)
+
+namespace
+{
+juce::StringArray getTagsFromState(const juce::ValueTree &state)
+{
+    juce::StringArray tags;
+    tags.addTokens(state.getProperty("tags").toString(), ",", "\"");
+    tags.trim();
+    tags.removeEmptyStrings();
+    return tags;
+}
+} // namespace
+
+PresetLibrary::PresetLibrary() = default;
+
+PresetLibrary::~PresetLibrary()
+{
+    stopTimer();
+    m_parsePool.removeAllJobs(true, 2000);
+    clearSingletonInstance();
+}
+
+juce::Array<PresetLibrary::PresetInfo> PresetLibrary::getPresets(const juce::File &folder)
+{
+    const juce::ScopedLock sl(m_lock);
+
+    juce::Array<PresetInfo> presets;
+    for (auto &entry : getFolder(folder).entries)
+        presets.add(entry.info);
+
+    return presets;
+}
+
+juce::StringArray PresetLibrary::getPresetNames(const juce::File &folder)
+{
+    const juce::ScopedLock sl(m_lock);
+
+    juce::StringArray names;
+    for (auto &entry : getFolder(folder).entries)
+        names.add(entry.info.name);
+
+    return names;
+}
+
+juce::ValueTree PresetLibrary::getPresetState(const juce::File &folder, const juce::String &name)
+{
+    juce::File file;
+    {
+        const juce::ScopedLock sl(m_lock);
+
+        auto *entry = findEntry(getFolder(folder), name);
+        if (entry == nullptr)
+            return {};
+
+        // the file could have been overwritten without touching the folder
+        if (entry->parsed && entry->info.file.getLastModificationTime() == entry->info.modified)
+            return entry->state.createCopy();
+
+        file = entry->info.file;
+    }
+
+    auto modified = file.getLastModificationTime();
+    auto state = parsePresetFile(file);
+    storeParsedState(folder, file, modified, state);
+
+    return state.createCopy();
+}
+
+void PresetLibrary::prefetch(const juce::File &folder, int index, int range)
+{
+    juce::Array<juce::File> files;
+    {
+        const juce::ScopedLock sl(m_lock);
+
+        auto &f = getFolder(folder);
+        auto numEntries = (int) f.entries.size();
+
+        for (int i = index - range; i <= index + range; ++i)
+        {
+            if (i < 0 || i >= numEntries || i == index)
+                continue;
+
+            auto &entry = f.entries[(size_t) i];
+            if (!entry.parsed)
+                files.add(entry.info.file);
+        }
+    }
+
+    parseInBackground(folder, files);
+}
+
+void PresetLibrary::invalidate(const juce::File &folder)
+{
+    const juce::ScopedLock sl(m_lock);
+
+    auto it = m_folders.find(folder.getFullPathName());
+    if (it != m_folders.end())
+        it->second.needsRescan = true;
+}
+
+juce::ValueTree PresetLibrary::parsePresetFile(const juce::File &file)
+{
+    auto state = PresetHelpers::readPresetFile(file);
+
+    if (state.isValid() && !state.hasType(juce::Identifier("PLUGIN")))
+    {
+        GUIHelpers::log("PresetLibrary: Root element is not <PLUGIN> in " + file.getFileName());
+        return {};
+    }
+
+    return state;
+}
+
+PresetLibrary::Folder &PresetLibrary::getFolder(const juce::File &folder)
+{
+    auto &f = m_folders[folder.getFullPathName()];
+
+    if (f.needsRescan)
+    {
+        scanFolder(folder, f);
+
+        if (!isTimerRunning())
+            startTimer(folderPollIntervalMs);
+    }
+
+    return f;
+}
+
+PresetLibrary::Entry *PresetLibrary::findEntry(Folder &folder, const juce::String &name)
+{
+    for (auto &entry : folder.entries)
+        if (entry.info.name.equalsIgnoreCase(name))
+            return &entry;
+
+    return nullptr;
+}
+
+void PresetLibrary::scanFolder(const juce::File &file, Folder &folder)
+{
+    folder.needsRescan = false;
+    folder.modified = file.getLastModificationTime();
+
+    auto presetFiles = file.findChildFiles(juce::File::findFiles, false, "*.nxtpreset");
+    presetFiles.sort();
+
+    std::vector<Entry> entries;
+    entries.reserve((size_t) presetFiles.size());
+
+    juce::Array<juce::File> filesToParse;
+
+    for (auto &presetFile : presetFiles)
+    {
+        Entry entry;
+        entry.info.name = presetFile.getFileNameWithoutExtension();
+        entry.info.file = presetFile;
+        entry.info.modified = presetFile.getLastModificationTime();
+
+        // keep what we already parsed if the file didn't change
+        if (auto *old = findEntry(folder, entry.info.name))
+        {
+            if (old->parsed && old->info.modified == entry.info.modified)
+            {
+                entry.state = old->state;
+                entry.parsed = true;
+                entry.info.tags = old->info.tags;
+            }
+        }
+
+        if (!entry.parsed)
+            filesToParse.add(presetFile);
+
+        entries.push_back(std::move(entry));
+    }
+
+    folder.entries = std::move(entries);
+
+    parseInBackground(file, filesToParse);
+}
+
+void PresetLibrary::parseInBackground(const juce::File &folder, const juce::Array<juce::File> &files)
+{
+    if (files.isEmpty())
+        return;
+
+    m_parsePool.addJob(
+        [this, folder, files]
+        {
+            for (auto &file : files)
+            {
+                if (juce::ThreadPoolJob::getCurrentThreadPoolJob()->shouldExit())
+                    return;
+
+                auto modified = file.getLastModificationTime();
+                storeParsedState(folder, file, modified, parsePresetFile(file));
+            }
+        });
+}
+
+void PresetLibrary::storeParsedState(const juce::File &folder, const juce::File &file, juce::Time modified, const juce::ValueTree &state)
+{
+    const juce::ScopedLock sl(m_lock);
+
+    auto it = m_folders.find(folder.getFullPathName());
+    if (it == m_folders.end())
+        return;
+
+    for (auto &entry : it->second.entries)
+    {
+        if (entry.info.file == file)
+        {
+            entry.state = state;
+            entry.parsed = true;
+            entry.info.modified = modified;
+            entry.info.tags = getTagsFromState(state);
+            return;
+        }
+    }
+}
+
+void PresetLibrary::timerCallback()
+{
+    bool changed = false;
+
+    {
+        const juce::ScopedLock sl(m_lock);
+
+        for (auto &[path, folder] : m_folders)
+        {
+            if (folder.needsRescan)
+                continue;
+
+            if (juce::File(path).getLastModificationTime() != folder.modified)
+            {
+                folder.needsRescan = true;
+                changed = true;
+            }
+        }
+    }
+
+    if (changed)
+        sendChangeMessage();
+}
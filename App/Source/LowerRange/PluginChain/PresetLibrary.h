@@ -0,0 +1,96 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <map>
+
+// Process wide index of the preset folders. Every folder is listed once and
+// kept sorted, the presets themselves are parsed on a background thread and
+// the resulting ValueTrees are cached until the file changes. A timer polls
+// the modification time of the known folders and sends a change message when
+// presets were added or removed, so preset lists can refresh themselves.
+class PresetLibrary : public juce::ChangeBroadcaster,
+                      private juce::Timer,
+                      private juce::DeletedAtShutdown
+{
+public:
+    struct PresetInfo
+    {
+        juce::String name;
+        juce::File file;
+        juce::Time modified;
+        juce::StringArray tags; // empty until the preset was parsed
+    };
+
+    PresetLibrary();
+    ~PresetLibrary() override;
+
+    // Sorted by name, the folder is scanned on first access.
+    juce::Array<PresetInfo> getPresets(const juce::File &folder);
+    juce::StringArray getPresetNames(const juce::File &folder);
+
+    // Returns a copy of the parsed preset or an invalid tree if the preset
+    // doesn't exist or couldn't be parsed. Parses synchronously on a cache miss.
+    juce::ValueTree getPresetState(const juce::File &folder, const juce::String &name);
+
+    // Queues the presets around index for parsing, e.g. the neighbours of
+    // the currently selected preset so next/previous loads are instant.
+    void prefetch(const juce::File &folder, int index, int range = 1);
+
+    // Call after writing into a folder, it's rescanned on the next access.
+    void invalidate(const juce::File &folder);
+
+    static juce::ValueTree parsePresetFile(const juce::File &file);
+
+    JUCE_DECLARE_SINGLETON(PresetLibrary, false)
+
+private:
+    struct Entry
+    {
+        PresetInfo info;
+        juce::ValueTree state;
+        bool parsed = false;
+    };
+
+    struct Folder
+    {
+        juce::Time modified;
+        bool needsRescan = true;
+        std::vector<Entry> entries;
+    };
+
+    Folder &getFolder(const juce::File &folder);
+    Entry *findEntry(Folder &folder, const juce::String &name);
+    void scanFolder(const juce::File &file, Folder &folder);
+    void parseInBackground(const juce::File &folder, const juce::Array<juce::File> &files);
+    void storeParsedState(const juce::File &folder, const juce::File &file, juce::Time modified, const juce::ValueTree &state);
+    void timerCallback() override;
+
+    static constexpr int folderPollIntervalMs = 2000;
+
+    std::map<juce::String, Folder> m_folders;
+    juce::CriticalSection m_lock;
+    juce::ThreadPool m_parsePool{juce::ThreadPool::Options{}.withNumberOfThreads(1).withThreadName("Preset Parser")};
+
+    JUCE_DECLARE_NON_COPYABLE(PresetLibrary)
+};
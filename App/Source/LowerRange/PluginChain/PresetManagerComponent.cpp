@@ -21,6 +21,7 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 
 #include "LowerRange/PluginChain/PresetManagerComponent.h"
 #include "LowerRange/PluginChain/PresetHelpers.h"
+#include "LowerRange/PluginChain/PresetLibrary.h"
 #include "Utilities/Utilities.h"
 
 PresetManagerComponent::PresetManagerComponent(PluginPresetInterface &pluginInterface, juce::Colour headerColour, juce::String title)
@@ -43,6 +44,16 @@ PresetManagerComponent::PresetManagerComponent(PluginPresetInterface &pluginInte
 
     refreshPresetList();
     selectPreset(m_pluginInterface.getLastLoadedPresetName());
+
+    PresetLibrary::getInstance()->addChangeListener(this);
+}
+
+PresetManagerComponent::~PresetManagerComponent() { PresetLibrary::getInstance()->removeChangeListener(this); }
+
+void PresetManagerComponent::changeListenerCallback(juce::ChangeBroadcaster *)
+{
+    // presets were added or removed on disk
+    refreshPresetList();
 }
 
 void PresetManagerComponent::paint(juce::Graphics &g)
@@ -117,23 +128,20 @@ void PresetManagerComponent::refreshPresetList()
     if (m_presetCombo == nullptr)
         return;
 
-    m_presetCombo->clear();
+    auto selectedName = m_presetCombo->getText();
+
+    m_presetCombo->clear(juce::dontSendNotification);
 
-    auto presetDir = getPresetDirectory();
     ensurePresetDirectoryExists();
 
-    // Add all preset files to combo box
-    juce::Array<juce::File> presetFiles;
-    presetDir.findChildFiles(presetFiles, juce::File::findFiles, false, "*.nxtpreset");
+    // Add all preset files to combo box, the library keeps them sorted
+    auto presetNames = PresetLibrary::getInstance()->getPresetNames(getPresetDirectory());
 
-    // Sort alphabetically
-    presetFiles.sort();
+    for (int i = 0; i < presetNames.size(); ++i)
+        m_presetCombo->addItem(presetNames[i], i + 1); // +1 because 0 is not used
 
-    for (int i = 0; i < presetFiles.size(); ++i)
-    {
-        juce::String presetName = presetFiles[i].getFileNameWithoutExtension();
-        m_presetCombo->addItem(presetName, i + 1); // +1 because 0 is not used
-    }
+    if (selectedName.isNotEmpty())
+        selectPreset(selectedName);
 }
 
 void PresetManagerComponent::loadPresetFromCombo()
@@ -141,47 +149,32 @@ void PresetManagerComponent::loadPresetFromCombo()
     if (m_presetCombo == nullptr)
         return;
 
-    int selectedId = m_presetCombo->getSelectedId();
+    int presetIndex = m_presetCombo->getSelectedItemIndex();
+    if (presetIndex < 0)
+        return;
 
     auto presetDir = getPresetDirectory();
-    juce::Array<juce::File> presetFiles;
-    presetDir.findChildFiles(presetFiles, juce::File::findFiles, false, "*.nxtpreset");
-    presetFiles.sort();
+    auto presetName = m_presetCombo->getItemText(presetIndex);
+    auto *library = PresetLibrary::getInstance();
+
+    if (auto presetState = library->getPresetState(presetDir, presetName); presetState.isValid())
+        applyPresetState(presetState, presetName);
 
-    int presetIndex = selectedId - 1; // -1 because 0 is not used
-    if (presetIndex >= 0 && presetIndex < presetFiles.size())
+    library->prefetch(presetDir, presetIndex);
+}
+
+void PresetManagerComponent::applyPresetState(const juce::ValueTree &presetState, const juce::String &presetName)
+{
+    // Check if it's a valid preset for this plugin
+    if (presetState.hasType(juce::Identifier("PLUGIN")) && presetState.getProperty("type") == m_pluginInterface.getPluginTypeName())
     {
-        juce::File presetFile = presetFiles[presetIndex];
-        if (presetFile.existsAsFile())
-        {
-            // Use XmlDocument::parse for robust XML parsing
-            if (auto xml = std::unique_ptr<juce::XmlElement>(juce::XmlDocument::parse(presetFile)))
-            {
-                if (xml->hasTagName("PLUGIN"))
-                {
-                    juce::ValueTree presetState = juce::ValueTree::fromXml(*xml);
-                    // Check if it's a valid preset for this plugin
-                    if (presetState.hasType(juce::Identifier("PLUGIN")) && presetState.getProperty("type") == m_pluginInterface.getPluginTypeName())
-                    {
-                        m_pluginInterface.restorePluginState(presetState);
-                        m_pluginInterface.setLastLoadedPresetName(presetFile.getFileNameWithoutExtension());
-                        m_pluginInterface.setInitialPresetLoaded(true);
-                    }
-                    else
-                    {
-                        GUIHelpers::log("PresetManagerComponent: Preset type mismatch or invalid format in " + presetFile.getFileName());
-                    }
-                }
-                else
-                {
-                    GUIHelpers::log("PresetManagerComponent: Root element is not <PLUGIN> in " + presetFile.getFileName());
-                }
-            }
-            else
-            {
-                GUIHelpers::log("PresetManagerComponent: Failed to parse XML in " + presetFile.getFullPathName());
-            }
-        }
+        m_pluginInterface.restorePluginState(presetState);
+        m_pluginInterface.setLastLoadedPresetName(presetName);
+        m_pluginInterface.setInitialPresetLoaded(true);
+    }
+    else
+    {
+        GUIHelpers::log("PresetManagerComponent: Preset type mismatch or invalid format in " + presetName);
     }
 }
 
@@ -228,9 +221,11 @@ void PresetManagerComponent::savePreset()
         // Update the name property in the captured state
         pluginState.setProperty("name", safePresetName, nullptr);
 
-        if (auto xml = std::unique_ptr<juce::XmlElement>(pluginState.createXml()))
+        auto binary = static_cast<bool>(m_pluginInterface.getApplicationViewState().m_binaryPresets);
+
+        if (PresetHelpers::writePresetFile(presetFile, pluginState, binary))
         {
-            xml->writeTo(presetFile, {});
+            PresetLibrary::getInstance()->invalidate(presetFile.getParentDirectory());
 
             if (safeThis == nullptr)
                 return;
@@ -268,34 +263,8 @@ void PresetManagerComponent::loadPreset()
         juce::File presetFile = fc.getResult();
         if (presetFile.existsAsFile())
         {
-            // Use XmlDocument::parse for robust XML parsing
-            if (auto xml = std::unique_ptr<juce::XmlElement>(juce::XmlDocument::parse(presetFile)))
-            {
-                if (xml->hasTagName("PLUGIN"))
-                {
-                    juce::ValueTree presetState = juce::ValueTree::fromXml(*xml);
-
-                    // Check if it's a valid preset for this plugin
-                    if (presetState.hasType(juce::Identifier("PLUGIN")) && presetState.getProperty("type") == m_pluginInterface.getPluginTypeName())
-                    {
-                        m_pluginInterface.restorePluginState(presetState);
-                        m_pluginInterface.setLastLoadedPresetName(presetFile.getFileNameWithoutExtension());
-                        m_pluginInterface.setInitialPresetLoaded(true);
-                    }
-                    else
-                    {
-                        GUIHelpers::log("PresetManagerComponent: Preset type mismatch or invalid format in " + presetFile.getFileName());
-                    }
-                }
-                else
-                {
-                    GUIHelpers::log("PresetManagerComponent: Root element is not <PLUGIN> in " + presetFile.getFileName());
-                }
-            }
-            else
-            {
-                GUIHelpers::log("PresetManagerComponent: Failed to parse XML in " + presetFile.getFullPathName());
-            }
+            if (auto presetState = PresetLibrary::parsePresetFile(presetFile); presetState.isValid())
+                applyPresetState(presetState, presetFile.getFileNameWithoutExtension());
         }
     }
 }
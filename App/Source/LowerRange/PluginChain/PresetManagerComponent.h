@@ -27,12 +27,14 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
  * Reusable preset management component for all plugins
  * Provides save/load functionality with a combo box showing all presets
  */
-class PresetManagerComponent : public juce::Component
+class PresetManagerComponent
+    : public juce::Component
+    , private juce::ChangeListener
 {
 public:
     // Constructor requires a valid interface reference. No nullptr possible.
     explicit PresetManagerComponent(PluginPresetInterface &pluginInterface, juce::Colour headerColour, juce::String title = "Presets");
-    ~PresetManagerComponent() override = default;
+    ~PresetManagerComponent() override;
 
     void paint(juce::Graphics &g) override;
     void resized() override;
@@ -49,6 +51,8 @@ private:
 
     void refreshPresetList();
     void loadPresetFromCombo();
+    void applyPresetState(const juce::ValueTree &presetState, const juce::String &presetName);
+    void changeListenerCallback(juce::ChangeBroadcaster *source) override;
     void savePreset();
     void loadPreset();
     void selectPreset(const juce::String &name);
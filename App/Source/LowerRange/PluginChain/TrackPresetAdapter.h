@@ -111,6 +111,31 @@ public:
         if (state.getProperty("type").toString() != getPluginTypeName())
             return;
 
+        // Sanitise everything up front, so the track is only touched once
+        // the new states are ready.
+        juce::Array<juce::ValueTree> modifierStates, pluginStates;
+
+        for (const auto &mState : state.getChildWithName("MODIFIERS"))
+        {
+            if (te::ModifierList::isModifier(mState.getType()))
+            {
+                auto mStateCopy = mState.createCopy();
+                sanitiseState(mStateCopy);
+                modifierStates.add(mStateCopy);
+            }
+        }
+
+        for (const auto &pState : state.getChildWithName("PLUGINS"))
+        {
+            auto pStateCopy = pState.createCopy();
+            sanitiseState(pStateCopy);
+            pluginStates.add(pStateCopy);
+        }
+
+        // Every removed or inserted plugin would rebuild the playback graph
+        // on its own, hold that back until the whole preset is applied.
+        te::TransportControl::ReallocationInhibitor inhibitor(m_track.edit.getTransport());
+
         // Clear existing automation to prevent conflicts with the new preset state
         sanitiseState(m_track.state, &m_track.edit.getUndoManager());
 
@@ -129,20 +154,9 @@ public:
                 if (auto m = ml->getModifiers()[i])
                     m->remove();
 
-            auto modsTree = state.getChildWithName("MODIFIERS");
-            if (modsTree.isValid())
-            {
-                int insertIndex = 0;
-                for (const auto &mState : modsTree)
-                {
-                    if (te::ModifierList::isModifier(mState.getType()))
-                    {
-                        auto mStateCopy = mState.createCopy();
-                        sanitiseState(mStateCopy);
-                        ml->insertModifier(mStateCopy, insertIndex++, nullptr);
-                    }
-                }
-            }
+            int insertIndex = 0;
+            for (auto &mState : modifierStates)
+                ml->insertModifier(mState, insertIndex++, nullptr);
         }
 
         for (int i = m_track.pluginList.size() - 1; i >= 0; --i)
@@ -154,17 +168,9 @@ public:
             }
         }
 
-        auto pluginsTree = state.getChildWithName("PLUGINS");
-        if (pluginsTree.isValid())
-        {
-            int insertIndex = 0;
-            for (const auto &pState : pluginsTree)
-            {
-                auto pStateCopy = pState.createCopy();
-                sanitiseState(pStateCopy);
-                m_track.pluginList.insertPlugin(pStateCopy, insertIndex++);
-            }
-        }
+        int insertIndex = 0;
+        for (auto &pState : pluginStates)
+            m_track.pluginList.insertPlugin(pState, insertIndex++);
     }
 
     juce::ValueTree getFactoryDefaultState() override
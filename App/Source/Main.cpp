@@ -33,6 +33,8 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "MainComponent.h"
 #include "Utilities/ApplicationViewState.h"
+#include "UI/PluginScanProcess.h"
+#include "Utilities/HeadlessRenderer.h"
 
 //==============================================================================
 class NextStudioApplication : public juce::JUCEApplication
@@ -43,16 +45,54 @@ public:
 
     const juce::String getApplicationName() override { return ProjectInfo::projectName; }
     const juce::String getApplicationVersion() override { return ProjectInfo::versionString; }
-    bool moreThanOneInstanceAllowed() override { return false; }
+    // render farm machines run many headless instances side by side
+    // and the plugin scanner starts one worker process per scan thread
+    bool moreThanOneInstanceAllowed() override { return HeadlessRenderer::isRenderCommandLine(getCommandLineParameterArray()) || PluginScanWorker::isWorkerCommandLine(getCommandLineParameters()); }
 
     //==============================================================================
-    void initialise(const juce::String & /*commandLine*/) override
+    void initialise(const juce::String &commandLine) override
     {
+        if (PluginScanWorker::isWorkerCommandLine(commandLine))
+        {
+            auto worker = std::make_unique<PluginScanWorker>();
+            if (worker->initialise(commandLine))
+            {
+                m_pluginScanWorker = std::move(worker);
+                return;
+            }
+
+            // never fall through to the GUI, the parent reports the failed launch
+            setApplicationReturnValue(1);
+            quit();
+            return;
+        }
+
         juce::Logger::writeToLog("Welcome to " + getApplicationName() + " v" + getApplicationVersion());
-        mainWindow.reset(new MainWindow(getApplicationName(), m_applicationState));
+
+        if (HeadlessRenderer::isRenderCommandLine(getCommandLineParameterArray()))
+        {
+            m_applicationState = std::make_unique<ApplicationViewState>(false);
+            m_headlessRenderer = std::make_unique<HeadlessRenderer>(*m_applicationState);
+            m_headlessRenderer->onFinished = [this](int exitCode)
+            {
+                setApplicationReturnValue(exitCode);
+                quit();
+            };
+            m_headlessRenderer->start(getCommandLineParameterArray());
+            return;
+        }
+
+        m_applicationState = std::make_unique<ApplicationViewState>();
+        mainWindow.reset(new MainWindow(getApplicationName(), *m_applicationState));
     }
 
-    void shutdown() override { mainWindow = nullptr; }
+    void shutdown() override
+    {
+        mainWindow = nullptr;
+        m_headlessRenderer = nullptr;
+        m_pluginScanWorker = nullptr;
+        m_applicationState = nullptr;
+    }
 
     void systemRequestedQuit() override { quit(); }
 
@@ -101,8 +141,10 @@ public:
     };
 
 private:
-    ApplicationViewState m_applicationState;
+    std::unique_ptr<ApplicationViewState> m_applicationState;
     std::unique_ptr<MainWindow> mainWindow;
+    std::unique_ptr<HeadlessRenderer> m_headlessRenderer;
+    std::unique_ptr<PluginScanWorker> m_pluginScanWorker;
 };
 
 //==============================================================================
@@ -41,6 +41,7 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 #include "SideBrowser/ProjectsBrowser.h"
 #include "SideBrowser/SidebarComponent.h"
 #include "UI/SetupWizard.h"
+#include "Utilities/AutoSaveJournal.h"
 #include "Utilities/Utilities.h"
 
 MainComponent::MainComponent(ApplicationViewState &state)
@@ -80,15 +81,7 @@ MainComponent::MainComponent(ApplicationViewState &state)
         }
     };
 
-    m_engine.getPluginManager().createBuiltInType<SimpleSynthPlugin>();
-    m_engine.getPluginManager().createBuiltInType<ArpeggiatorPlugin>();
-    m_engine.getPluginManager().createBuiltInType<SpectrumAnalyzerPlugin>();
-    m_engine.getPluginManager().createBuiltInType<PeakLimiterPlugin>();
-    m_engine.getPluginManager().createBuiltInType<NextDelayPlugin>();
-    m_engine.getPluginManager().createBuiltInType<NextChorusPlugin>();
-    m_engine.getPluginManager().createBuiltInType<NextPhaserPlugin>();
-    m_engine.getPluginManager().createBuiltInType<NextSaturationPlugin>();
-    m_engine.getPluginManager().createBuiltInType<NextFilterPlugin>();
+    EngineHelpers::registerBuiltInPlugins(m_engine);
 
     openValidStartEdit();
 
@@ -635,7 +628,12 @@ void MainComponent::openValidStartEdit()
         auto result = juce::AlertWindow::showOkCancelBox(juce::AlertWindow::QuestionIcon, "Restore crashed project?", "It seems, NextStudio is crashed last time. Do you want to restore the last session?", "Yes", "No");
         if (result)
         {
-            setupEdit(f);
+            if (!AutoSaveJournal::recover(f))
+                juce::Logger::writeToLog("Error: could not replay autosave journal of " + f.getFullPathName());
+
+            // show an empty arrangement right away, the session is read in the background
+            openEdit(m_tempDir.getNonexistentChildFile("autosave", ".nextTemp", false), {});
+            loadEditAsync(f);
             return;
         }
         else
@@ -722,6 +720,21 @@ void MainComponent::setupEdit(juce::File editFile)
         if (!handleUnsavedEdit())
             return;
     }
+
+    if (editFile.existsAsFile())
+        loadEditAsync(editFile);
+    else
+        openEdit(editFile, {});
+}
+
+void MainComponent::loadEditAsync(const juce::File &editFile)
+{
+    // the current edit stays open until the new one is read
+    m_editLoader = std::make_unique<EditLoader>(m_engine, editFile, [this](const juce::File &file, const juce::ValueTree &state) { openEdit(file, state); });
+}
+
+void MainComponent::openEdit(juce::File editFile, const juce::ValueTree &loadedState)
+{
     if (m_tempDir.exists() && (editFile.getParentDirectory() != m_tempDir))
         m_tempDir.deleteRecursively();
 
@@ -732,15 +745,25 @@ void MainComponent::setupEdit(juce::File editFile)
     if (isNewEdit)
         editFile = m_tempDir.getNonexistentChildFile("autosave", ".nextTemp", false);
 
+    auto previousEditFile = m_edit != nullptr ? m_edit->editFileRetriever() : juce::File();
+
     m_lowerRange = nullptr;
     m_selectionManager.deselectAll();
     m_editComponent = nullptr;
 
-    if (editFile.existsAsFile())
-        m_edit = te::loadEditFromFile(m_engine, editFile);
+    if (loadedState.isValid())
+        m_edit = EditLoader::createEdit(m_engine, editFile, loadedState);
     else
         m_edit = te::createEmptyEdit(m_engine, editFile);
 
+    // drop the autosave of the edit that was open before, e.g. the empty one
+    // shown while a crashed session is restored
+    if (previousEditFile != editFile && previousEditFile.getParentDirectory() == m_tempDir)
+    {
+        previousEditFile.deleteFile();
+        AutoSaveJournal::getJournalFile(previousEditFile).deleteFile();
+    }
+
     if (isNewEdit)
         clearAudioTracks();
 
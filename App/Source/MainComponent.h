@@ -41,6 +41,7 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 #include "UI/HeaderComponent.h"
 #include "UI/PluginWindow.h"
 #include "Utilities/ApplicationViewState.h"
+#include "Utilities/EditLoader.h"
 #include "Utilities/EditViewState.h"
 #include "Utilities/ExtendedUIBehavior.h"
 #include "Utilities/NextLookAndFeel.h"
@@ -107,6 +108,8 @@ private:
     void saveSettings();
     void createTracksAndAssignInputs();
     void openValidStartEdit();
+    void loadEditAsync(const juce::File &editFile);
+    void openEdit(juce::File editFile, const juce::ValueTree &loadedState);
     void setupSideBrowser();
     void ensureUserDirectoriesAndSamples();
     void launchSetupWizardAsync();
@@ -162,6 +165,7 @@ private:
     std::unique_ptr<EditorContainer> m_editorContainer;
     std::unique_ptr<LowerRangeComponent> m_lowerRange;
     std::unique_ptr<SidebarComponent> m_sideBarBrowser;
+    std::unique_ptr<EditLoader> m_editLoader;
     SplitterComponent m_sidebarSplitter;
 
     [[maybe_unused]] bool m_settingsLoaded{false};
@@ -18,15 +18,16 @@ juce::String formatPeakValue(float db)
 class PeakLimiterPluginComponent::MeterComponent : public juce::Component
 {
 public:
-    void setValues(float inputPeakDb, float outputPeakDb, float gainReductionDb)
+    // returns true if the meter needs a repaint
+    bool setValues(float inputPeakDb, float outputPeakDb, float gainReductionDb)
     {
         if (juce::approximatelyEqual(m_inputPeakDb, inputPeakDb) && juce::approximatelyEqual(m_outputPeakDb, outputPeakDb) && juce::approximatelyEqual(m_gainReductionDb, gainReductionDb))
-            return;
+            return false;
 
         m_inputPeakDb = inputPeakDb;
         m_outputPeakDb = outputPeakDb;
         m_gainReductionDb = gainReductionDb;
-        repaint();
+        return true;
     }
 
     void paint(juce::Graphics &g) override
@@ -122,10 +123,11 @@ PeakLimiterPluginComponent::PeakLimiterPluginComponent(EditViewState &evs, te::P
     m_outputMeterLabel.setText("Output: -inf dB", juce::dontSendNotification);
     m_gainReductionLabel.setText("Reduction: 0.0 dB", juce::dontSendNotification);
 
-    startTimerHz(30);
+    // the hub repaints the meter, the labels repaint themselves
+    startMeterUpdates(*m_meter);
 }
 
-PeakLimiterPluginComponent::~PeakLimiterPluginComponent() { stopTimer(); }
+PeakLimiterPluginComponent::~PeakLimiterPluginComponent() { stopMeterUpdates(); }
 
 void PeakLimiterPluginComponent::paint(juce::Graphics &g)
 {
@@ -163,10 +165,10 @@ void PeakLimiterPluginComponent::resized()
     m_gainReductionLabel.setBounds(meterLabels.removeFromTop(20));
 }
 
-void PeakLimiterPluginComponent::timerCallback()
+bool PeakLimiterPluginComponent::meterTick()
 {
     if (m_peakLimiter == nullptr || m_meter == nullptr)
-        return;
+        return false;
 
     m_inputPeakDb = m_peakLimiter->getInputPeakDb();
     m_outputPeakDb = m_peakLimiter->getOutputPeakDb();
@@ -181,7 +183,7 @@ void PeakLimiterPluginComponent::timerCallback()
     updateLabelText(m_inputMeterLabel, "Input: " + formatPeakValue(m_inputPeakDb));
     updateLabelText(m_outputMeterLabel, "Output: " + formatPeakValue(m_outputPeakDb));
     updateLabelText(m_gainReductionLabel, "Reduction: " + juce::String(m_gainReductionDb, 1) + " dB");
-    m_meter->setValues(m_inputPeakDb, m_outputPeakDb, m_gainReductionDb);
+    return m_meter->setValues(m_inputPeakDb, m_outputPeakDb, m_gainReductionDb);
 }
 
 juce::ValueTree PeakLimiterPluginComponent::getPluginState()
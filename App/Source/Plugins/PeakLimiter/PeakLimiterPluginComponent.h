@@ -6,12 +6,13 @@
 #include "Plugins/PeakLimiter/PeakLimiterPlugin.h"
 #include "UI/Controls/AutomatableParameter.h"
 #include "UI/Controls/AutomatableToggle.h"
+#include "Utilities/MeterHub.h"
 
 namespace te = tracktion_engine;
 
 class PeakLimiterPluginComponent
     : public PluginViewComponent
-    , private juce::Timer
+    , private MeterHub::Client
 {
 public:
     PeakLimiterPluginComponent(EditViewState &, te::Plugin::Ptr);
@@ -31,7 +32,7 @@ public:
 private:
     class MeterComponent;
 
-    void timerCallback() override;
+    bool meterTick() override;
 
     PeakLimiterPlugin *m_peakLimiter = nullptr;
 
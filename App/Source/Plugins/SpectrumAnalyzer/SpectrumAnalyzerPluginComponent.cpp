@@ -21,14 +21,10 @@ SpectrumAnalyzerPluginComponent::SpectrumAnalyzerPluginComponent(EditViewState &
     if (auto *analyzer = getAnalyzer())
         analyzer->copySpectrum(m_spectrum);
 
-    updateTimerState();
+    startMeterUpdates(*this);
 }
 
-SpectrumAnalyzerPluginComponent::~SpectrumAnalyzerPluginComponent()
-{
-    stopTimer();
-    m_timerRunning = false;
-}
+SpectrumAnalyzerPluginComponent::~SpectrumAnalyzerPluginComponent() { stopMeterUpdates(); }
 
 void SpectrumAnalyzerPluginComponent::paint(juce::Graphics &g)
 {
@@ -169,31 +165,11 @@ void SpectrumAnalyzerPluginComponent::paint(juce::Graphics &g)
     g.strokePath(path, juce::PathStrokeType(2.0f));
 }
 
-void SpectrumAnalyzerPluginComponent::resized() { updateTimerState(); }
-
-void SpectrumAnalyzerPluginComponent::visibilityChanged() { updateTimerState(); }
-
-void SpectrumAnalyzerPluginComponent::parentHierarchyChanged() { updateTimerState(); }
-
-void SpectrumAnalyzerPluginComponent::updateTimerState()
-{
-    const bool shouldRun = getAnalyzer() != nullptr && isShowing() && getWidth() > 48 && getHeight() > 48;
-
-    if (shouldRun == m_timerRunning)
-        return;
-
-    if (shouldRun)
-        startTimerHz(30);
-    else
-        stopTimer();
-
-    m_timerRunning = shouldRun;
-}
-
-void SpectrumAnalyzerPluginComponent::timerCallback()
+bool SpectrumAnalyzerPluginComponent::meterTick()
 {
-    if (!m_timerRunning)
-        return;
+    // the hub skips hidden views, collapsed ones aren't worth the work either
+    if (getAnalyzer() == nullptr || getWidth() <= 48 || getHeight() <= 48)
+        return false;
 
     if (m_plugin != nullptr && !m_plugin->isEnabled())
     {
@@ -208,18 +184,15 @@ void SpectrumAnalyzerPluginComponent::timerCallback()
         }
 
         if (needsClear)
-        {
             m_spectrum.fill(SpectrumAnalyzerPlugin::minDb);
-            repaint();
-        }
 
-        return;
+        return needsClear;
     }
 
     if (auto *analyzer = getAnalyzer())
         analyzer->copySpectrum(m_spectrum);
 
-    repaint();
+    return true;
 }
 
 juce::ValueTree SpectrumAnalyzerPluginComponent::getPluginState()
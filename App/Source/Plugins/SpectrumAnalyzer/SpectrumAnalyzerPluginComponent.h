@@ -2,22 +2,20 @@
 
 #include "LowerRange/PluginChain/PluginViewComponent.h"
 #include "Plugins/SpectrumAnalyzer/SpectrumAnalyzerPlugin.h"
+#include "Utilities/MeterHub.h"
 
 #include <array>
 #include <vector>
 
 class SpectrumAnalyzerPluginComponent
     : public PluginViewComponent
-    , private juce::Timer
+    , private MeterHub::Client
 {
 public:
     SpectrumAnalyzerPluginComponent(EditViewState &evs, te::Plugin::Ptr p);
     ~SpectrumAnalyzerPluginComponent() override;
 
     void paint(juce::Graphics &g) override;
-    void resized() override;
-    void visibilityChanged() override;
-    void parentHierarchyChanged() override;
 
     int getNeededWidth() override { return 3; }
 
@@ -29,8 +27,7 @@ public:
     ApplicationViewState &getApplicationViewState() override;
 
 private:
-    void timerCallback() override;
-    void updateTimerState();
+    bool meterTick() override;
     SpectrumAnalyzerPlugin *getAnalyzer() const noexcept;
     float xForFrequency(juce::Rectangle<float> area, double frequency, double sampleRate) const;
     float yForDb(juce::Rectangle<float> area, float db) const;
@@ -38,7 +35,6 @@ private:
     std::array<float, SpectrumAnalyzerPlugin::numDisplayBins> m_spectrum{};
     std::vector<float> m_sampledY;
     int m_pointCount = 0;
-    bool m_timerRunning = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyzerPluginComponent)
 };
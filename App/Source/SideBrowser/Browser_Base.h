@@ -111,6 +111,7 @@ public:
 
 protected:
     virtual void sortList(int selectedID) = 0;
+    virtual bool matchesSearchTerm(const juce::File &file) const { return file.getFileNameWithoutExtension().containsIgnoreCase(m_searchTerm); }
     void updateContentList();
     BrowserListBox m_listBox;
     juce::Array<juce::File> m_fileList;
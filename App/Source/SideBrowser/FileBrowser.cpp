@@ -24,6 +24,7 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 #include "SideBrowser/SearchFieldComponent.h"
 #include "UI/PreviewComponent.h"
 #include "Utilities/ApplicationViewState.h"
+#include "Utilities/AudioLibraryIndex.h"
 #include "Utilities/Utilities.h"
 
 FileBrowserComponent::FileBrowserComponent(ApplicationViewState &avs, te::Engine &engine, SamplePreviewComponent &spc)
@@ -77,7 +78,7 @@ void FileBrowserComponent::paintListBoxItem(int rowNum, juce::Graphics &g, int w
     auto icon = bounds.removeFromLeft(height).toFloat();
     bounds.reduce(10, 0);
     icon.reduce(2, 2);
-    if (file.isDirectory())
+    if (isDirectory(file))
         GUIHelpers::drawFromSvg(g, BinaryData::folder_svg, m_applicationViewState.getPrimeColour(), icon);
     else
     {
@@ -128,7 +129,34 @@ void FileBrowserComponent::setDirecory(const juce::File &dir)
     {
         GUIHelpers::log("FileBrowserComponent::setDirecory(): ");
         m_currentPathField.setDir(dir);
-        setFileList(dir.findChildFiles(juce::File::TypesOfFileToFind::findFilesAndDirectories, false));
+
+        // only the latest listing is shown if the user clicks through folders quickly
+        auto listingID = ++m_listingID;
+        juce::Component::SafePointer<FileBrowserComponent> safeThis(this);
+
+        m_listingPool.addJob(
+            [safeThis, dir, listingID]
+            {
+                juce::Array<juce::File> files;
+                std::unordered_set<juce::String> directories;
+
+                for (const auto &entry : juce::RangedDirectoryIterator(dir, false, "*", juce::File::findFilesAndDirectories))
+                {
+                    files.add(entry.getFile());
+                    if (entry.isDirectory())
+                        directories.insert(entry.getFile().getFullPathName());
+                }
+
+                juce::MessageManager::callAsync(
+                    [safeThis, files, directories = std::move(directories), listingID]() mutable
+                    {
+                        if (safeThis == nullptr || safeThis->m_listingID != listingID)
+                            return;
+
+                        safeThis->m_directories = std::move(directories);
+                        safeThis->setFileList(files);
+                    });
+            });
     }
 }
 
@@ -140,7 +168,7 @@ void FileBrowserComponent::sortList(int selectedID)
 
     for (auto f : m_contentList)
     {
-        if (f.isDirectory())
+        if (isDirectory(f))
             dirList.add(f);
         else
             fileList.add(f);
@@ -178,7 +206,7 @@ void FileBrowserComponent::listBoxItemClicked(int row, const juce::MouseEvent &e
 void FileBrowserComponent::listBoxItemDoubleClicked(int row, const juce::MouseEvent &e)
 {
     auto clickedFile = m_contentList[row];
-    if (e.mods.isLeftButtonDown() && clickedFile.isDirectory())
+    if (e.mods.isLeftButtonDown() && isDirectory(clickedFile))
         m_currentPathField.setDir(clickedFile);
 
     if (e.mods.isLeftButtonDown() && clickedFile.getFileName().contains(".tracktionedit"))
@@ -188,7 +216,18 @@ void FileBrowserComponent::listBoxItemDoubleClicked(int row, const juce::MouseEv
     }
 }
 
-void FileBrowserComponent::selectedRowsChanged(int) { previewSampleFile(m_contentList[m_listBox.getSelectedRow()]); }
+void FileBrowserComponent::selectedRowsChanged(int)
+{
+    auto row = m_listBox.getSelectedRow();
+    previewSampleFile(m_contentList[row]);
+
+    juce::Array<juce::File> next;
+    for (auto neighbour : {row + 1, row - 1})
+        if (auto file = m_contentList[neighbour]; !isDirectory(file))
+            next.add(file);
+
+    AudioLibraryIndex::getInstance()->prefetchHeads(next);
+}
 
 void FileBrowserComponent::previewSampleFile(const juce::File &file)
 {
@@ -28,6 +28,7 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 #include "Utilities/ApplicationViewState.h"
 #include "Utilities/EditViewState.h"
 #include "Utilities/Utilities.h"
+#include <unordered_set>
 
 namespace te = tracktion_engine;
 class FileBrowserComponent;
@@ -60,6 +61,16 @@ private:
         static int compareElements(const juce::File &first, const juce::File &second) { return second.getFileName().compareNatural(first.getFileName()); }
     };
     void sortByName(juce::Array<juce::File> &list, bool forward);
+    bool isDirectory(const juce::File &file) const { return m_directories.count(file.getFullPathName()) > 0; }
+
     SamplePreviewComponent &m_samplePreviewComponent;
+
+    // Folders are listed on a background thread, network shares can take
+    // seconds to answer. m_directories remembers which entries are folders
+    // so sorting and painting don't have to ask the file system again.
+    std::unordered_set<juce::String> m_directories;
+    int m_listingID = 0;
+    juce::ThreadPool m_listingPool{juce::ThreadPool::Options{}.withNumberOfThreads(1).withThreadName("File Browser Listing")};
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FileBrowserComponent)
 };
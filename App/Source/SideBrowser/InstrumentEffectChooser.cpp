@@ -32,40 +32,51 @@ InstrumentEffectListModel::InstrumentEffectListModel(tracktion::Engine &engine,
       m_appState(appState)
 {
     updatePluginLists();
+    m_knownPlugins.addChangeListener(this);
+}
+
+InstrumentEffectListModel::~InstrumentEffectListModel() { m_knownPlugins.removeChangeListener(this); }
+
+void InstrumentEffectListModel::changeListenerCallback(juce::ChangeBroadcaster *)
+{
+    // plugins were scanned, removed or blacklisted
+    updatePluginLists();
 }
 
 void InstrumentEffectListModel::updatePluginLists()
 {
-    m_instruments.clear();
-    m_effects.clear();
+    m_index.rebuild(m_knownPlugins, EngineHelpers::getInternalPlugins());
 
-    for (auto &desc : m_knownPlugins.getTypes())
-    {
-        if (desc.isInstrument)
-            m_instruments.add(desc);
-        else
-            m_effects.add(desc);
-    }
+    m_lastQuery.clear();
+    m_lastResults.clear();
 
-    for (auto &desc : EngineHelpers::getInternalPlugins())
-    {
-        if (desc.isInstrument)
-            m_instruments.add(desc);
-        else
-            m_effects.add(desc);
-    }
+    applySearch();
+}
 
-    filterList();
+void InstrumentEffectListModel::applySearch()
+{
+    auto query = m_searchTerm.trim().toLowerCase();
 
-    if (std::get<column>(m_order) == nameCol)
-    {
-        EngineHelpers::sortByName(m_instruments, std::get<bool>(m_order));
-        EngineHelpers::sortByName(m_effects, std::get<bool>(m_order));
-    }
-    else if (std::get<column>(m_order) == typeCol)
+    // typing on only narrows the results of the previous query down
+    const bool isNarrowing = m_lastQuery.isNotEmpty() && query.startsWith(m_lastQuery);
+    auto results = m_index.search(query, [this](const PluginIndex::Entry &entry) { return entry.desc.isInstrument == m_isInstrumentList; }, isNarrowing ? &m_lastResults : nullptr, PluginIndex::getRecentlyUsed(m_appState));
+
+    m_lastQuery = query;
+    m_lastResults = results;
+
+    auto &list = getPluginList();
+    list.clearQuick();
+
+    for (auto index : results)
+        list.add(m_index.getEntries()[(size_t) index].desc);
+
+    // search results keep their ranking, otherwise the chosen column order applies
+    if (query.isEmpty())
     {
-        EngineHelpers::sortByFormatName(m_instruments, std::get<bool>(m_order));
-        EngineHelpers::sortByFormatName(m_effects, std::get<bool>(m_order));
+        if (std::get<column>(m_order) == nameCol)
+            EngineHelpers::sortByName(list, std::get<bool>(m_order));
+        else if (std::get<column>(m_order) == typeCol)
+            EngineHelpers::sortByFormatName(list, std::get<bool>(m_order));
     }
 
     sendChangeMessage();
@@ -94,7 +105,7 @@ void InstrumentEffectListModel::paintCell(juce::Graphics &g, int row, int col, i
 
     juce::PluginDescription desc = m_isInstrumentList ? m_instruments[row] : m_effects[row];
     juce::String text;
-    bool isBlacklisted = m_knownPlugins.getBlacklistedFiles().contains(desc.fileOrIdentifier);
+    bool isBlacklisted = m_index.isBlacklisted(desc.fileOrIdentifier);
 
     if (isBlacklisted)
     {
@@ -232,6 +243,8 @@ tracktion::Plugin::Ptr InstrumentEffectTable::getSelectedPlugin(tracktion::Edit
 
     if (selectedRow < list.size())
     {
+        m_model.pluginWasUsed(list[selectedRow]);
+
         if (list[selectedRow].pluginFormatName == getInternalPluginFormatName())
             return edit.getPluginCache().createNewPlugin(list[selectedRow].category, list[selectedRow]);
         else
@@ -25,11 +25,13 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 #include "SideBrowser/SearchFieldComponent.h"
 #include "Utilities/ApplicationViewState.h"
 #include "Utilities/EditViewState.h"
+#include "Utilities/PluginIndex.h"
 #include "Utilities/Utilities.h"
 
 class InstrumentEffectListModel
     : public juce::TableListBoxModel
     , public juce::ChangeBroadcaster
+    , private juce::ChangeListener
 {
 public:
     enum column
@@ -39,6 +41,7 @@ public:
     };
 
     InstrumentEffectListModel(te::Engine &engine, bool isInstrumentList, ApplicationViewState &appState);
+    ~InstrumentEffectListModel() override;
 
     void paintRowBackground(juce::Graphics &g, int row, int width, int height, bool rowIsSelected) override;
     void paintCell(juce::Graphics &g, int row, int col, int width, int height, bool rowIsSelected) override;
@@ -58,21 +61,14 @@ public:
     void changeSearchTerm(juce::String searchTerm)
     {
         m_searchTerm = searchTerm;
-        updatePluginLists();
+        applySearch();
     }
 
-private:
-    void filterList()
-    {
-        juce::Array<juce::PluginDescription> &list = m_isInstrumentList ? m_instruments : m_effects;
-        juce::Array<juce::PluginDescription> filteredList;
+    void pluginWasUsed(const juce::PluginDescription &desc) { PluginIndex::addRecentlyUsed(m_appState, desc); }
 
-        for (const auto &plugin : list)
-            if (plugin.name.containsIgnoreCase(m_searchTerm))
-                filteredList.add(plugin);
-
-        list = filteredList;
-    }
+private:
+    void applySearch();
+    void changeListenerCallback(juce::ChangeBroadcaster *source) override;
 
     juce::KnownPluginList &m_knownPlugins;
     te::Engine &m_engine;
@@ -84,6 +80,10 @@ private:
 
     juce::String m_searchTerm;
 
+    PluginIndex m_index;
+    juce::String m_lastQuery;
+    std::vector<int> m_lastResults;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(InstrumentEffectListModel)
 };
 
@@ -29,6 +29,14 @@ PluginListBoxModel::PluginListBoxModel(tracktion::Engine &engine, ApplicationVie
       m_engine(engine),
       m_appState(appState)
 {
+    refresh();
+}
+
+void PluginListBoxModel::refresh()
+{
+    // getTypes() copies the whole list, so don't call it while painting
+    m_types = m_knownPlugins.getTypes();
+    m_blacklistedFiles = m_knownPlugins.getBlacklistedFiles();
 }
 
 void PluginListBoxModel::paintRowBackground(juce::Graphics &g, int row, int width, int height, bool rowIsSelected)
@@ -50,19 +58,18 @@ void PluginListBoxModel::paintRowBackground(juce::Graphics &g, int row, int widt
 void PluginListBoxModel::paintCell(juce::Graphics &g, int row, int col, int width, int height, bool rowIsSelected)
 {
     juce::String text;
-    bool isBlacklisted = row >= m_knownPlugins.getNumTypes();
+    bool isBlacklisted = row >= m_types.size();
 
     if (isBlacklisted)
     {
         if (col == nameCol)
-            text = m_knownPlugins.getBlacklistedFiles()[row - m_knownPlugins.getNumTypes()];
+            text = m_blacklistedFiles[row - m_types.size()];
         else if (col == descCol)
             text = TRANS("Deactivated after failing to initialise correctly");
     }
     else
     {
-        auto desc = m_knownPlugins.getTypes()[row];
-        auto type = m_knownPlugins.getTypes()[row];
+        auto &desc = m_types.getReference(row);
 
         switch (col)
         {
@@ -73,7 +80,7 @@ void PluginListBoxModel::paintCell(juce::Graphics &g, int row, int col, int widt
             text = desc.name;
             break;
         case categoryCol:
-            text = type.isInstrument ? "Synth" : "FX";
+            text = desc.isInstrument ? "Synth" : "FX";
             break;
         case manufacturerCol:
             text = desc.manufacturerName;
@@ -90,7 +97,7 @@ void PluginListBoxModel::paintCell(juce::Graphics &g, int row, int col, int widt
 
     if (text.isNotEmpty())
     {
-        auto desc = m_knownPlugins.getTypes()[row];
+        auto desc = m_types[row];
         if (col == typeCol)
         {
             juce::Drawable *icon = nullptr;
@@ -191,7 +198,9 @@ tracktion::Plugin::Ptr PluginListbox::getSelectedPlugin(te::Edit &edit)
 PluginSettings::PluginSettings(te::Engine &engine, ApplicationViewState &appState)
     : m_engine(engine),
       m_model(engine, appState),
-      m_listbox(engine)
+      m_listbox(engine),
+      m_allowAsync(false),
+      m_numThreads(juce::jmax(1, juce::SystemStats::getNumCpus() / 2))
 {
     addAndMakeVisible(m_listbox);
     addAndMakeVisible(m_setupButton);
@@ -236,11 +245,12 @@ void PluginSettings::changeListenerCallback(juce::ChangeBroadcaster *source)
         std::vector<juce::String> newBlacklistedFiles;
         auto initiallyBlacklistedFiles = scanner->m_initiallyBlacklistedFiles;
         std::set_difference(allBlacklistedFiles.begin(), allBlacklistedFiles.end(), initiallyBlacklistedFiles.begin(), initiallyBlacklistedFiles.end(), std::back_inserter(newBlacklistedFiles));
-        scanFinished(scanner->m_dirScanner != nullptr ? scanner->m_dirScanner->getFailedFiles() : juce::StringArray(), newBlacklistedFiles);
+        scanFinished(scanner->m_dirScanner != nullptr ? scanner->m_dirScanner->getFailedFiles() : juce::StringArray(), newBlacklistedFiles, scanner->didWorkerLaunchFail());
     }
     else if (dynamic_cast<juce::KnownPluginList *>(source))
     {
         GUIHelpers::log("Liste changed");
+        m_model.refresh();
         m_listbox.updateContent();
         getParentComponent()->resized();
     }
@@ -266,6 +276,9 @@ juce::PopupMenu PluginSettings::createOptionsMenu()
                          {
                              auto &list = m_engine.getPluginManager().knownPluginList;
                              list.clear();
+
+                             // start from scratch on the next scan
+                             PluginScanCache(PluginScanCache::getDefaultFile(m_engine)).clear();
                          }));
 
     menu.addSeparator();
@@ -309,7 +322,7 @@ juce::PopupMenu PluginSettings::createOptionsMenu()
 
     return menu;
 }
-void PluginSettings::scanFinished(const juce::StringArray &failedFiles, const std::vector<juce::String> &newBlacklistedFiles)
+void PluginSettings::scanFinished(const juce::StringArray &failedFiles, const std::vector<juce::String> &newBlacklistedFiles, bool workerLaunchFailed)
 {
     juce::StringArray warnings;
 
@@ -327,7 +340,10 @@ void PluginSettings::scanFinished(const juce::StringArray &failedFiles, const st
     };
 
     addWarningText(newBlacklistedFiles, TRANS("The following files encountered fatal errors during validation"));
-    addWarningText(failedFiles, TRANS("The following files appeared to be plugin files, but failed to load correctly"));
+    if (workerLaunchFailed)
+        addWarningText(failedFiles, TRANS("The plugin scan process couldn't be started. The following files were not scanned or failed to load correctly"));
+    else
+        addWarningText(failedFiles, TRANS("The following files appeared to be plugin files, but failed to load correctly"));
 
     currentScanner.reset(); // mustn't delete this before using the failed files array
 
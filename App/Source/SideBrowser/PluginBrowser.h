@@ -49,7 +49,10 @@ public:
 
     void sortOrderChanged(int newSortColumnId, bool isForwards) override;
     static juce::String getPluginDescription(const juce::PluginDescription &desc);
-    int getNumRows() override { return m_knownPlugins.getTypes().size(); }
+    int getNumRows() override { return m_types.size(); }
+
+    // Takes a snapshot of the known plugins, call when the list changed.
+    void refresh();
 
     juce::var getDragSourceDescription(const juce::SparseSet<int> & /*rowsToDescribe*/) override;
 
@@ -57,6 +60,8 @@ private:
     juce::KnownPluginList &m_knownPlugins;
     te::Engine &m_engine;
     ApplicationViewState &m_appState;
+    juce::Array<juce::PluginDescription> m_types;
+    juce::StringArray m_blacklistedFiles;
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginListBoxModel)
 };
 //----------------------------------------------------------------------------------------
@@ -91,7 +96,7 @@ public:
     void scanFor(juce::AudioPluginFormat &, const juce::StringArray &filesOrIdentifiersToScan);
     juce::PopupMenu createOptionsMenu();
 
-    void scanFinished(const juce::StringArray &failedFiles, const std::vector<juce::String> &newBlacklistedFiles);
+    void scanFinished(const juce::StringArray &failedFiles, const std::vector<juce::String> &newBlacklistedFiles, bool workerLaunchFailed);
     void removeSelectedPlugins();
     void removePluginItem(int index);
 
@@ -142,8 +142,10 @@ public:
         m_fileInput.setInputRestrictions(256, "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_-.");
         addAndMakeVisible(m_filenameLabel);
         m_filenameLabel.setText("Enter filename: ", juce::dontSendNotification);
-        addAndMakeVisible(m_suffixLabel);
-        m_suffixLabel.setText(".wav", juce::dontSendNotification);
+        addAndMakeVisible(m_formatBox);
+        m_formatBox.addItem(".wav", 1);
+        m_formatBox.addItem(".flac", 2);
+        m_formatBox.setSelectedId(1, juce::dontSendNotification);
     }
     void resized() override
     {
@@ -163,16 +165,20 @@ public:
         auto file = te::EditFileOperations(m_evs.m_edit).getEditFile();
         m_fileInput.setText(file.getFileNameWithoutExtension());
         m_fileInput.setBounds(filenameRect.removeFromLeft((filenameRect.getWidth() / 3) * 2));
-        m_suffixLabel.setBounds(filenameRect);
+        m_formatBox.setBounds(filenameRect);
     }
 
-    juce::File getCurrentFile() const { return m_dirChooser.getCurrentFile().getNonexistentChildFile(m_fileInput.getText(), ".wav"); }
+    bool useFlac() const { return m_formatBox.getSelectedId() == 2; }
+    juce::File getCurrentFile() const { return m_dirChooser.getCurrentFile().getNonexistentChildFile(m_fileInput.getText(), useFlac() ? ".flac" : ".wav"); }
+    juce::File getCurrentFolder() const { return m_dirChooser.getCurrentFile(); }
+    juce::String getBaseName() const { return m_fileInput.getText(); }
 
 private:
     EditViewState &m_evs;
     juce::FilenameComponent m_dirChooser;
-    juce::Label m_folderLabel, m_filenameLabel, m_suffixLabel;
+    juce::Label m_folderLabel, m_filenameLabel;
     juce::TextEditor m_fileInput;
+    juce::ComboBox m_formatBox;
 };
 
 class RangeGroup
@@ -255,6 +261,7 @@ private:
 class RenderDialog
     : public juce::Component
     , private juce::Button::Listener
+    , private juce::ChangeListener
 {
 public:
     RenderDialog(EditViewState &evs)
@@ -266,11 +273,35 @@ public:
         addAndMakeVisible(m_fileGroup);
         addAndMakeVisible(m_rangeGroup);
 
+        addAndMakeVisible(m_stemsToggle);
+        m_stemsToggle.setButtonText("Export stems of selected tracks");
+        m_stemsToggle.setTooltip("Renders every selected track (or all tracks if none is selected) to its own file");
+        m_stemsToggle.onClick = [this] { m_masterToggle.setEnabled(m_stemsToggle.getToggleState()); };
+
+        addAndMakeVisible(m_masterToggle);
+        m_masterToggle.setButtonText("Include full mix");
+        m_masterToggle.setEnabled(false);
+
         addAndMakeVisible(m_startButton);
         m_startButton.setButtonText("Start Render");
         m_startButton.addListener(this);
+
+        addAndMakeVisible(m_progressBar);
+        m_progressBar.setPercentageDisplay(true);
+
+        addAndMakeVisible(m_statusLabel);
+        m_statusLabel.setJustificationType(juce::Justification::centred);
+
+        addAndMakeVisible(m_cancelButton);
+        m_cancelButton.setButtonText("Cancel");
+        m_cancelButton.addListener(this);
+
+        m_evs.m_renderJobQueue->addChangeListener(this);
+        updateProgress();
     }
 
+    ~RenderDialog() override { m_evs.m_renderJobQueue->removeChangeListener(this); }
+
     void paint(juce::Graphics &g) override { g.fillAll(m_evs.m_applicationState.getBackgroundColour1()); }
 
     void resized() override
@@ -280,16 +311,27 @@ public:
             bounds = bounds.withWidth(190);
         if (bounds.getWidth() > 350)
             bounds = bounds.withWidth(350);
-        if (bounds.getHeight() < 435)
-            bounds = bounds.withHeight(435);
+        if (bounds.getHeight() < 590)
+            bounds = bounds.withHeight(590);
 
         bounds.reduce(10, 10);
         m_fileGroup.setBounds(bounds.removeFromTop(120));
         bounds.removeFromTop(15);
         m_rangeGroup.setBounds(bounds.removeFromTop(240));
 
+        bounds.removeFromTop(10);
+        m_stemsToggle.setBounds(bounds.removeFromTop(25));
+        m_masterToggle.setBounds(bounds.removeFromTop(25).withTrimmedLeft(20));
+
         bounds.removeFromTop(15);
         m_startButton.setBounds(bounds.removeFromTop(25).reduced(bounds.getWidth() / 4, 0));
+
+        bounds.removeFromTop(15);
+        m_progressBar.setBounds(bounds.removeFromTop(20));
+        bounds.removeFromTop(5);
+        m_statusLabel.setBounds(bounds.removeFromTop(20));
+        bounds.removeFromTop(5);
+        m_cancelButton.setBounds(bounds.removeFromTop(25).reduced(bounds.getWidth() / 4, 0));
     }
 
     tracktion::TimeRange getTimeRange() const { return {m_rangeGroup.m_rangeStart.getCurrentTimePosition(), m_rangeGroup.m_rangeEnd.getCurrentTimePosition()}; }
@@ -299,6 +341,12 @@ public:
 private:
     void buttonClicked(juce::Button *button) override
     {
+        if (button == &m_startButton && m_stemsToggle.getToggleState())
+        {
+            renderStems();
+            return;
+        }
+
         if (button == &m_startButton)
         {
             GUIHelpers::log(getRenderFile().getFullPathName());
@@ -315,10 +363,71 @@ private:
             GUIHelpers::log("this is a new created file");
             EngineHelpers::renderEditToFile(m_evs, getRenderFile(), getTimeRange());
         }
+
+        if (button == &m_cancelButton)
+        {
+            m_evs.m_renderJobQueue->cancelAllJobs();
+        }
+    }
+
+    void renderStems()
+    {
+        auto stemTracks = EngineHelpers::getTracksForStemExport(m_evs.m_edit, m_evs.m_selectionManager.getItemsOfType<te::Track>());
+
+        auto folder = m_fileGroup.getCurrentFolder().getChildFile(juce::File::createLegalFileName(m_fileGroup.getBaseName()) + "_stems");
+        EngineHelpers::renderStemsToFolder(m_evs, folder, m_fileGroup.getBaseName(), stemTracks, getTimeRange(), m_fileGroup.useFlac(), m_masterToggle.getToggleState());
+    }
+
+    void changeListenerCallback(juce::ChangeBroadcaster *) override { updateProgress(); }
+
+    void updateProgress()
+    {
+        auto &queue = *m_evs.m_renderJobQueue;
+        auto jobs = queue.getJobInfos();
+
+        auto running = std::find_if(jobs.begin(), jobs.end(), [](const RenderJobQueue::JobInfo &info) { return info.isRunning; });
+        auto numRunning = (int)std::count_if(jobs.begin(), jobs.end(), [](const RenderJobQueue::JobInfo &info) { return info.isRunning; });
+        m_cancelButton.setEnabled(!jobs.empty());
+
+        if (running == jobs.end())
+        {
+            const auto &last = queue.getLastResult();
+            m_progress = last.succeeded ? 1.0 : 0.0;
+
+            if (last.jobID == 0)
+                m_statusLabel.setText({}, juce::dontSendNotification);
+            else if (last.wasCancelled)
+                m_statusLabel.setText("Render cancelled", juce::dontSendNotification);
+            else if (!last.succeeded)
+                m_statusLabel.setText("Render failed: " + last.errorMessage, juce::dontSendNotification);
+            else
+                m_statusLabel.setText("Done in " + PlayHeadHelpers::timeToTimecodeString(last.secondsTaken), juce::dontSendNotification);
+
+            return;
+        }
+
+        m_progress = running->progress;
+
+        juce::String status = PlayHeadHelpers::timeToTimecodeString(running->elapsedSeconds);
+
+        if (running->remainingSeconds >= 0.0)
+            status << " / ETA " << PlayHeadHelpers::timeToTimecodeString(running->remainingSeconds) << " / " << juce::String(running->realtimeFactor, 1) << "x";
+
+        if (numRunning > 1)
+            status << " (" << juce::String(numRunning) << " running)";
+
+        if ((int)jobs.size() > numRunning)
+            status << " (" << juce::String((int)jobs.size() - numRunning) << " queued)";
+
+        m_statusLabel.setText(status, juce::dontSendNotification);
     }
 
     EditViewState &m_evs;
     FileGroup m_fileGroup;
     RangeGroup m_rangeGroup;
-    juce::TextButton m_startButton;
+    juce::ToggleButton m_stemsToggle, m_masterToggle;
+    juce::TextButton m_startButton, m_cancelButton;
+    double m_progress{0.0};
+    juce::ProgressBar m_progressBar{m_progress};
+    juce::Label m_statusLabel;
 };
@@ -32,8 +32,55 @@ SampleBrowserComponent::SampleBrowserComponent(ApplicationViewState &avs, Sample
     m_sortingBox.addItem(GUIHelpers::translate("by Name (a - z)", m_applicationViewState), 1);
     m_sortingBox.addItem(GUIHelpers::translate("by Name (z - a)", m_applicationViewState), 2);
     m_sortingBox.addItem(GUIHelpers::translate("Random", m_applicationViewState), 3);
+    m_sortingBox.addItem(GUIHelpers::translate("by Length", m_applicationViewState), 4);
+    m_sortingBox.addItem(GUIHelpers::translate("by Tempo", m_applicationViewState), 5);
     m_sortingBox.setSelectedId(1, juce::dontSendNotification);
+
+    AudioLibraryIndex::getInstance()->addChangeListener(this);
+}
+
+SampleBrowserComponent::~SampleBrowserComponent() { AudioLibraryIndex::getInstance()->removeChangeListener(this); }
+
+void SampleBrowserComponent::setRoot(const juce::File &root)
+{
+    m_root = root;
+    refreshFromIndex(true);
+}
+
+void SampleBrowserComponent::refreshFromIndex(bool force)
+{
+    // the index reports changes anywhere, only rebuild if they were below our root
+    auto index = AudioLibraryIndex::getInstance();
+    auto generation = index->getGeneration(m_root);
+
+    if (!force && generation == m_indexGeneration)
+        return;
+
+    m_indexGeneration = generation;
+    auto files = index->getFiles(m_root);
+
+    // keep the selection without starting the preview again
+    auto selectedFile = m_listBox.getSelectedRow() >= 0 ? m_contentList[m_listBox.getSelectedRow()] : juce::File();
+
+    const juce::ScopedValueSetter<bool> restoring(m_restoringSelection, true);
+    setFileList(files);
+
+    if (auto row = m_contentList.indexOf(selectedFile); row >= 0)
+        m_listBox.selectRow(row);
+}
+
+void SampleBrowserComponent::changeListenerCallback(juce::ChangeBroadcaster *source)
+{
+    if (source == AudioLibraryIndex::getInstance())
+    {
+        refreshFromIndex(false);
+        return;
+    }
+
+    BrowserBaseComponent::changeListenerCallback(source);
 }
+
+bool SampleBrowserComponent::matchesSearchTerm(const juce::File &file) const { return AudioLibraryIndex::getInstance()->matches(file, m_searchTerm); }
 void SampleBrowserComponent::resized()
 {
     auto area = getLocalBounds();
@@ -72,6 +119,23 @@ void SampleBrowserComponent::paintListBoxItem(int rowNum, juce::Graphics &g, int
 
     auto textArea = bounds.reduced(10, 0);
 
+    AudioLibraryIndex::Entry entry;
+    if (AudioLibraryIndex::getInstance()->getEntry(m_contentList[rowNum], entry) && entry.lengthInSeconds > 0.0)
+    {
+        juce::String info;
+        if (entry.bpm > 0.0)
+            info << juce::roundToInt(entry.bpm) << " BPM  ";
+        if (entry.key.isNotEmpty())
+            info << entry.key << "  ";
+        info << juce::String(entry.lengthInSeconds, 1) << " s";
+
+        auto infoArea = textArea.removeFromRight(juce::jmin(110, textArea.getWidth() / 3));
+        juce::Graphics::ScopedSaveState state(g);
+        g.setColour((rowIsSelected ? m_applicationViewState.getPrimeColour().contrasting(.7f) : textColour).withAlpha(0.6f));
+        g.setFont((float)height * 0.6f);
+        g.drawFittedText(info, infoArea, juce::Justification::centredRight, 1, 0.9f);
+    }
+
     if (m_searchTerm.isEmpty())
     {
         g.setColour(rowIsSelected ? m_applicationViewState.getPrimeColour().contrasting(.7f) : textColour);
@@ -130,7 +194,17 @@ void SampleBrowserComponent::listBoxItemClicked(int row, const juce::MouseEvent
     }
 }
 
-void SampleBrowserComponent::selectedRowsChanged(int) { previewSampleFile(m_contentList[m_listBox.getSelectedRow()]); }
+void SampleBrowserComponent::selectedRowsChanged(int)
+{
+    if (m_restoringSelection)
+        return;
+
+    auto row = m_listBox.getSelectedRow();
+    previewSampleFile(m_contentList[row]);
+
+    // the neighbours are most likely auditioned next
+    AudioLibraryIndex::getInstance()->prefetchHeads({m_contentList[row + 1], m_contentList[row - 1]});
+}
 
 void SampleBrowserComponent::previewSampleFile(const juce::File &file)
 {
@@ -144,40 +218,26 @@ void SampleBrowserComponent::previewSampleFile(const juce::File &file)
 void SampleBrowserComponent::sortList(int selectedID)
 {
     GUIHelpers::log("SELECTED ID: ", selectedID);
-    juce::Array<juce::File> fileList;
+    juce::Array<juce::File> fileList(m_contentList);
 
-    for (auto f : m_contentList)
-        if (!f.isDirectory())
-            fileList.add(f);
+    auto *index = AudioLibraryIndex::getInstance();
 
     if (selectedID == 1)
-        sortByName(fileList, true);
+        index->sortFiles(fileList, AudioLibraryIndex::SortOrder::name, true);
     else if (selectedID == 2)
-        sortByName(fileList, false);
+        index->sortFiles(fileList, AudioLibraryIndex::SortOrder::name, false);
     else if (selectedID == 3)
         shuffleFileArray(fileList);
+    else if (selectedID == 4)
+        index->sortFiles(fileList, AudioLibraryIndex::SortOrder::length, true);
+    else if (selectedID == 5)
+        index->sortFiles(fileList, AudioLibraryIndex::SortOrder::bpm, true);
 
     m_contentList.clear();
     m_contentList.addArray(fileList);
 
     getParentComponent()->resized();
 }
-void SampleBrowserComponent::sortByName(juce::Array<juce::File> &list, bool forward)
-{
-    if (list.size() > 1)
-    {
-        if (forward)
-        {
-            CompareNameForward cf;
-            list.sort(cf);
-        }
-        else
-        {
-            CompareNameBackwards cb;
-            list.sort(cb);
-        }
-    }
-}
 void SampleBrowserComponent::shuffleFileArray(juce::Array<juce::File> &fileList)
 {
     juce::Random r;
@@ -24,6 +24,7 @@
 #include "SideBrowser/SearchFieldComponent.h"
 #include "UI/PreviewComponent.h"
 #include "Utilities/ApplicationViewState.h"
+#include "Utilities/AudioLibraryIndex.h"
 #include "Utilities/EditViewState.h"
 #include "Utilities/Utilities.h"
 
@@ -32,6 +33,7 @@ class SampleBrowserComponent : public BrowserBaseComponent
 {
 public:
     SampleBrowserComponent(ApplicationViewState &avs, SamplePreviewComponent &spc);
+    ~SampleBrowserComponent() override;
     void resized() override;
     void paintListBoxItem(int rowNum, juce::Graphics &g, int width, int height, bool rowIsSelected) override;
 
@@ -39,24 +41,23 @@ public:
 
     void listBoxItemClicked(int row, const juce::MouseEvent &e) override;
     void selectedRowsChanged(int /*lastRowSelected*/) override;
+    void changeListenerCallback(juce::ChangeBroadcaster *source) override;
 
     void previewSampleFile(const juce::File &file);
 
+    // Shows the indexed files below root, the list follows the index.
+    void setRoot(const juce::File &root);
+
 private:
     void sortList(int selectedID) override;
+    bool matchesSearchTerm(const juce::File &file) const override;
+    void refreshFromIndex(bool force);
 
-    struct CompareNameForward
-    {
-        static int compareElements(const juce::File &first, const juce::File &second) { return first.getFileName().compareNatural(second.getFileName()); }
-    };
-
-    struct CompareNameBackwards
-    {
-        static int compareElements(const juce::File &first, const juce::File &second) { return second.getFileName().compareNatural(first.getFileName()); }
-    };
-    void sortByName(juce::Array<juce::File> &list, bool forward);
     void shuffleFileArray(juce::Array<juce::File> &fileList);
     SamplePreviewComponent &m_samplePreviewComponent;
+    juce::File m_root;
+    juce::uint64 m_indexGeneration = 0;
+    bool m_restoringSelection = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SampleBrowserComponent)
 };
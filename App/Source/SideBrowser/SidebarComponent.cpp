@@ -23,6 +23,7 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 #include "BinaryData.h"
 #include "MainComponent.h"
 #include "SideBrowser/RenderDialog.h"
+#include "Utilities/AudioLibraryIndex.h"
 #include "Utilities/EditViewState.h"
 #include "Utilities/Utilities.h"
 
@@ -283,7 +284,9 @@ void SidebarComponent::refreshBrowsersFromAppState()
     const auto projectsRoot = juce::File(m_appState.m_projectsDir.get());
     const auto workRoot = juce::File(m_appState.m_workDir.get());
 
-    m_sampleBrowser.setFileList(samplesRoot.findChildFiles(juce::File::TypesOfFileToFind::findFiles, true, "*.wav;*.WAV;*.mp3;*.MP3;*.aiff;*.AIFF;*.flac;*.FLAC"));
+    // the sample library is crawled in the background, see AudioLibraryIndex
+    AudioLibraryIndex::getInstance()->setRoots({samplesRoot});
+    m_sampleBrowser.setRoot(samplesRoot);
     m_projectsBrowser.setFileList(projectsRoot.findChildFiles(juce::File::TypesOfFileToFind::findFiles, true, "*.tracktionedit"));
     m_fileListBrowser.setDirecory(workRoot);
 }
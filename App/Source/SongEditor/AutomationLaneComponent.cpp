@@ -63,17 +63,57 @@ void AutomationLaneComponent::handleAsyncUpdate()
     repaint();
 }
 
-void AutomationLaneComponent::valueTreePropertyChanged(juce::ValueTree &, const juce::Identifier &) { triggerAsyncUpdate(); }
+// The curve layer is dropped right away, a drag repaints before the async update arrives.
+void AutomationLaneComponent::valueTreePropertyChanged(juce::ValueTree &, const juce::Identifier &)
+{
+    m_curveLayer.isValid = false;
+    triggerAsyncUpdate();
+}
 
-void AutomationLaneComponent::valueTreeChildAdded(juce::ValueTree &, juce::ValueTree &) { triggerAsyncUpdate(); }
+void AutomationLaneComponent::valueTreeChildAdded(juce::ValueTree &, juce::ValueTree &)
+{
+    m_curveLayer.isValid = false;
+    triggerAsyncUpdate();
+}
 
-void AutomationLaneComponent::valueTreeChildRemoved(juce::ValueTree &, juce::ValueTree &, int) { triggerAsyncUpdate(); }
+void AutomationLaneComponent::valueTreeChildRemoved(juce::ValueTree &, juce::ValueTree &, int)
+{
+    m_curveLayer.isValid = false;
+    triggerAsyncUpdate();
+}
 
-void AutomationLaneComponent::valueTreeChildOrderChanged(juce::ValueTree &, int, int) { triggerAsyncUpdate(); }
+void AutomationLaneComponent::valueTreeChildOrderChanged(juce::ValueTree &, int, int)
+{
+    m_curveLayer.isValid = false;
+    triggerAsyncUpdate();
+}
 
 void AutomationLaneComponent::paint(juce::Graphics &g)
 {
-    drawAutomationLane(g, m_editViewState.getVisibleTimeRange(m_timeLineID, getWidth()), getLocalBounds().toFloat());
+    auto drawRange = m_editViewState.getVisibleTimeRange(m_timeLineID, getWidth());
+    auto drawRect = getLocalBounds().toFloat();
+    const auto startBeat = m_editViewState.timeToBeat(drawRange.getStart().inSeconds());
+    const auto endBeat = m_editViewState.timeToBeat(drawRange.getEnd().inSeconds());
+
+    // the layer's own range is checked too, a tempo change moves the points without changing the zoom
+    const bool tempoChanged = m_curveLayer.startBeat != m_editViewState.timeToBeat(m_curveLayer.range.getStart().inSeconds()) || m_curveLayer.endBeat != m_editViewState.timeToBeat(m_curveLayer.range.getEnd().inSeconds());
+
+    if (endBeat <= startBeat)
+    {
+        buildCurveLayer(m_curveLayer, drawRange, drawRect);
+    }
+    else if (!m_curveLayer.covers(startBeat, endBeat, drawRect) || tempoChanged)
+    {
+        const auto visibleBeats = endBeat - startBeat;
+        const auto layerStartBeat = juce::jmax(startBeat - visibleBeats, juce::jmin(startBeat, 0.0));
+        const auto layerEndBeat = endBeat + visibleBeats;
+        const auto layerRange = tracktion::TimeRange(tracktion::TimePosition::fromSeconds(m_editViewState.beatToTime(layerStartBeat)), tracktion::TimePosition::fromSeconds(m_editViewState.beatToTime(layerEndBeat)));
+        const auto layerWidth = static_cast<float>((layerEndBeat - layerStartBeat) * drawRect.getWidth() / visibleBeats);
+
+        buildCurveLayer(m_curveLayer, layerRange, drawRect.withX(0.0f).withWidth(layerWidth));
+    }
+
+    drawCurveLayer(g, m_curveLayer, drawRect, startBeat, endBeat);
 
     m_needsRepaint = false;
 }
@@ -122,10 +162,14 @@ void AutomationLaneComponent::mouseMove(const juce::MouseEvent &e)
 
     if (m_hoveredPoint != hoveredPoint || m_hoveredCurve != hoveredCurve || m_hoveredRect != hoveredRectOnLane)
     {
+        // only the hover overlays change, the curve layer is reused
+        auto dirty = getHoverOverlayBounds();
+
         m_hoveredPoint = hoveredPoint;
         m_hoveredCurve = hoveredCurve;
         m_hoveredRect = hoveredRectOnLane.reduced(2.f, 2.f);
-        repaint();
+
+        repaint(dirty.getUnion(getHoverOverlayBounds()));
     }
 }
 
@@ -332,33 +376,6 @@ void AutomationLaneComponent::mouseUp(const juce::MouseEvent &e)
     repaint();
 }
 
-void AutomationLaneComponent::selectPointsInLasso(juce::Rectangle<int> lassoRect, bool addToSelection)
-{
-    auto visibleRange = m_editViewState.getVisibleBeatRange(m_timeLineID, getWidth());
-    auto x1 = visibleRange.getStart().inBeats();
-    auto x2 = visibleRange.getEnd().inBeats();
-
-    // Get parent relative position (TrackLane -> SongEditorView)
-    auto parent = getParentComponent();
-    if (!parent)
-        return;
-
-    auto lanePosInSEV = getBoundsInParent().translated(parent->getX(), parent->getY());
-
-    for (int i = 0; i < m_parameter->getCurve().getNumPoints(); ++i)
-    {
-        auto point = m_parameter->getCurve().getPoint(i);
-        auto pointPosLocal = getPointOnAutomationRect(point.time, point.value, getWidth(), x1, x2);
-
-        auto pointPosInSEV = pointPosLocal.translated(lanePosInSEV.getX(), lanePosInSEV.getY());
-
-        if (lassoRect.contains(pointPosInSEV.toInt()))
-        {
-            selectAutomationPoint(i, true);
-        }
-    }
-}
-
 //==============================================================================
 // Helpers Implementation
 //==============================================================================
@@ -416,174 +433,240 @@ juce::OwnedArray<AutomationLaneComponent::CurvePoint> AutomationLaneComponent::g
     return points;
 }
 
-// ... Keep existing drawing/caching methods ...
-
 void AutomationLaneComponent::drawAutomationLane(juce::Graphics &g, tracktion::TimeRange drawRange, juce::Rectangle<float> drawRect)
 {
-    if (drawRect.getWidth() <= 0 || drawRect.getHeight() <= 0)
-        return;
-
-    auto automationColour = m_editViewState.m_applicationState.getPrimeColour();
-    if (auto *track = m_parameter->getTrack())
-        automationColour = track->getColour();
-    else if (auto *masterTrack = m_parameter->getEdit().getMasterTrack())
-        automationColour = masterTrack->getColour();
+    // used for the dragged copy of a time range, not worth caching
+    CurveLayer layer;
+    buildCurveLayer(layer, drawRange, drawRect);
+    drawCurveLayer(g, layer, drawRect, layer.startBeat, layer.endBeat);
+}
 
-    // Early exit for very small lanes
-    if (getHeight() < 5)
-        return;
+bool AutomationLaneComponent::CurveLayer::covers(double visibleStartBeat, double visibleEndBeat, juce::Rectangle<float> bounds) const
+{
+    if (!isValid || rect.getY() != bounds.getY() || rect.getHeight() != bounds.getHeight() || visibleEndBeat <= visibleStartBeat)
+        return false;
 
-    g.saveState();
-    g.reduceClipRegion(drawRect.toNearestIntEdges());
+    // same zoom level, the path only has to be moved
+    const auto visiblePixelsPerBeat = bounds.getWidth() / (visibleEndBeat - visibleStartBeat);
+    if (std::abs(visiblePixelsPerBeat - pixelsPerBeat) > pixelsPerBeat * 1.0e-9)
+        return false;
 
-    double startBeat = m_editViewState.timeToBeat(drawRange.getStart().inSeconds());
-    double endBeat = m_editViewState.timeToBeat(drawRange.getEnd().inSeconds());
+    return visibleStartBeat >= startBeat && visibleEndBeat <= endBeat;
+}
 
-    // Only draw background when visible
-    if (drawRect.getHeight() > 2)
-    {
-        g.setColour(m_editViewState.m_applicationState.getTrackBackgroundColour());
-        g.fillRect(drawRect);
-        GUIHelpers::drawBarsAndBeatLines(g, m_editViewState, startBeat, endBeat, drawRect);
-    }
+// Builds the paths of the curve and its points for one zoom level. Where more
+// than one point falls into a pixel column the column is drawn as a vertical
+// line from its min to its max value and only gets one point marker, so a
+// lane with tens of thousands of recorded points costs about one segment per
+// pixel.
+void AutomationLaneComponent::buildCurveLayer(CurveLayer &layer, tracktion::TimeRange drawRange, juce::Rectangle<float> drawRect)
+{
+    layer = {};
+    layer.range = drawRange;
+    layer.rect = drawRect;
+    layer.isValid = true;
+    layer.startBeat = m_editViewState.timeToBeat(drawRange.getStart().inSeconds());
+    layer.endBeat = m_editViewState.timeToBeat(drawRange.getEnd().inSeconds());
+    layer.pixelsPerBeat = layer.endBeat > layer.startBeat ? drawRect.getWidth() / (layer.endBeat - layer.startBeat) : 0.0;
 
     const auto &curve = m_parameter->getCurve();
     const int numPoints = curve.getNumPoints();
 
-    // Early exit when no points exist
-    if (numPoints == 0)
-    {
-        g.restoreState();
+    if (drawRect.getWidth() <= 0 || drawRect.getHeight() <= 0 || numPoints == 0)
         return;
-    }
-
-    // Create rectangles and paths only once
-    juce::Path curvePath;
-    juce::Path pointsPath;
-    juce::Path selectedPointsPath;
-    juce::Path hoveredPointPath;
-    juce::Path hoveredCurvePath;
-    juce::Path hoveredDotOnCurvePath;
 
     const float startX = drawRect.getX();
     const float endX = drawRect.getRight();
     const float pointWidth = getAutomationPointWidth();
     const float halfPointWidth = pointWidth * 0.5f;
 
-    // Cache for visible points
-    juce::Array<int> visiblePointIndices;
-    visiblePointIndices.ensureStorageAllocated(juce::jmin(numPoints, 100));
-
-    auto pointBeforeDrawRange = curve.indexBefore(drawRange.getStart());
-    auto pointAfterDrawRange = nextIndexAfter(drawRange.getEnd(), m_parameter);
-
-    if (pointBeforeDrawRange == -1)
-        pointBeforeDrawRange = 0;
-    if (pointAfterDrawRange == -1)
-        pointAfterDrawRange = numPoints - 1;
+    auto getX = [&](tracktion::TimePosition t) { return startX + static_cast<float>(m_editViewState.timeToX(t.inSeconds(), drawRect.getWidth(), layer.startBeat, layer.endBeat)); };
 
-    // Only process visible points
-    const int startIdx = juce::jmax(0, pointBeforeDrawRange - 1);
-    const int endIdx = juce::jmin(numPoints - 1, pointAfterDrawRange + 1);
+    auto addMarker = [&](float x, float y) { layer.points.addEllipse(x - halfPointWidth, y - halfPointWidth, pointWidth, pointWidth); };
 
     if (numPoints == 1)
     {
-        // Single point
         const auto &point = curve.getPoint(0);
-        const float x = static_cast<float>(m_editViewState.timeToX(point.time.inSeconds(), drawRect.getWidth(), startBeat, endBeat));
         const float y = static_cast<float>(getYPos(point.value));
 
-        curvePath.startNewSubPath(startX, y);
-        curvePath.lineTo(endX, y);
-
-        const juce::Rectangle<float> ellipseRect(x - halfPointWidth, y - halfPointWidth, pointWidth, pointWidth);
-        pointsPath.addEllipse(ellipseRect);
-
-        if (m_hoveredPoint == 0)
-            hoveredPointPath.addEllipse(ellipseRect);
-        if (isAutomationPointSelected(0))
-            selectedPointsPath.addEllipse(ellipseRect);
+        layer.curve.startNewSubPath(startX, y);
+        layer.curve.lineTo(endX, y);
+        addMarker(getX(point.time), y);
+        layer.startIndex = layer.endIndex = 0;
     }
     else
     {
-        // Draw curve
-        const auto &firstPoint = curve.getPoint(startIdx);
-        float lastX = static_cast<float>(m_editViewState.timeToX(firstPoint.time.inSeconds(), drawRect.getWidth(), startBeat, endBeat));
+        auto pointBeforeDrawRange = firstIndexAtOrAfter(curve, drawRange.getStart()) - 1;
+        auto pointAfterDrawRange = nextIndexAfter(drawRange.getEnd(), m_parameter);
+
+        if (pointBeforeDrawRange == -1)
+            pointBeforeDrawRange = 0;
+        if (pointAfterDrawRange == -1)
+            pointAfterDrawRange = numPoints - 1;
+
+        layer.startIndex = juce::jmax(0, pointBeforeDrawRange - 1);
+        layer.endIndex = juce::jmin(numPoints - 1, pointAfterDrawRange + 1);
+
+        const auto &firstPoint = curve.getPoint(layer.startIndex);
+        float lastX = getX(firstPoint.time);
         float lastY = static_cast<float>(getYPos(firstPoint.value));
 
-        if (startIdx == 0 || firstPoint.time >= drawRange.getStart())
-            curvePath.startNewSubPath(lastX, lastY);
+        if (layer.startIndex == 0 || firstPoint.time >= drawRange.getStart())
+            layer.curve.startNewSubPath(lastX, lastY);
         else
-            curvePath.startNewSubPath(startX, static_cast<float>(getYPos(curve.getValueAt(drawRange.getStart()))));
+            layer.curve.startNewSubPath(startX, static_cast<float>(getYPos(curve.getValueAt(drawRange.getStart()))));
+
+        int column = juce::roundToInt(std::floor(lastX));
+        int lastMarkerColumn = std::numeric_limits<int>::min();
+        float columnMin = lastY, columnMax = lastY;
+        bool columnIsDense = false;
 
-        // Collect points
-        for (int i = startIdx + 1; i <= endIdx; ++i)
+        auto flushColumn = [&]
         {
-            const auto &point = curve.getPoint(i);
-            const float x = static_cast<float>(m_editViewState.timeToX(point.time.inSeconds(), drawRect.getWidth(), startBeat, endBeat));
-            const float y = static_cast<float>(getYPos(point.value));
+            if (!columnIsDense)
+                return;
 
-            if (i > 0)
-            {
-                const auto &prevPoint = curve.getPoint(i - 1);
-                const float curveValue = juce::jlimit(-0.5f, 0.5f, prevPoint.curve);
+            layer.curve.lineTo(static_cast<float>(column), columnMin);
+            layer.curve.lineTo(static_cast<float>(column), columnMax);
+            layer.curve.lineTo(lastX, lastY);
+            columnIsDense = false;
+        };
 
-                const float cpX = lastX + (x - lastX) * (0.5f + curveValue);
-                const float cpY = lastY + (y - lastY) * (0.5f - curveValue);
+        auto addMarkerIfVisible = [&](float x, float y)
+        {
+            if (x < startX - pointWidth || x > endX + pointWidth || column == lastMarkerColumn)
+                return;
 
-                if (m_hoveredCurve == i)
-                {
-                    hoveredCurvePath.startNewSubPath(lastX, lastY);
-                    hoveredCurvePath.quadraticTo(cpX, cpY, x, y);
-                }
+            addMarker(x, y);
+            lastMarkerColumn = column;
+        };
 
-                curvePath.quadraticTo(cpX, cpY, x, y);
-            }
-            else
+        addMarkerIfVisible(lastX, lastY);
+
+        for (int i = layer.startIndex + 1; i <= layer.endIndex; ++i)
+        {
+            const auto &point = curve.getPoint(i);
+            const float x = getX(point.time);
+            const float y = static_cast<float>(getYPos(point.value));
+            const int pointColumn = juce::roundToInt(std::floor(x));
+
+            if (pointColumn == column)
             {
-                curvePath.lineTo(x, y);
+                columnMin = juce::jmin(columnMin, y);
+                columnMax = juce::jmax(columnMax, y);
+                columnIsDense = true;
+                lastX = x;
+                lastY = y;
+                continue;
             }
 
+            flushColumn();
+
+            const float curveValue = juce::jlimit(-0.5f, 0.5f, curve.getPoint(i - 1).curve);
+            const float cpX = lastX + (x - lastX) * (0.5f + curveValue);
+            const float cpY = lastY + (y - lastY) * (0.5f - curveValue);
+            layer.curve.quadraticTo(cpX, cpY, x, y);
+
+            column = pointColumn;
+            columnMin = columnMax = y;
             lastX = x;
             lastY = y;
 
-            // Only draw point if visible
-            if (x >= startX - pointWidth && x <= endX + pointWidth)
-            {
-                const juce::Rectangle<float> ellipseRect(x - halfPointWidth, y - halfPointWidth, pointWidth, pointWidth);
-                pointsPath.addEllipse(ellipseRect);
-
-                if (m_hoveredPoint == i)
-                    hoveredPointPath.addEllipse(ellipseRect);
-                if (isAutomationPointSelected(i))
-                    selectedPointsPath.addEllipse(ellipseRect);
-            }
+            addMarkerIfVisible(x, y);
         }
 
+        flushColumn();
+
         // Extend to the end
-        if (endIdx >= 0 && curve.getPoint(endIdx).time < drawRange.getEnd())
-            curvePath.lineTo(endX, static_cast<float>(getYPos(curve.getValueAt(drawRange.getEnd()))));
+        if (curve.getPoint(layer.endIndex).time < drawRange.getEnd())
+            layer.curve.lineTo(endX, static_cast<float>(getYPos(curve.getValueAt(drawRange.getEnd()))));
     }
 
     // Fill only for larger lanes
     if (getHeight() > 30)
     {
-        juce::Path fillPath = curvePath;
-        fillPath.lineTo(drawRect.getBottomRight());
-        fillPath.lineTo(drawRect.getBottomLeft());
-        fillPath.closeSubPath();
+        layer.fill = layer.curve;
+        layer.fill.lineTo(drawRect.getBottomRight());
+        layer.fill.lineTo(drawRect.getBottomLeft());
+        layer.fill.closeSubPath();
+    }
+}
+
+void AutomationLaneComponent::drawCurveLayer(juce::Graphics &g, const CurveLayer &layer, juce::Rectangle<float> drawRect, double startBeat, double endBeat)
+{
+    if (drawRect.getWidth() <= 0 || drawRect.getHeight() <= 0)
+        return;
+
+    // where the layer's start lands in drawRect
+    const auto layerTransform = juce::AffineTransform::translation(drawRect.getX() - layer.rect.getX() + static_cast<float>((layer.startBeat - startBeat) * layer.pixelsPerBeat), 0.0f);
+
+    auto automationColour = m_editViewState.m_applicationState.getPrimeColour();
+    if (auto *track = m_parameter->getTrack())
+        automationColour = track->getColour();
+    else if (auto *masterTrack = m_parameter->getEdit().getMasterTrack())
+        automationColour = masterTrack->getColour();
+
+    // Early exit for very small lanes
+    if (getHeight() < 5)
+        return;
 
+    g.saveState();
+    g.reduceClipRegion(drawRect.toNearestIntEdges());
+
+    // Only draw background when visible
+    if (drawRect.getHeight() > 2)
+    {
+        g.setColour(m_editViewState.m_applicationState.getTrackBackgroundColour());
+        g.fillRect(drawRect);
+        GUIHelpers::drawBarsAndBeatLines(g, m_editViewState, startBeat, endBeat, drawRect);
+    }
+
+    const auto &curve = m_parameter->getCurve();
+    const int numPoints = curve.getNumPoints();
+
+    if (numPoints == 0 || layer.startIndex < 0)
+    {
+        g.restoreState();
+        return;
+    }
+
+    if (!layer.fill.isEmpty())
+    {
         g.setColour(automationColour.withAlpha(0.2f));
-        g.fillPath(fillPath);
+        g.fillPath(layer.fill, layerTransform);
     }
 
-    // Draw curve
     g.setColour(m_editViewState.m_applicationState.getTimeLineStrokeColour());
-    g.strokePath(curvePath, juce::PathStrokeType(2.0f));
+    g.strokePath(layer.curve, juce::PathStrokeType(2.0f), layerTransform);
 
-    // Hover curve and dot
-    if (!hoveredCurvePath.isEmpty())
+    const float pointWidth = getAutomationPointWidth();
+    const float halfPointWidth = pointWidth * 0.5f;
+
+    auto getPointPosition = [&](int index)
+    {
+        const auto &point = curve.getPoint(index);
+        return getPointOnAutomationRect(point.time, point.value, static_cast<int>(drawRect.getWidth()), startBeat, endBeat).translated(drawRect.getX(), 0.0f);
+    };
+
+    auto getPointRect = [&](int index)
     {
+        auto pos = getPointPosition(index);
+        return juce::Rectangle<float>(pos.x - halfPointWidth, pos.y - halfPointWidth, pointWidth, pointWidth);
+    };
+
+    auto isInLayer = [&](int index) { return index >= layer.startIndex && index <= layer.endIndex && index < numPoints; };
+
+    // Hovered curve segment
+    if (m_hoveredCurve > 0 && isInLayer(m_hoveredCurve))
+    {
+        auto p1 = getPointPosition(m_hoveredCurve - 1);
+        auto p2 = getPointPosition(m_hoveredCurve);
+        auto cp = getCurveControlPoint(p1, p2, juce::jlimit(-0.5f, 0.5f, curve.getPoint(m_hoveredCurve - 1).curve));
+
+        juce::Path hoveredCurvePath;
+        hoveredCurvePath.startNewSubPath(p1);
+        hoveredCurvePath.quadraticTo(cp, p2);
+
         g.setColour(m_editViewState.m_applicationState.getPrimeColour());
         if (m_isDragging)
             g.setColour(m_editViewState.m_applicationState.getPrimeColour().withLightness(1.0f));
@@ -613,20 +696,26 @@ void AutomationLaneComponent::drawAutomationLane(juce::Graphics &g, tracktion::T
     // Draw points
     const float lineThickness = 2.0f;
 
-    if (!pointsPath.isEmpty())
+    if (!layer.points.isEmpty())
     {
         g.setColour(m_editViewState.m_applicationState.getTrackBackgroundColour());
-        g.fillPath(pointsPath);
+        g.fillPath(layer.points, layerTransform);
         g.setColour(m_editViewState.m_applicationState.getTimeLineStrokeColour());
-        g.strokePath(pointsPath, juce::PathStrokeType(lineThickness));
+        g.strokePath(layer.points, juce::PathStrokeType(lineThickness), layerTransform);
     }
 
-    if (!hoveredPointPath.isEmpty())
+    if (isInLayer(m_hoveredPoint))
     {
         g.setColour(m_editViewState.m_applicationState.getTimeLineStrokeColour().withLightness(1.0f));
-        g.strokePath(hoveredPointPath, juce::PathStrokeType(lineThickness));
+        g.drawEllipse(getPointRect(m_hoveredPoint), lineThickness);
     }
 
+    juce::Path selectedPointsPath;
+
+    for (auto index : getSelectedPointIndices())
+        if (isInLayer(index))
+            selectedPointsPath.addEllipse(getPointRect(index));
+
     if (!selectedPointsPath.isEmpty())
     {
         g.setColour(m_editViewState.m_applicationState.getPrimeColour());
@@ -636,17 +725,70 @@ void AutomationLaneComponent::drawAutomationLane(juce::Graphics &g, tracktion::T
     g.restoreState();
 }
 
+juce::Rectangle<int> AutomationLaneComponent::getHoverOverlayBounds()
+{
+    const auto margin = static_cast<float>(getAutomationPointWidth()) + 2.0f;
+    const auto height = static_cast<float>(getHeight());
+
+    auto column = [&](float x1, float x2) { return juce::Rectangle<float>(juce::jmin(x1, x2) - margin, 0.0f, std::abs(x2 - x1) + 2.0f * margin, height); };
+
+    juce::Rectangle<float> bounds;
+
+    if (!m_hoveredRect.isEmpty())
+        bounds = column(m_hoveredRect.getX(), m_hoveredRect.getRight());
+
+    const auto &curve = m_parameter->getCurve();
+    const auto numPoints = curve.getNumPoints();
+
+    if (juce::isPositiveAndBelow(m_hoveredPoint, numPoints))
+    {
+        auto x = timeToX(curve.getPointTime(m_hoveredPoint));
+        bounds = bounds.getUnion(column(x, x));
+    }
+
+    if (m_hoveredCurve > 0 && m_hoveredCurve < numPoints)
+        bounds = bounds.getUnion(column(timeToX(curve.getPointTime(m_hoveredCurve - 1)), timeToX(curve.getPointTime(m_hoveredCurve))));
+
+    return bounds.getSmallestIntegerContainer().getIntersection(getLocalBounds());
+}
+
+juce::SortedSet<int> AutomationLaneComponent::getSelectedPointIndices() const
+{
+    juce::SortedSet<int> indices;
+
+    for (auto p : m_editViewState.m_selectionManager.getItemsOfType<SelectableAutomationPoint>())
+        if (p->m_curve.getOwnerParameter() == m_parameter->getCurve().getOwnerParameter())
+            indices.add(p->index);
+
+    return indices;
+}
+
+// binary search, the points of a curve are sorted by time
+int AutomationLaneComponent::firstIndexAtOrAfter(const te::AutomationCurve &curve, tracktion::TimePosition t)
+{
+    int low = 0, high = curve.getNumPoints();
+
+    while (low < high)
+    {
+        auto mid = (low + high) / 2;
+
+        if (curve.getPointTime(mid) < t)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
 // reimplemented from te::AutomatonCurve because we
 // need to return -1 if there is no point after this position
 int AutomationLaneComponent::nextIndexAfter(tracktion::TimePosition t, te::AutomatableParameter::Ptr ap) const
 {
-    auto num = ap->getCurve().getNumPoints();
+    const auto &curve = ap->getCurve();
+    auto index = firstIndexAtOrAfter(curve, t);
 
-    for (int i = 0; i < num; ++i)
-        if (ap->getCurve().getPointTime(i) >= t)
-            return i;
-
-    return -1;
+    return index < curve.getNumPoints() ? index : -1;
 }
 
 juce::Point<float> AutomationLaneComponent::getPointOnAutomation(int index, juce::Rectangle<float> drawRect, double startBeat, double endBeat)
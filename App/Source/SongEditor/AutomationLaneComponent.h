@@ -59,8 +59,6 @@ public:
     void mouseUp(const juce::MouseEvent &e) override;
     void mouseExit(const juce::MouseEvent &e) override;
 
-    void selectPointsInLasso(juce::Rectangle<int> lassoRect, bool addToSelection);
-
     te::AutomatableParameter::Ptr getAutomatableParameter() const { return m_parameter; }
 
     void setHoveredCurve(int index)
@@ -152,7 +150,35 @@ private:
     juce::int64 m_lastPaintTime = 0;
     static constexpr int kMinPaintIntervalMs = 16; // ~60 FPS
 
+    // Paths of the curve for one zoom level, built over a screen more than the
+    // visible range on both sides and translated while scrolling. The hover
+    // and selection overlays are drawn on top of it on every paint.
+    struct CurveLayer
+    {
+        bool covers(double visibleStartBeat, double visibleEndBeat, juce::Rectangle<float> bounds) const;
+
+        tracktion::TimeRange range;
+        juce::Rectangle<float> rect;
+        double startBeat = 0.0;
+        double endBeat = 0.0;
+        double pixelsPerBeat = 0.0;
+        int startIndex = -1;
+        int endIndex = -1;
+        juce::Path curve;
+        juce::Path fill;
+        juce::Path points;
+        bool isValid = false;
+    };
+
+    void buildCurveLayer(CurveLayer &layer, tracktion::TimeRange drawRange, juce::Rectangle<float> drawRect);
+    void drawCurveLayer(juce::Graphics &g, const CurveLayer &layer, juce::Rectangle<float> drawRect, double startBeat, double endBeat);
+    juce::Rectangle<int> getHoverOverlayBounds();
+    juce::SortedSet<int> getSelectedPointIndices() const;
+
+    CurveLayer m_curveLayer;
+
     bool isAutomationPointSelected(int index);
+    static int firstIndexAtOrAfter(const te::AutomationCurve &curve, tracktion::TimePosition t);
     int nextIndexAfter(tracktion::TimePosition t, te::AutomatableParameter::Ptr ap) const;
     juce::Point<float> getPointOnAutomation(int index, juce::Rectangle<float> drawRect, double startBeat, double endBeat);
     juce::Point<float> getCurveControlPoint(juce::Point<float> p1, juce::Point<float> p2, float curve);
@@ -24,35 +24,6 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 #include "MainComponent.h"
 #include "Utilities/Utilities.h"
 
-namespace
-{
-void rewriteAutoSaveSourcePaths(juce::ValueTree node, te::Edit &edit, const juce::File &targetDirectory)
-{
-    if (node.hasProperty(te::IDs::source))
-    {
-        auto oldRelativePath = node.getProperty(te::IDs::source).toString();
-
-        if (oldRelativePath.isNotEmpty())
-        {
-            auto absoluteSourceFile = edit.filePathResolver(oldRelativePath);
-
-            if (absoluteSourceFile.existsAsFile())
-            {
-                auto newRelativePath = absoluteSourceFile.getRelativePathFrom(targetDirectory);
-                node.setProperty(te::IDs::source, newRelativePath, nullptr);
-            }
-            else
-            {
-                GUIHelpers::log("WARNING: Source file not found during autosave: " + absoluteSourceFile.getFullPathName());
-            }
-        }
-    }
-
-    for (int i = 0; i < node.getNumChildren(); ++i)
-        rewriteAutoSaveSourcePaths(node.getChild(i), edit, targetDirectory);
-}
-} // namespace
-
 EditComponent::EditComponent(te::Edit &e, EditViewState &evs, ApplicationViewState &avs, te::SelectionManager &sm, juce::ApplicationCommandManager &cm)
     : m_edit(e),
       m_editViewState(evs),
@@ -186,6 +157,14 @@ EditComponent::EditComponent(te::Edit &e, EditViewState &evs, ApplicationViewSta
     startTimer(juce::jmax(1, static_cast<int>(m_editViewState.m_applicationState.m_autoSaveInterval)));
     trimMidiNotesToClipStart();
 
+    // an edit living in the temp directory (new or restored) is its own autosave
+    auto tempDir = m_edit.getTempDirectory(false);
+    auto targetTempFile = m_edit.editFileRetriever();
+    if (targetTempFile.getParentDirectory() != tempDir)
+        targetTempFile = tempDir.getNonexistentChildFile("autosave", ".nextTemp", false);
+
+    m_autoSaveJournal = std::make_unique<AutoSaveJournal>(m_edit, m_autoSaveThreadPool, targetTempFile);
+
     m_editViewState.m_needAutoSave = true;
     saveTempFile();
 }
@@ -242,6 +221,8 @@ void EditComponent::resized()
     GUIHelpers::log("EditComponent: resized()");
     m_toolBar.setBounds(getToolBarRect());
     m_timeLine.setBounds(getTimeLineRect());
+    updateTrackViews();
+
     m_trackListView.setBounds(getScrollableTrackListRect());
     m_trackListView.resized();
     auto rect = getTrackListToolsRect().removeFromRight(getTrackListToolsRect().getWidth() / 2);
@@ -416,11 +397,6 @@ void EditComponent::saveTempFile()
         return;
     }
 
-    auto tempDir = m_edit.getTempDirectory(false);
-    auto targetTempFile = Helpers::findRecentEdit(tempDir);
-    if (!targetTempFile.existsAsFile())
-        targetTempFile = tempDir.getNonexistentChildFile("autosave", ".nextTemp", false);
-
     try
     {
         if (m_autoSaveInProgress.exchange(true))
@@ -429,16 +405,18 @@ void EditComponent::saveTempFile()
             return;
         }
 
+        // The journal records every change as it happens, a flush only hands
+        // the records since the last one to the autosave thread.
         const auto generation = m_autoSaveGeneration.load();
-        auto editStateCopy = m_edit.state.createCopy();
-
-        // Keep the dirty state alive when edits arrive while the snapshot is being copied.
-        if (generation != m_autoSaveGeneration.load())
-            m_autoSaveQueued = true;
+        juce::Component::SafePointer<EditComponent> safeThis(this);
+        auto targetTempFile = m_autoSaveJournal->getSnapshotFile();
 
-        rewriteAutoSaveSourcePaths(editStateCopy, m_edit, targetTempFile.getParentDirectory());
-
-        queueTempFileWrite(std::move(editStateCopy), targetTempFile, generation);
+        m_autoSaveJournal->flush(
+            [safeThis, generation, targetTempFile](bool wasSuccessful)
+            {
+                if (safeThis != nullptr)
+                    safeThis->handleTempFileWriteFinished(wasSuccessful, generation, targetTempFile);
+            });
     }
     catch (const std::exception &e)
     {
@@ -447,40 +425,6 @@ void EditComponent::saveTempFile()
     }
 }
 
-void EditComponent::queueTempFileWrite(juce::ValueTree editStateCopy, const juce::File &targetTempFile, juce::uint64 generation)
-{
-    juce::Component::SafePointer<EditComponent> safeThis(this);
-
-    m_autoSaveThreadPool.addJob(
-        [safeThis, editStateCopy = std::move(editStateCopy), targetTempFile, generation]() mutable
-        {
-            bool wasSuccessful = false;
-
-            try
-            {
-                juce::TemporaryFile tempFile(targetTempFile);
-
-                if (auto output = std::unique_ptr<juce::FileOutputStream>(tempFile.getFile().createOutputStream()))
-                {
-                    editStateCopy.writeToStream(*output);
-                    output->flush();
-                    wasSuccessful = tempFile.overwriteTargetFileWithTemporary();
-                }
-            }
-            catch (const std::exception &e)
-            {
-                GUIHelpers::log("ERROR: Exception during autosave write: " + juce::String(e.what()));
-            }
-
-            juce::MessageManager::callAsync(
-                [safeThis, wasSuccessful, generation, targetTempFile]
-                {
-                    if (safeThis != nullptr)
-                        safeThis->handleTempFileWriteFinished(wasSuccessful, generation, targetTempFile);
-                });
-        });
-}
-
 void EditComponent::handleTempFileWriteFinished(bool wasSuccessful, juce::uint64 generation, const juce::File &targetTempFile)
 {
     m_autoSaveInProgress = false;
@@ -507,11 +451,19 @@ void EditComponent::valueTreePropertyChanged(juce::ValueTree &v, const juce::Ide
     if (i == te::IDs::loopPoint1 || i == te::IDs::loopPoint2 || i == te::IDs::looping)
         markAndUpdate(m_updateZoom);
 
-    if (i == te::IDs::height || i == IDs::isTrackMinimized || i == IDs::viewY)
+    if (i == te::IDs::height || i == IDs::isTrackMinimized)
     {
+        // mostly the height manager flashing its own values, which it already has
+        if (!m_editViewState.m_trackHeightManager->updateFromState(v, i))
+            markAndUpdate(m_updateTracks);
+
         markAndUpdate(m_verticalUpdateSongEditor);
     }
 
+    // scrolling doesn't change any height, only the views have to follow
+    if (i == IDs::viewY)
+        markAndUpdate(m_verticalScroll);
+
     if (i == te::IDs::lastSignificantChange)
     {
         ++m_autoSaveGeneration;
@@ -528,8 +480,6 @@ void EditComponent::valueTreePropertyChanged(juce::ValueTree &v, const juce::Ide
     {
         if (i == IDs::lowerRangeView || i == IDs::pianorollHeight || i == IDs::showHeaders || i == IDs::showFooters)
             markAndUpdate(m_updateZoom);
-        else if (i == IDs::viewY)
-            resized();
         else if (i == IDs::drawWaveforms)
             repaint();
     }
@@ -549,14 +499,14 @@ void EditComponent::valueTreeChildAdded(juce::ValueTree &parent, juce::ValueTree
     if (c.hasType(te::IDs::POINT))
     {
         if (parent.hasType(te::IDs::AUTOMATIONCURVE) && parent.getNumChildren() == 1)
-            markAndUpdate(m_updateTracks);
+            markAndUpdate(m_updateAutomationLanes);
 
         markAndUpdate(m_verticalUpdateSongEditor);
     }
     if (c.hasType(te::IDs::AUTOMATIONCURVE))
     {
         GUIHelpers::log(c.toXmlString());
-        markAndUpdate(m_updateTracks);
+        markAndUpdate(m_updateAutomationLanes);
         markAndUpdate(m_verticalUpdateSongEditor);
     }
 }
@@ -574,18 +524,18 @@ void EditComponent::valueTreeChildRemoved(juce::ValueTree &parent, juce::ValueTr
     if (c.hasType(te::IDs::POINT))
     {
         if (parent.hasType(te::IDs::AUTOMATIONCURVE) && parent.getNumChildren() == 0)
-            markAndUpdate(m_updateTracks);
+            markAndUpdate(m_updateAutomationLanes);
 
         markAndUpdate(m_verticalUpdateSongEditor);
     }
     if (c.hasType(te::IDs::PLUGIN))
     {
-        markAndUpdate(m_updateTracks);
+        markAndUpdate(m_updateAutomationLanes);
     }
     if (c.hasType(te::IDs::AUTOMATIONCURVE))
     {
         GUIHelpers::log(c.toXmlString());
-        markAndUpdate(m_updateTracks);
+        markAndUpdate(m_updateAutomationLanes);
         markAndUpdate(m_verticalUpdateSongEditor);
     }
 }
@@ -602,9 +552,22 @@ void EditComponent::handleAsyncUpdate()
     {
         sendAllNotedOff();
     }
+    if (compareAndReset(m_updateAutomationLanes))
+    {
+        // the lanes update the automation heights of their track while building
+        m_songEditor.buildAutomationLanes();
+        m_trackListView.buildAutomationHeaders();
+        if (m_masterLane)
+            m_masterLane->buildAutomationLanes();
+        if (m_masterHeader)
+            m_masterHeader->buildAutomationHeader();
+
+        m_updateTracks = true;
+    }
     if (compareAndReset(m_updateTracks))
     {
-        buildTracks();
+        m_editViewState.m_trackHeightManager->regenerateTrackHeightsFromEdit(m_edit);
+        resized();
         m_songEditor.repaint();
         if (m_masterLane)
             m_masterLane->repaint();
@@ -626,7 +589,9 @@ void EditComponent::handleAsyncUpdate()
     }
     if (compareAndReset(m_verticalUpdateSongEditor))
     {
-        m_editViewState.m_trackHeightManager->regenerateTrackHeightsFromEdit(m_edit);
+        m_verticalScroll = false; // the full update below places the views as well
+
+        // the height manager is kept up to date incrementally, see valueTreePropertyChanged
         resized();
 
         m_trackListView.repaintTrackHeaders();
@@ -639,6 +604,14 @@ void EditComponent::handleAsyncUpdate()
 
         updateVerticalScrollbar();
     }
+    if (compareAndReset(m_verticalScroll))
+    {
+        // the layout table is up to date, only the views near the new
+        // position have to be created and placed
+        resized();
+        m_songEditor.repaint();
+        updateVerticalScrollbar();
+    }
 }
 void EditComponent::updateButtonIcons()
 {
@@ -664,49 +637,67 @@ void EditComponent::refreshSnapTypeDesc()
     m_footerbar.repaint();
 }
 
-void EditComponent::buildTracks()
+void EditComponent::updateTrackViews()
 {
-    m_trackListView.clear();
-    m_songEditor.clear();
+    auto &trackHeightManager = m_editViewState.m_trackHeightManager;
 
-    m_masterHeader.reset();
-    m_masterLane.reset();
+    // create views one screen above and below the visible area, but only drop
+    // them when they are two screens away, so scrolling back and forth does
+    // not rebuild the same tracks over and over
+    const int viewHeight = juce::jmax(1, getScrollableSongEditorRect().getHeight());
+    const int viewTop = -juce::roundToInt(m_editViewState.getViewYScroll(m_timeLine.getTimeLineID()));
+    const auto createRange = juce::Range<int>(viewTop - viewHeight, viewTop + 2 * viewHeight);
+    const auto keepRange = juce::Range<int>(viewTop - 2 * viewHeight, viewTop + 3 * viewHeight);
 
-    auto masterTrack = findMasterTrack();
+    const auto tracksToKeep = trackHeightManager->getShowedTracksInRange(keepRange);
+    m_trackListView.removeHeaderViewsExcept(tracksToKeep);
+    m_songEditor.removeTrackLanesExcept(tracksToKeep);
 
-    for (auto t : tracktion_engine::getAllTracks(m_edit))
+    bool addedViews = false;
+
+    for (auto t : trackHeightManager->getShowedTracksInRange(createRange))
     {
-        if (t == nullptr || t->isMasterTrack())
+        if (t->isMasterTrack())
             continue;
 
-        if (m_editViewState.m_trackHeightManager->isTrackShowable(t))
+        if (m_trackListView.getTrackHeaderView(t) == nullptr)
         {
-            auto th = std::make_unique<TrackHeaderComponent>(m_editViewState, t);
-            auto tl = std::make_unique<TrackLaneComponent>(m_editViewState, t, m_timeLine.getTimeLineID(), m_songEditor);
-            m_trackListView.addHeaderView(std::move(th));
-            m_songEditor.addTrackLaneComponent(std::move(tl));
+            m_trackListView.addHeaderView(std::make_unique<TrackHeaderComponent>(m_editViewState, t));
+            addedViews = true;
+        }
+
+        if (m_songEditor.getTrackLane(t) == nullptr)
+        {
+            m_songEditor.addTrackLaneComponent(std::make_unique<TrackLaneComponent>(m_editViewState, t, m_timeLine.getTimeLineID(), m_songEditor));
+            addedViews = true;
         }
     }
 
-    if (masterTrack)
+    auto masterTrack = findMasterTrack();
+
+    if (masterTrack == nullptr)
+    {
+        m_masterHeader.reset();
+        m_masterLane.reset();
+    }
+    else if (m_masterHeader == nullptr || m_masterHeader->getTrack() != masterTrack)
     {
         m_masterHeader = std::make_unique<TrackHeaderComponent>(m_editViewState, masterTrack);
         m_masterLane = std::make_unique<TrackLaneComponent>(m_editViewState, masterTrack, m_timeLine.getTimeLineID(), m_songEditor);
         addAndMakeVisible(*m_masterHeader);
         addAndMakeVisible(*m_masterLane);
+        addedViews = true;
     }
 
-    m_trackListView.updateViews();
-    m_songEditor.updateViews();
-    m_playhead.toFront(false);
-    resized();
+    if (addedViews)
+        m_playhead.toFront(false);
 }
 
 void EditComponent::getAllCommands(juce::Array<juce::CommandID> &commands)
 {
     juce::Array<juce::CommandID> ids{
 
-        KeyPressCommandIDs::deleteSelectedClips, KeyPressCommandIDs::duplicateSelectedClips, KeyPressCommandIDs::selectAllClips, KeyPressCommandIDs::renderSelectedTimeRangeToNewTrack, KeyPressCommandIDs::transposeClipUp, KeyPressCommandIDs::transposeClipDown, KeyPressCommandIDs::reverseClip,
+        KeyPressCommandIDs::deleteSelectedClips, KeyPressCommandIDs::duplicateSelectedClips, KeyPressCommandIDs::selectAllClips, KeyPressCommandIDs::renderSelectedTimeRangeToNewTrack, KeyPressCommandIDs::reduceSelectedAutomation, KeyPressCommandIDs::transposeClipUp, KeyPressCommandIDs::transposeClipDown, KeyPressCommandIDs::reverseClip,
     };
 
     commands.addArray(ids);
@@ -735,6 +726,10 @@ void EditComponent::getCommandInfo(juce::CommandID commandID, juce::ApplicationC
         result.setInfo("render time range to new track", "render time range on new track", "Song Editor", 0);
         result.addDefaultKeypress(juce::KeyPress::createFromDescription("r").getKeyCode(), juce::ModifierKeys::commandModifier);
         break;
+    case KeyPressCommandIDs::reduceSelectedAutomation:
+        result.setInfo("thin automation", "remove redundant automation points in the selected time range", "Song Editor", 0);
+        result.addDefaultKeypress(juce::KeyPress::createFromDescription("t").getKeyCode(), juce::ModifierKeys::commandModifier | juce::ModifierKeys::shiftModifier);
+        break;
     case KeyPressCommandIDs::transposeClipUp:
         result.setInfo("transpose up", "transpose selected clips up 1 key", "Song Editor", 0);
         result.addDefaultKeypress(juce::KeyPress::upKey, juce::ModifierKeys::commandModifier);
@@ -782,6 +777,9 @@ bool EditComponent::perform(const juce::ApplicationCommandTarget::InvocationInfo
     case KeyPressCommandIDs::renderSelectedTimeRangeToNewTrack:
         m_songEditor.renderSelectedTimeRangeToNewTrack();
         break;
+    case KeyPressCommandIDs::reduceSelectedAutomation:
+        m_songEditor.reduceSelectedTimeRangeAutomation();
+        break;
     case KeyPressCommandIDs::transposeClipUp:
         GUIHelpers::log("perform: transposeClipUp");
         m_songEditor.transposeSelectedClips(+1.f);
@@ -973,15 +971,7 @@ te::Track::Ptr EditComponent::findMasterTrack()
 }
 int EditComponent::getSongHeight()
 {
-    auto h = 0;
-
-    for (auto track : m_editViewState.m_trackHeightManager->getShowedTracks(m_edit))
-    {
-        auto trackID = m_editViewState.m_trackHeightManager->getTrackFromID(m_editViewState.m_edit, track);
-        h += m_editViewState.m_trackHeightManager->getTrackHeight(trackID, true);
-    }
-
-    return h;
+    return m_editViewState.m_trackHeightManager->getShowedLayoutHeight();
 }
 void EditComponent::loopAroundSelection()
 {
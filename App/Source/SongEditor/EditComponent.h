@@ -34,6 +34,8 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 #include "SongEditor/TrackListView.h"
 #include "Tools/tools/LassoSelectionTool.h"
 #include "UI/MenuBar.h"
+#include "Utilities/AutoSaveJournal.h"
+#include "Utilities/AutomationReducer.h"
 #include "Utilities/EditViewState.h"
 #include "Utilities/Utilities.h"
 
@@ -115,10 +117,12 @@ private:
     void valueTreeChildOrderChanged(juce::ValueTree &, int, int) override;
     void handleAsyncUpdate() override;
 
-    void buildTracks();
+    // Creates the headers and lanes of the tracks in and around the visible
+    // area and removes the ones that scrolled far enough away. Views of
+    // tracks that stay in range are kept as they are.
+    void updateTrackViews();
 
     void refreshSnapTypeDesc();
-    void queueTempFileWrite(juce::ValueTree editStateCopy, const juce::File &targetTempFile, juce::uint64 generation);
     void handleTempFileWriteFinished(bool wasSuccessful, juce::uint64 generation, const juce::File &targetTempFile);
 
     tracktion::core::TimeRange getSelectedClipRange();
@@ -209,8 +213,10 @@ private:
     juce::ScrollBar m_scrollbar_v, m_scrollbar_h;
     PlayheadComponent m_playhead{m_edit, m_editViewState, m_timeLine};
     juce::ThreadPool m_autoSaveThreadPool;
+    std::unique_ptr<AutoSaveJournal> m_autoSaveJournal;
+    AutomationReducer m_automationReducer{m_edit, m_editViewState.m_applicationState};
 
-    bool m_updateTracks = false, m_updateZoom = false, m_verticalUpdateSongEditor = false, m_dragOver = false, m_noteOffAll = false;
+    bool m_updateTracks = false, m_updateAutomationLanes = false, m_updateZoom = false, m_verticalUpdateSongEditor = false, m_verticalScroll = false, m_dragOver = false, m_noteOffAll = false;
     int m_sendsAreaHeight = 0;
     std::atomic<bool> m_autoSaveInProgress{false}, m_autoSaveQueued{false};
     std::atomic<juce::uint64> m_autoSaveGeneration{0};
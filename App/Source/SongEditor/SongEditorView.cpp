@@ -22,6 +22,8 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 
 #include "SongEditor/SongEditorView.h"
 #include "SideBrowser/Browser_Base.h"
+#include "Utilities/AutomationReducer.h"
+#include "Utilities/ClipEditBatch.h"
 #include "Utilities/TimeUtils.h"
 #include "Utilities/Utilities.h"
 
@@ -136,16 +138,15 @@ void SongEditorView::resized()
 {
     auto &trackHeightManager = m_editViewState.m_trackHeightManager;
     const int yScroll = juce::roundToInt(m_editViewState.getViewYScroll(m_timeLine.getTimeLineID()));
-    int y = yScroll;
 
     for (auto lane : m_trackLanes)
     {
-        auto trackHeaderHeight = trackHeightManager->getTrackHeight(lane->getTrack(), true);
-        auto leftEdge = 0;
-        auto w = getWidth();
+        auto trackY = trackHeightManager->getShowedYForTrack(lane->getTrack());
 
-        lane->setBounds(leftEdge, y, w, trackHeaderHeight);
-        y += trackHeaderHeight;
+        if (trackY < 0)
+            lane->setBounds({});
+        else
+            lane->setBounds(0, yScroll + trackY, getWidth(), trackHeightManager->getTrackHeight(lane->getTrack(), true));
     }
 
     m_lassoComponent.setBounds(getLocalBounds());
@@ -252,13 +253,8 @@ void SongEditorView::itemDragMove(const SourceDetails &dragSourceDetails)
     }
     else
     {
-        auto showedTracks = m_editViewState.m_trackHeightManager->getShowedTracks(m_editViewState.m_edit);
-        te::Track::Ptr lastTrack;
-
-        if (!showedTracks.isEmpty())
-            lastTrack = m_editViewState.m_trackHeightManager->getTrackFromID(m_editViewState.m_edit, showedTracks.getLast());
-
-        y = lastTrack ? getYForTrack(lastTrack) + m_editViewState.m_trackHeightManager->getTrackHeight(lastTrack, true) : 0;
+        auto layoutHeight = m_editViewState.m_trackHeightManager->getShowedLayoutHeight();
+        y = layoutHeight > 0 ? layoutHeight + juce::roundToInt(m_editViewState.getViewYScroll(m_timeLine.getTimeLineID())) : 0;
         h = static_cast<int>(m_editViewState.m_trackDefaultHeight);
 
         m_dragItemRect.drawRect = {x, y, w, h};
@@ -326,17 +322,8 @@ void SongEditorView::addWaveFileToTrack(te::AudioFile audioFile, double dropTime
 
 te::Track::Ptr SongEditorView::getTrackAt(int y)
 {
-    for (auto trackID : m_editViewState.m_trackHeightManager->getShowedTracks(m_editViewState.m_edit))
-    {
-        auto t = m_editViewState.m_trackHeightManager->getTrackFromID(m_editViewState.m_edit, trackID);
-        auto s = getYForTrack(t);
-        auto e = s + m_editViewState.m_trackHeightManager->getTrackHeight(t, true);
-        auto vRange = juce::Range<int>(s, e);
-        if (vRange.contains(y))
-            return t;
-    }
-
-    return nullptr;
+    const auto scrollY = juce::roundToInt(m_editViewState.getViewYScroll(m_timeLine.getTimeLineID()));
+    return m_editViewState.m_trackHeightManager->getShowedTrackForY(y - scrollY);
 }
 
 int SongEditorView::getYForTrack(te::Track *track)
@@ -344,22 +331,11 @@ int SongEditorView::getYForTrack(te::Track *track)
     if (track == nullptr)
         return -1;
 
-    int y = juce::roundToInt(m_editViewState.getViewYScroll(m_timeLine.getTimeLineID()));
-    const auto showedTracks = m_editViewState.m_trackHeightManager->getShowedTracks(m_editViewState.m_edit);
-
-    for (const auto &trackID : showedTracks)
-    {
-        auto visibleTrack = m_editViewState.m_trackHeightManager->getTrackFromID(m_editViewState.m_edit, trackID);
-        if (visibleTrack == nullptr)
-            continue;
-
-        if (visibleTrack.get() == track)
-            return y;
-
-        y += m_editViewState.m_trackHeightManager->getTrackHeight(visibleTrack, true);
-    }
+    const auto y = m_editViewState.m_trackHeightManager->getShowedYForTrack(track);
+    if (y < 0)
+        return -1;
 
-    return -1;
+    return y + juce::roundToInt(m_editViewState.getViewYScroll(m_timeLine.getTimeLineID()));
 }
 
 void SongEditorView::updateDragGhost(te::Clip::Ptr clip, tracktion::TimeDuration delta, int verticalOffset)
@@ -710,6 +686,18 @@ void SongEditorView::deleteSelectedTimeRange()
     for (auto a : m_selectedRange.selectedAutomations)
         a->getCurve().removePointsInRegion(m_selectedRange.timeRange);
 }
+
+void SongEditorView::reduceSelectedTimeRangeAutomation()
+{
+    const float tolerance = m_editViewState.m_applicationState.m_automationReduceTolerance;
+    int removed = 0;
+
+    for (auto ap : m_selectedRange.selectedAutomations)
+        removed += AutomationReducer::reduce(EngineHelpers::getTrackAutomationSection(ap, m_selectedRange.timeRange), tolerance);
+
+    GUIHelpers::log("reduceSelectedTimeRangeAutomation: removed points: ", removed);
+}
+
 void SongEditorView::setSelectedTimeRange(tracktion::TimeRange tr, bool snapDownAtStart, bool snapDownAtEnd)
 {
     auto start = tr.getStart();
@@ -757,18 +745,32 @@ void SongEditorView::updateAutomationSelection(bool add)
     if (!add)
         m_editViewState.m_selectionManager.deselectAll();
 
+    // deleting them takes the points of the last update out of the selection
+    m_lassoSelectedPoints.clear();
+
     auto lassoRect = m_lassoComponent.getLassoRect().m_rect;
+    auto &trackHeightManager = *m_editViewState.m_trackHeightManager;
 
-    for (auto *tl : m_trackLanes)
+    // only the lanes near the viewport have components, the layout knows all
+    const auto yScroll = juce::roundToInt(m_editViewState.getViewYScroll(m_timeLine.getTimeLineID()));
+    const auto lanes = trackHeightManager.getShowedAutomationLanesInRange(lassoRect.getVerticalRange() - yScroll);
+
+    for (const auto &lane : lanes)
     {
-        if (auto t = tl->getTrack())
+        auto &curve = lane.param->getCurve();
+        const auto laneY = lane.showedY + yScroll;
+
+        for (int i = 0; i < curve.getNumPoints(); ++i)
         {
-            for (auto *ap : t->getAllAutomatableParams())
+            auto point = curve.getPoint(i);
+            auto x = m_editViewState.timeToX(point.time.inSeconds(), m_timeLine.getTimeLineID(), getWidth());
+            auto y = laneY + static_cast<int>(juce::jmap(static_cast<double>(point.value), static_cast<double>(lane.param->valueRange.start), static_cast<double>(lane.param->valueRange.end), static_cast<double>(lane.height), 0.0));
+
+            if (lassoRect.contains(static_cast<int>(x), y))
             {
-                if (auto *al = tl->getAutomationLane(ap))
-                {
-                    al->selectPointsInLasso(lassoRect, add);
-                }
+                auto selectablePoint = std::make_unique<SelectableAutomationPoint>(i, curve);
+                m_editViewState.m_selectionManager.select(selectablePoint.get(), true);
+                m_lassoSelectedPoints.add(std::move(selectablePoint));
             }
         }
     }
@@ -813,15 +815,18 @@ void SongEditorView::selectClipsInLasso(const tracktion_engine::Track *track)
 
 void SongEditorView::moveSelectedTimeRanges(tracktion::TimeDuration td, bool copy)
 {
+    ClipEditBatch batch(m_editViewState, copy ? "Copy Time Range" : "Move Time Range");
+
     for (auto t : m_selectedRange.selectedTracks)
         if (t != nullptr)
             moveSelectedRangeOfTrack(t, td, copy);
 
+    juce::Array<te::TrackAutomationSection> sections;
+
     for (auto ap : m_selectedRange.selectedAutomations)
-    {
-        auto as = EngineHelpers::getTrackAutomationSection(ap, m_selectedRange.timeRange);
-        EngineHelpers::moveAutomationOrCopy(as, td, copy);
-    }
+        sections.add(EngineHelpers::getTrackAutomationSection(ap, m_selectedRange.timeRange));
+
+    EngineHelpers::moveAutomationOrCopy(sections, td, copy);
 }
 
 void SongEditorView::moveSelectedRangeOfTrack(te::Track::Ptr track, tracktion::TimeDuration duration, bool copy)
@@ -89,6 +89,7 @@ public:
     void duplicateSelectedClipsOrTimeRange();
     void deleteSelectedTimeRange();
     void renderSelectedTimeRangeToNewTrack();
+    void reduceSelectedTimeRangeAutomation();
     void transposeSelectedClips(float pitchChange);
     void reverseSelectedClips();
     juce::Array<te::Track *> getTracksWithSelectedTimeRange();
@@ -111,31 +112,33 @@ public:
     void finishTimeRangeDrag(bool copy);
     void cancelTimeRangeDrag();
 
+    // Only the lanes of tracks near the visible area exist, see TrackListView
     void addTrackLaneComponent(std::unique_ptr<TrackLaneComponent> tlc)
     {
-        m_trackLanes.add(std::move(tlc));
+        addAndMakeVisible(m_trackLanes.add(std::move(tlc)));
         resized();
     }
 
-    void updateViews()
+    void removeTrackLanesExcept(const juce::Array<te::Track *> &tracksToKeep)
     {
-        removeAllChildren();
-
-        for (auto v : m_trackLanes)
-            addAndMakeVisible(v);
+        for (int i = m_trackLanes.size(); --i >= 0;)
+            if (!tracksToKeep.contains(m_trackLanes[i]->getTrack().get()))
+                m_trackLanes.remove(i);
+    }
 
-        addChildComponent(m_lassoComponent);
-        addAndMakeVisible(m_timeRangeOverlay);
-        m_lassoComponent.setAlwaysOnTop(true);
-        m_timeRangeOverlay.setAlwaysOnTop(true);
+    TrackLaneComponent *getTrackLane(te::Track *track)
+    {
+        for (auto tl : m_trackLanes)
+            if (tl->getTrack().get() == track)
+                return tl;
 
-        resized();
+        return nullptr;
     }
 
-    void clear()
+    void buildAutomationLanes()
     {
-        m_trackLanes.clear(true);
-        resized();
+        for (auto tl : m_trackLanes)
+            tl->buildAutomationLanes();
     }
 
 private:
@@ -205,6 +208,8 @@ private:
     MenuBar &m_toolBar;
     TimeLineComponent &m_timeLine;
     LassoSelectionTool m_lassoComponent;
+    // points selected by the lasso, also on lanes that have no component
+    juce::OwnedArray<SelectableAutomationPoint> m_lassoSelectedPoints;
 
     // flags
     bool m_isDragging{false};
@@ -25,6 +25,7 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 #include "SideBrowser/PluginBrowser.h"
 #include "SongEditor/EditComponent.h"
 #include "UI/PluginInsertFeedback.h"
+#include "Utilities/AutomationReducer.h"
 #include "Utilities/EditViewState.h"
 #include "Utilities/Utilities.h"
 #include "juce_graphics/juce_graphics.h"
@@ -182,12 +183,18 @@ void AutomationLaneHeaderComponent::mouseDown(const juce::MouseEvent &event)
     {
         juce::PopupMenu m;
         m.addItem(2000, "Delete automation");
+        m.addItem(2001, "Thin automation", m_automatableParameter->getCurve().getNumPoints() > 2);
         const int result = m.show();
         if (result == 2000)
         {
             m_automatableParameter->getCurve().clear();
             te::AutomationCurve::removeAllAutomationCurvesRecursively(m_automatableParameter->getCurve().parentState);
         }
+        else if (result == 2001)
+        {
+            auto &curve = m_automatableParameter->getCurve();
+            AutomationReducer::reduce(curve, {curve.getPointTime(0), curve.getPointTime(curve.getNumPoints() - 1)}, m_evs.m_applicationState.m_automationReduceTolerance);
+        }
     }
     else if (event.mods.isLeftButtonDown())
     {
@@ -401,6 +408,10 @@ void TrackHeaderComponent::valueTreePropertyChanged(juce::ValueTree &v, const ju
         {
             m_soloButton.setToggleState((bool)v[i], juce::dontSendNotification);
         }
+        else if (i == IDs::frozenClip)
+        {
+            repaint();
+        }
     }
     if (v.hasType(te::IDs::INPUTDEVICES) || v.hasType(te::IDs::INPUTDEVICE) || v.hasType(te::IDs::INPUTDEVICEDESTINATION))
     {
@@ -455,6 +466,13 @@ void TrackHeaderComponent::showPopupMenu(tracktion_engine::Track *at)
             m.addItem(1000, "Input Monitoring", true, ticked);
             m.addSeparator();
         }
+
+        if (EngineHelpers::isTrackFreezing(m_editViewState, *aut))
+            m.addItem(2002, "Freezing...", false, false);
+        else
+            m.addItem(2002, "Freeze Track", true, EngineHelpers::isTrackFrozen(*aut));
+
+        m.addSeparator();
     }
 
     juce::PopupMenu inputMenu;
@@ -546,6 +564,16 @@ void TrackHeaderComponent::showPopupMenu(tracktion_engine::Track *at)
     {
         m_trackName.showEditor();
     }
+    else if (result == 2002)
+    {
+        if (auto aut = dynamic_cast<te::AudioTrack *>(m_track.get()))
+        {
+            if (EngineHelpers::isTrackFrozen(*aut))
+                EngineHelpers::unfreezeTrack(m_editViewState, *aut);
+            else
+                EngineHelpers::freezeTrack(m_editViewState, *aut);
+        }
+    }
     else if (result == 1000)
     {
         if (auto aut = dynamic_cast<te::AudioTrack *>(m_track.get()))
@@ -704,7 +732,7 @@ void TrackHeaderComponent::buildAutomationHeader()
 {
     m_automationHeaders.clear(true);
 
-    m_editViewState.m_trackHeightManager->regenerateTrackHeightsFromEdit(m_track->edit);
+    m_editViewState.m_trackHeightManager->updateAutomationParameters(m_track);
 
     auto *trackInfo = m_editViewState.m_trackHeightManager->getTrackInfoForTrack(m_track);
     if (trackInfo == nullptr)
@@ -765,6 +793,12 @@ void TrackHeaderComponent::paint(juce::Graphics &g)
         g.setColour(trackColor);
         GUIHelpers::drawRoundedRectWithSide(g, trackColorIndicator, cornerSize, true, false, true, false);
 
+        if (EngineHelpers::isTrackFrozen(*m_track))
+        {
+            g.setColour(juce::Colours::lightblue.withAlpha(0.6f));
+            GUIHelpers::drawRoundedRectWithSide(g, trackColorIndicator, cornerSize, true, false, true, false);
+        }
+
         g.setColour(m_editViewState.m_applicationState.getBorderColour());
         // g.setColour(buttonColour.brighter(0.2f));
         GUIHelpers::strokeRoundedRectWithSide(g, borderRect, cornerSize, true, false, true, false);
@@ -236,6 +236,7 @@ public:
     bool isFolderTrack() { return m_track->isFolderTrack(); }
 
     void collapseTrack(bool minimize);
+    void buildAutomationHeader();
 
 private:
     void handleAsyncUpdate() override;
@@ -259,7 +260,6 @@ private:
     std::unique_ptr<LevelMeterComponent> levelMeterComp;
     juce::Image m_dragImage;
     bool m_isResizing{false}, m_isHover{false}, m_contentIsOver{false}, m_trackIsOver{false}, m_isDragging{false}, m_isAudioTrack{false}, m_updateAutomationLanes{false}, m_updateTrackHeight{false};
-    void buildAutomationHeader();
     juce::OwnedArray<AutomationLaneHeaderComponent> m_automationHeaders;
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackHeaderComponent)
 };
@@ -21,6 +21,7 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 
 #include "SongEditor/TrackLaneComponent.h"
 #include "SongEditor/SongEditorView.h"
+#include "Utilities/ClipEditBatch.h"
 #include "Utilities/ScopedSaveLock.h"
 #include "Utilities/TimeUtils.h"
 
@@ -95,7 +96,7 @@ void TrackLaneComponent::buildAutomationLanes()
 {
     m_automationLanes.clear(true);
 
-    m_editViewState.m_trackHeightManager->regenerateTrackHeightsFromEdit(m_track->edit);
+    m_editViewState.m_trackHeightManager->updateAutomationParameters(m_track);
 
     auto *trackInfo = m_editViewState.m_trackHeightManager->getTrackInfoForTrack(m_track);
     if (trackInfo == nullptr)
@@ -265,6 +266,7 @@ void TrackLaneComponent::mouseDown(const juce::MouseEvent &e)
         }
         else if (toolMode == Tool::knife)
         {
+            ClipEditBatch batch(m_editViewState, "Split Clip");
             te::splitClips({m_hoveredClip}, xtoTime(e.x));
             return;
         }
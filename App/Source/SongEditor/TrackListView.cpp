@@ -34,26 +34,26 @@ void TrackListView::resized()
 {
     auto &trackHeightManager = m_editViewState.m_trackHeightManager;
     const int yScroll = juce::roundToInt(m_editViewState.getViewYScroll(m_timeLineID));
-    int y = yScroll;
     const int folderIndent = static_cast<int>(m_editViewState.m_applicationState.m_folderTrackIndent);
 
     for (auto header : m_trackHeaders)
     {
-        auto trackHeaderHeight = trackHeightManager->getTrackHeight(header->getTrack(), true);
-        auto leftEdge = 0;
-        auto w = getWidth();
+        auto track = header->getTrack();
+        auto y = trackHeightManager->getShowedYForTrack(track);
 
-        if (auto ft = header->getTrack()->getParentFolderTrack())
+        if (y < 0)
         {
-            if (auto ftv = getTrackHeaderView(ft))
-            {
-                leftEdge = ftv->getX() + folderIndent;
-                w = ftv->getWidth() - folderIndent;
-            }
+            header->setBounds({});
+            continue;
         }
 
-        header->setBounds(leftEdge, y, w, trackHeaderHeight);
-        y += trackHeaderHeight;
+        // the folder header may not exist, indent by the depth instead
+        int depth = 0;
+        for (auto ft = track->getParentFolderTrack(); ft != nullptr; ft = ft->getParentFolderTrack())
+            depth++;
+
+        auto leftEdge = depth * folderIndent;
+        header->setBounds(leftEdge, yScroll + y, getWidth() - leftEdge, trackHeightManager->getTrackHeight(track, true));
     }
 }
 void TrackListView::mouseDown(const juce::MouseEvent &e)
@@ -198,28 +198,25 @@ bool TrackListView::perform(const juce::ApplicationCommandTarget::InvocationInfo
     return true;
 }
 
-void TrackListView::addHeaderView(std::unique_ptr<TrackHeaderComponent> header) { m_trackHeaders.add(std::move(header)); }
+void TrackListView::addHeaderView(std::unique_ptr<TrackHeaderComponent> header) { addAndMakeVisible(m_trackHeaders.add(std::move(header))); }
 
-void TrackListView::updateViews()
+void TrackListView::removeHeaderViewsExcept(const juce::Array<te::Track *> &tracksToKeep)
 {
-    removeAllChildren();
-
-    for (auto v : m_trackHeaders)
-        addAndMakeVisible(v);
-
-    resized();
+    for (int i = m_trackHeaders.size(); --i >= 0;)
+        if (!tracksToKeep.contains(m_trackHeaders[i]->getTrack().get()))
+            m_trackHeaders.remove(i);
 }
 
-void TrackListView::repaintTrackHeaders()
+void TrackListView::buildAutomationHeaders()
 {
     for (auto th : m_trackHeaders)
-        th->repaint();
+        th->buildAutomationHeader();
 }
 
-void TrackListView::clear()
+void TrackListView::repaintTrackHeaders()
 {
-    m_trackHeaders.clear(true);
-    resized();
+    for (auto th : m_trackHeaders)
+        th->repaint();
 }
 
 te::AudioTrack::Ptr TrackListView::addTrack(bool isMidiTrack, bool isFolderTrack, juce::Colour trackColour)
@@ -247,8 +244,12 @@ const int TrackListView::getPopupResult()
 
 void TrackListView::collapseTracks(bool minimize)
 {
-    for (auto th : m_trackHeaders)
-        th->collapseTrack(minimize);
+    // also the tracks that have no header right now
+    auto &trackHeightManager = m_editViewState.m_trackHeightManager;
+
+    for (auto t : te::getAllTracks(m_editViewState.m_edit))
+        if (trackHeightManager->isTrackShowable(t))
+            trackHeightManager->setMinimized(t, minimize);
 }
 
 void TrackListView::changeListenerCallback(juce::ChangeBroadcaster *source)
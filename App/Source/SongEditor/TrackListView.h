@@ -65,12 +65,15 @@ public:
 
     bool perform(const juce::ApplicationCommandTarget::InvocationInfo &info) override;
 
+    // Only the headers of tracks near the visible area exist, EditComponent
+    // adds and removes them while scrolling. Headers are placed by the
+    // layout of the TrackHeightManager, the order of adding does not matter.
     void addHeaderView(std::unique_ptr<TrackHeaderComponent> header);
-    void updateViews();
+    void removeHeaderViewsExcept(const juce::Array<te::Track *> &tracksToKeep);
+    TrackHeaderComponent *getTrackHeaderView(tracktion_engine::Track::Ptr track);
+    void buildAutomationHeaders();
     void repaintTrackHeaders();
 
-    void clear();
-
     void collapseTracks(bool minimize);
 
 private:
@@ -81,6 +84,5 @@ private:
     EditViewState &m_editViewState;
     juce::OwnedArray<TrackHeaderComponent> m_trackHeaders;
     const int getPopupResult();
-    TrackHeaderComponent *getTrackHeaderView(tracktion_engine::Track::Ptr track);
     juce::String m_timeLineID;
 };
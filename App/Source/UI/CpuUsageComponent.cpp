@@ -0,0 +1,78 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#include "UI/CpuUsageComponent.h"
+#include "Utilities/EditViewState.h"
+
+CpuUsageComponent::CpuUsageComponent(EditViewState &evs, te::Track::Ptr track, te::Plugin::Ptr plugin)
+    : m_evs(evs),
+      m_track(std::move(track)),
+      m_plugin(std::move(plugin))
+{
+    setInterceptsMouseClicks(false, false);
+    setVisible(m_evs.m_showCpuUsage);
+
+    m_evs.m_state.addListener(this);
+    startMeterUpdates(*this);
+}
+
+CpuUsageComponent::~CpuUsageComponent()
+{
+    stopMeterUpdates();
+    m_evs.m_state.removeListener(this);
+}
+
+void CpuUsageComponent::paint(juce::Graphics &g)
+{
+    auto area = getLocalBounds().toFloat();
+
+    g.setColour(juce::Colours::black.withAlpha(0.6f));
+    g.fillRoundedRectangle(area, 3.0f);
+
+    // the share of the block time left for everything else gets small fast
+    auto colour = m_stats.max < 0.25f ? juce::Colours::lightgreen : m_stats.max < 0.5f ? juce::Colours::orange : juce::Colours::red;
+
+    g.setColour(colour);
+    g.setFont(juce::FontOptions(juce::jmin(11.0f, area.getHeight() - 2.0f)));
+    g.drawText(juce::String(m_stats.avg * 100.0f, 1) + " / " + juce::String(m_stats.max * 100.0f, 1) + "%", area.reduced(2.0f, 0.0f), juce::Justification::centred, false);
+}
+
+bool CpuUsageComponent::meterTick()
+{
+    if (m_track == nullptr)
+        return false;
+
+    auto &profiler = m_evs.getCpuProfiler();
+    auto stats = m_plugin != nullptr ? profiler.getPluginStats(*m_plugin) : profiler.getTrackStats(*m_track);
+
+    if (stats.avg == m_stats.avg && stats.max == m_stats.max)
+        return false;
+
+    m_stats = stats;
+    return true;
+}
+
+void CpuUsageComponent::valueTreePropertyChanged(juce::ValueTree &tree, const juce::Identifier &property)
+{
+    // read the tree, the CachedValue may not have been updated yet
+    if (tree == m_evs.m_state && property == IDs::showCpuUsage)
+        setVisible(static_cast<bool>(tree[property]));
+}
@@ -0,0 +1,54 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "Utilities/CpuProfiler.h"
+#include "Utilities/MeterHub.h"
+
+class EditViewState;
+
+// Small overlay with the CPU usage of a track or of one plugin, average and
+// peak of the last second. Only visible while EditViewState::m_showCpuUsage
+// is set.
+class CpuUsageComponent
+    : public juce::Component
+    , private MeterHub::Client
+    , private juce::ValueTree::Listener
+{
+public:
+    CpuUsageComponent(EditViewState &evs, te::Track::Ptr track, te::Plugin::Ptr plugin = nullptr);
+    ~CpuUsageComponent() override;
+
+    void paint(juce::Graphics &g) override;
+
+private:
+    bool meterTick() override;
+    void valueTreePropertyChanged(juce::ValueTree &tree, const juce::Identifier &property) override;
+
+    EditViewState &m_evs;
+    te::Track::Ptr m_track;
+    te::Plugin::Ptr m_plugin;
+    CpuProfiler::Stats m_stats;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CpuUsageComponent)
+};
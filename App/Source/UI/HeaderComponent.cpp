@@ -57,11 +57,12 @@ HeaderComponent::HeaderComponent(EditViewState &evs, ApplicationViewState &appli
     m_clickButton.setTooltip(GUIHelpers::translate("Toggle metronome on/off", m_editViewState.m_applicationState));
     m_followPlayheadButton.setTooltip(GUIHelpers::translate("View follows playhead on/off", m_editViewState.m_applicationState));
 
-    startTimer(30);
+    startMeterUpdates(m_display);
 }
 
 HeaderComponent::~HeaderComponent()
 {
+    stopMeterUpdates();
     m_playButton.removeListener(this);
     m_stopButton.removeListener(this);
     m_recordButton.removeListener(this);
@@ -206,7 +207,12 @@ void HeaderComponent::showFollowMenu()
 
 void HeaderComponent::loopButtonClicked() { GUIHelpers::setDrawableOnButton(m_loopButton, BinaryData::cached_svg, m_edit.getTransport().looping ? m_btn_col : juce::Colour(0xff666666)); }
 
-void HeaderComponent::timerCallback() { m_display.update(); }
+bool HeaderComponent::meterTick()
+{
+    // the labels only repaint if their text changed
+    m_display.update();
+    return false;
+}
 
 juce::File HeaderComponent::getSelectedFile() const { return m_loadingFile; }
 
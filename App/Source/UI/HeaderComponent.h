@@ -26,6 +26,7 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 #include "UI/PositionDisplayComponent.h"
 #include "Utilities/ApplicationViewState.h"
 #include "Utilities/EditViewState.h"
+#include "Utilities/MeterHub.h"
 #include "Utilities/Utilities.h"
 
 namespace te = tracktion_engine;
@@ -33,8 +34,8 @@ namespace te = tracktion_engine;
 class HeaderComponent
     : public juce::Component
     , public juce::Button::Listener
-    , public juce::Timer
     , public juce::ChangeBroadcaster
+    , private MeterHub::Client
 {
 public:
     HeaderComponent(EditViewState &, ApplicationViewState &applicationState, juce::ApplicationCommandManager &commandManager);
@@ -45,13 +46,13 @@ public:
     void resized() override;
     void buttonClicked(juce::Button *button) override;
     void mouseDown(const juce::MouseEvent &e) override;
-    void timerCallback() override;
 
     juce::File getSelectedFile() const;
 
     void loopButtonClicked();
 
 private:
+    bool meterTick() override;
     void showFollowMenu();
     EditViewState &m_editViewState;
     static juce::FlexBox createFlexBox(juce::FlexBox::JustifyContent justify);
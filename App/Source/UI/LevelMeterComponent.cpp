@@ -27,7 +27,7 @@ LevelMeterComponent::LevelMeterComponent(te::LevelMeasurer &lm, ChannelType chan
 {
     setOpaque(true);
     attachToLevelMeasurer(&lm);
-    startTimerHz(30);
+    startMeterUpdates(*this);
 }
 
 LevelMeterComponent::LevelMeterComponent(std::function<te::LevelMeasurer *()> levelMeasurerProvider, ChannelType channelType)
@@ -36,12 +36,12 @@ LevelMeterComponent::LevelMeterComponent(std::function<te::LevelMeasurer *()> le
 {
     setOpaque(true);
     refreshLevelMeasurerSource();
-    startTimerHz(30);
+    startMeterUpdates(*this);
 }
 
 LevelMeterComponent::~LevelMeterComponent()
 {
-    stopTimer();
+    stopMeterUpdates();
     attachToLevelMeasurer(nullptr);
 }
 
@@ -133,7 +133,7 @@ void LevelMeterComponent::paint(juce::Graphics &g)
     }
 }
 
-void LevelMeterComponent::timerCallback()
+bool LevelMeterComponent::meterTick()
 {
     refreshLevelMeasurerSource();
 
@@ -169,8 +169,5 @@ void LevelMeterComponent::timerCallback()
     }
 
     // the test below may save some unnecessary paints
-    if (m_currentLeveldBLeft != m_prevLeveldBLeft || m_currentLeveldBRight != prevLevelRight)
-    {
-        repaint();
-    }
+    return m_currentLeveldBLeft != m_prevLeveldBLeft || m_currentLeveldBRight != m_prevLeveldBRight;
 }
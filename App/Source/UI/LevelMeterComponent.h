@@ -23,13 +23,14 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 #pragma once
 
 #include "../JuceLibraryCode/JuceHeader.h"
+#include "Utilities/MeterHub.h"
 #include <functional>
 
 namespace te = tracktion_engine;
 
 class LevelMeterComponent
     : public juce::Component
-    , public juce::Timer
+    , private MeterHub::Client
 {
 public:
     enum class ChannelType
@@ -46,7 +47,7 @@ public:
     void paint(juce::Graphics &g) override;
 
 private:
-    void timerCallback() override;
+    bool meterTick() override;
     void refreshLevelMeasurerSource();
     void attachToLevelMeasurer(te::LevelMeasurer *nextLevelMeasurer);
 
@@ -0,0 +1,86 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#include "UI/LoudnessMeterComponent.h"
+#include "Utilities/ApplicationViewState.h"
+#include "Utilities/Utilities.h"
+
+LoudnessMeterComponent::LoudnessMeterComponent(std::shared_ptr<LoudnessMeter> meter, ApplicationViewState &avs)
+    : m_meter(std::move(meter)),
+      m_avs(avs)
+{
+    setTooltip(GUIHelpers::translate("Loudness (EBU R128). Click to reset the integrated measurement.", m_avs));
+    startMeterUpdates(*this);
+}
+
+LoudnessMeterComponent::~LoudnessMeterComponent() { stopMeterUpdates(); }
+
+void LoudnessMeterComponent::paint(juce::Graphics &g)
+{
+    g.fillAll(juce::Colours::black);
+
+    const std::pair<const char *, juce::String> rows[] = {
+        {"M", format(m_values.momentary)},
+        {"S", format(m_values.shortTerm)},
+        {"I", format(m_values.integrated)},
+        {"LRA", format(m_values.range, true)},
+        {"TP", format(m_values.truePeak)},
+    };
+
+    auto area = getLocalBounds().reduced(2, 1);
+    auto rowHeight = area.getHeight() / (int) std::size(rows);
+    g.setFont(juce::FontOptions((float) juce::jlimit(8, 11, rowHeight - 1)));
+
+    for (auto &[label, value] : rows)
+    {
+        auto row = area.removeFromTop(rowHeight);
+
+        g.setColour(m_avs.getTextColour().withAlpha(0.6f));
+        g.drawText(label, row, juce::Justification::centredLeft, false);
+
+        // true peak above -1 dBTP is the usual delivery limit
+        auto isHot = juce::String(label) == "TP" && m_values.truePeak > -1.0f;
+        g.setColour(isHot ? juce::Colours::red : m_avs.getTextColour());
+        g.drawText(value, row, juce::Justification::centredRight, false);
+    }
+}
+
+void LoudnessMeterComponent::mouseDown(const juce::MouseEvent &) { m_meter->requestReset(); }
+
+bool LoudnessMeterComponent::meterTick()
+{
+    auto values = m_meter->getValues();
+
+    auto changed = [](float a, float b) { return std::abs(a - b) >= 0.05f; };
+    if (!changed(values.momentary, m_values.momentary) && !changed(values.shortTerm, m_values.shortTerm) && !changed(values.integrated, m_values.integrated) && !changed(values.range, m_values.range) && !changed(values.truePeak, m_values.truePeak))
+        return false;
+
+    m_values = values;
+    return true;
+}
+
+juce::String LoudnessMeterComponent::format(float value, bool isRange)
+{
+    if (!isRange && value <= LoudnessMeter::silence)
+        return "-inf";
+
+    return juce::String(value, 1);
+}
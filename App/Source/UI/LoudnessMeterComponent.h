@@ -0,0 +1,53 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "Utilities/LoudnessMeter.h"
+#include "Utilities/MeterHub.h"
+
+class ApplicationViewState;
+
+// Shows momentary, short-term and integrated loudness, loudness range and true
+// peak of a LoudnessMeter. A click starts a new integrated measurement.
+class LoudnessMeterComponent
+    : public juce::Component
+    , public juce::SettableTooltipClient
+    , private MeterHub::Client
+{
+public:
+    LoudnessMeterComponent(std::shared_ptr<LoudnessMeter> meter, ApplicationViewState &avs);
+    ~LoudnessMeterComponent() override;
+
+    void paint(juce::Graphics &g) override;
+    void mouseDown(const juce::MouseEvent &e) override;
+
+private:
+    bool meterTick() override;
+    static juce::String format(float value, bool isRange = false);
+
+    std::shared_ptr<LoudnessMeter> m_meter;
+    ApplicationViewState &m_avs;
+    LoudnessMeter::Values m_values;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoudnessMeterComponent)
+};
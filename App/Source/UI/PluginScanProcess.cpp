@@ -0,0 +1,302 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#include "UI/PluginScanProcess.h"
+
+namespace
+{
+juce::MemoryBlock createScanRequest(const juce::String &formatName, const juce::String &fileOrIdentifier)
+{
+    juce::MemoryBlock block;
+    juce::MemoryOutputStream stream(block, false);
+    stream.writeString(formatName);
+    stream.writeString(fileOrIdentifier);
+    stream.flush();
+    return block;
+}
+} // namespace
+
+//==============================================================================
+PluginScanWorker::PluginScanWorker() { m_formatManager.addDefaultFormats(); }
+
+PluginScanWorker::~PluginScanWorker() { cancelPendingUpdate(); }
+
+bool PluginScanWorker::isWorkerCommandLine(const juce::String &commandLine) { return commandLine.contains(processUID); }
+
+bool PluginScanWorker::initialise(const juce::String &commandLine) { return initialiseFromCommandLine(commandLine, processUID); }
+
+void PluginScanWorker::handleMessageFromCoordinator(const juce::MemoryBlock &message)
+{
+    if (message.isEmpty())
+        return;
+
+    // Lots of plugins expect to be created on the message thread
+    {
+        const std::lock_guard<std::mutex> lock(m_lock);
+        m_pendingRequests.push(message);
+    }
+
+    triggerAsyncUpdate();
+}
+
+void PluginScanWorker::handleConnectionLost() { juce::JUCEApplicationBase::quit(); }
+
+void PluginScanWorker::handleAsyncUpdate()
+{
+    for (;;)
+    {
+        juce::MemoryBlock message;
+
+        {
+            const std::lock_guard<std::mutex> lock(m_lock);
+
+            if (m_pendingRequests.empty())
+                return;
+
+            message = std::move(m_pendingRequests.front());
+            m_pendingRequests.pop();
+        }
+
+        scan(message);
+    }
+}
+
+void PluginScanWorker::scan(const juce::MemoryBlock &message)
+{
+    juce::MemoryInputStream stream(message, false);
+    const auto formatName = stream.readString();
+    const auto fileOrIdentifier = stream.readString();
+
+    juce::XmlElement xml("LIST");
+    juce::AudioPluginFormat *format = nullptr;
+
+    for (auto *f : m_formatManager.getFormats())
+        if (f->getName() == formatName)
+            format = f;
+
+    if (format != nullptr)
+    {
+        juce::OwnedArray<juce::PluginDescription> results;
+        format->findAllTypesForFile(results, fileOrIdentifier);
+
+        for (auto *desc : results)
+            xml.addChildElement(desc->createXml().release());
+    }
+    else
+    {
+        xml.setAttribute("unknownFormat", true);
+    }
+
+    const auto text = xml.toString();
+    sendMessageToCoordinator({text.toRawUTF8(), text.getNumBytesAsUTF8()});
+}
+
+//==============================================================================
+class PluginScanProcessPool::WorkerProcess : private juce::ChildProcessCoordinator
+{
+public:
+    WorkerProcess() { m_launched = launchWorkerProcess(juce::File::getSpecialLocation(juce::File::currentExecutableFile), PluginScanWorker::processUID, 0, 0); }
+
+    ~WorkerProcess() override { killWorkerProcess(); }
+
+    bool isRunning() const { return m_launched && !m_connectionLost; }
+
+    bool send(const juce::MemoryBlock &message)
+    {
+        const std::lock_guard<std::mutex> lock(m_lock);
+        m_response.reset();
+        m_gotResponse = false;
+        return sendMessageToWorker(message);
+    }
+
+    enum class State
+    {
+        waiting,
+        gotResponse,
+        connectionLost
+    };
+
+    State waitForResponse(int timeoutMs, std::unique_ptr<juce::XmlElement> &response)
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+
+        if (!m_condition.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return m_gotResponse || m_connectionLost; }))
+            return State::waiting;
+
+        if (m_gotResponse)
+        {
+            m_gotResponse = false;
+            response = std::move(m_response);
+            return State::gotResponse;
+        }
+
+        return State::connectionLost;
+    }
+
+private:
+    void handleMessageFromWorker(const juce::MemoryBlock &message) override
+    {
+        const std::lock_guard<std::mutex> lock(m_lock);
+        m_response = juce::parseXML(message.toString());
+        m_gotResponse = true;
+        m_condition.notify_one();
+    }
+
+    void handleConnectionLost() override
+    {
+        const std::lock_guard<std::mutex> lock(m_lock);
+        m_connectionLost = true;
+        m_condition.notify_one();
+    }
+
+    std::mutex m_lock;
+    std::condition_variable m_condition;
+    std::unique_ptr<juce::XmlElement> m_response;
+    bool m_launched = false, m_gotResponse = false, m_connectionLost = false;
+};
+
+//==============================================================================
+PluginScanProcessPool::PluginScanProcessPool(std::shared_ptr<PluginScanCache> cache)
+    : m_cache(std::move(cache))
+{
+}
+
+PluginScanProcessPool::~PluginScanProcessPool() { scanFinished(); }
+
+bool PluginScanProcessPool::findPluginTypesFor(juce::AudioPluginFormat &format, juce::OwnedArray<juce::PluginDescription> &result, const juce::String &fileOrIdentifier)
+{
+    bool failed = false;
+    if (m_cache != nullptr && m_cache->lookup(format.getName(), fileOrIdentifier, result, failed))
+        return !failed;
+
+    if (m_workerLaunchFailed)
+        return false;
+
+    auto worker = acquireWorker();
+
+    if (worker == nullptr)
+    {
+        // not cached, the file wasn't probed at all
+        m_workerLaunchFailed = true;
+        return false;
+    }
+
+    auto scanResult = scanInWorker(*worker, format, result, fileOrIdentifier);
+
+    // a worker that timed out may still be stuck in the plugin, drop it
+    if (scanResult != ScanResult::failed && worker->isRunning())
+        releaseWorker(std::move(worker));
+
+    if (scanResult == ScanResult::unknownFormat)
+    {
+        // formats the worker doesn't know, e.g. the ones tracktion adds itself
+        format.findAllTypesForFile(result, fileOrIdentifier);
+        return true;
+    }
+
+    if (shouldExit())
+        return true;
+
+    if (m_cache != nullptr)
+        m_cache->store(format.getName(), fileOrIdentifier, result, scanResult == ScanResult::failed);
+
+    return scanResult == ScanResult::found;
+}
+
+void PluginScanProcessPool::scanFinished()
+{
+    {
+        const std::lock_guard<std::mutex> lock(m_workerLock);
+        m_idleWorkers.clear();
+    }
+
+    if (m_cache != nullptr)
+        m_cache->save();
+}
+
+std::unique_ptr<PluginScanProcessPool::WorkerProcess> PluginScanProcessPool::acquireWorker()
+{
+    {
+        const std::lock_guard<std::mutex> lock(m_workerLock);
+
+        if (!m_idleWorkers.empty())
+        {
+            auto worker = std::move(m_idleWorkers.back());
+            m_idleWorkers.pop_back();
+            return worker;
+        }
+    }
+
+    auto worker = std::make_unique<WorkerProcess>();
+    if (!worker->isRunning())
+    {
+        juce::Logger::writeToLog("PluginScanProcessPool: couldn't launch scan worker");
+        return nullptr;
+    }
+
+    return worker;
+}
+
+void PluginScanProcessPool::releaseWorker(std::unique_ptr<WorkerProcess> worker)
+{
+    const std::lock_guard<std::mutex> lock(m_workerLock);
+    m_idleWorkers.push_back(std::move(worker));
+}
+
+PluginScanProcessPool::ScanResult PluginScanProcessPool::scanInWorker(WorkerProcess &worker, juce::AudioPluginFormat &format, juce::OwnedArray<juce::PluginDescription> &result, const juce::String &fileOrIdentifier)
+{
+    if (!worker.send(createScanRequest(format.getName(), fileOrIdentifier)))
+        return ScanResult::failed;
+
+    const auto startTime = juce::Time::getMillisecondCounter();
+
+    for (;;)
+    {
+        std::unique_ptr<juce::XmlElement> response;
+        auto state = worker.waitForResponse(50, response);
+
+        if (state == WorkerProcess::State::connectionLost)
+            return ScanResult::failed;
+
+        if (state == WorkerProcess::State::waiting)
+        {
+            if (shouldExit() || juce::Time::getMillisecondCounter() - startTime > (juce::uint32) maxProbeTimeMs)
+                return ScanResult::failed;
+
+            continue;
+        }
+
+        if (response == nullptr)
+            return ScanResult::failed;
+
+        if (response->getBoolAttribute("unknownFormat"))
+            return ScanResult::unknownFormat;
+
+        for (auto *e : response->getChildIterator())
+        {
+            auto desc = std::make_unique<juce::PluginDescription>();
+            if (desc->loadFromXml(*e))
+                result.add(desc.release());
+        }
+
+        return ScanResult::found;
+    }
+}
@@ -0,0 +1,101 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "Utilities/PluginScanCache.h"
+#include <mutex>
+#include <queue>
+
+// Runs inside a child process of NextStudio. It receives the format name and
+// the file or identifier to probe, and answers with the found plugin types
+// as XML. If a plugin crashes while being probed, only this process dies.
+class PluginScanWorker
+    : private juce::ChildProcessWorker
+    , private juce::AsyncUpdater
+{
+public:
+    PluginScanWorker();
+    ~PluginScanWorker() override;
+
+    static bool isWorkerCommandLine(const juce::String &commandLine);
+
+    // Returns false if this process wasn't started as a scan worker.
+    bool initialise(const juce::String &commandLine);
+
+    static constexpr const char *processUID = "nextstudiopluginscanworker";
+
+private:
+    void handleMessageFromCoordinator(const juce::MemoryBlock &message) override;
+    void handleConnectionLost() override;
+    void handleAsyncUpdate() override;
+    void scan(const juce::MemoryBlock &message);
+
+    juce::AudioPluginFormatManager m_formatManager;
+    std::queue<juce::MemoryBlock> m_pendingRequests;
+    std::mutex m_lock;
+
+    JUCE_DECLARE_NON_COPYABLE(PluginScanWorker)
+};
+
+// The KnownPluginList scanner used by PluginScanner. Every scan thread gets
+// its own worker process, so plugins are probed in parallel and a crashing
+// plugin only ends up on the blacklist. Workers are kept for the next file
+// until the scan finished. Results are stored in the PluginScanCache, files
+// which didn't change since the last probe aren't probed again.
+class PluginScanProcessPool : public juce::KnownPluginList::CustomScanner
+{
+public:
+    explicit PluginScanProcessPool(std::shared_ptr<PluginScanCache> cache);
+    ~PluginScanProcessPool() override;
+
+    bool findPluginTypesFor(juce::AudioPluginFormat &format, juce::OwnedArray<juce::PluginDescription> &result, const juce::String &fileOrIdentifier) override;
+    void scanFinished() override;
+
+    // True once a worker process couldn't be started. The remaining files
+    // are reported as failed instead of being probed inside the app.
+    [[nodiscard]] bool didWorkerLaunchFail() const { return m_workerLaunchFailed; }
+
+private:
+    class WorkerProcess;
+
+    enum class ScanResult
+    {
+        found,
+        failed,
+        unknownFormat
+    };
+
+    std::unique_ptr<WorkerProcess> acquireWorker();
+    void releaseWorker(std::unique_ptr<WorkerProcess> worker);
+    ScanResult scanInWorker(WorkerProcess &worker, juce::AudioPluginFormat &format, juce::OwnedArray<juce::PluginDescription> &result, const juce::String &fileOrIdentifier);
+
+    // a plugin that takes longer than this to load is treated as hanging
+    static constexpr int maxProbeTimeMs = 60000;
+
+    std::shared_ptr<PluginScanCache> m_cache;
+    std::vector<std::unique_ptr<WorkerProcess>> m_idleWorkers;
+    std::mutex m_workerLock;
+    std::atomic<bool> m_workerLaunchFailed{false};
+
+    JUCE_DECLARE_NON_COPYABLE(PluginScanProcessPool)
+};
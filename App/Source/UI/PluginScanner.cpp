@@ -20,6 +20,7 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 */
 
 #include "UI/PluginScanner.h"
+#include "UI/PluginScanProcess.h"
 
 PluginScanner::PluginScanner(tracktion::Engine &en, juce::AudioPluginFormat &format, const juce::StringArray &filesOrIdentifiers, juce::PropertiesFile *properties, bool allowPluginsWhichRequireAsynchronousInstantiation, int threads, const juce::String &title, const juce::String &text)
     : m_engine(en),
@@ -70,8 +71,14 @@ PluginScanner::~PluginScanner()
         m_threadPool->removeAllJobs(true, 60000);
         m_threadPool.reset();
     }
+
+    // later scans and plugin loads must not go through our worker pool
+    if (m_scanProcessPool != nullptr)
+        m_engine.getPluginManager().knownPluginList.setCustomScanner(nullptr);
 }
 
+bool PluginScanner::didWorkerLaunchFail() const { return m_scanProcessPool != nullptr && m_scanProcessPool->didWorkerLaunchFail(); }
+
 juce::FileSearchPath PluginScanner::getLastSearchPath(juce::PropertiesFile &properties, juce::AudioPluginFormat &format)
 {
     auto key = "lastPluginScanPath_" + format.getName();
@@ -158,6 +165,13 @@ void PluginScanner::startScan()
 {
     m_pathChooserWindow.setVisible(false);
 
+    // Plugins are probed in worker processes, one per scan thread, so a
+    // crashing plugin can't take the app down with it.
+    m_scanCache = std::make_shared<PluginScanCache>(PluginScanCache::getDefaultFile(m_engine));
+    auto scanProcessPool = std::make_unique<PluginScanProcessPool>(m_scanCache);
+    m_scanProcessPool = scanProcessPool.get();
+    m_engine.getPluginManager().knownPluginList.setCustomScanner(std::move(scanProcessPool));
+
     m_dirScanner.reset(new juce::PluginDirectoryScanner(m_engine.getPluginManager().knownPluginList, m_formatToScan, m_pathList.getPath(), true, m_engine.getTemporaryFileManager().getTempFile("PluginScanDeadMansPedal"), m_allowAsync));
 
     if (!m_filesOrIdentifiersToScan.isEmpty())
@@ -186,7 +200,13 @@ void PluginScanner::startScan()
     startTimer(20);
 }
 
-void PluginScanner::finishedScan() { sendChangeMessage(); }
+void PluginScanner::finishedScan()
+{
+    if (m_scanCache != nullptr)
+        m_scanCache->save();
+
+    sendChangeMessage();
+}
 
 void PluginScanner::timerCallback()
 {
@@ -25,8 +25,11 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 
 #pragma once
 
+#include "Utilities/PluginScanCache.h"
 #include "Utilities/Utilities.h"
 
+class PluginScanProcessPool;
+
 class PluginScanner
     : private juce::Timer
     , public juce::ChangeBroadcaster
@@ -40,6 +43,8 @@ public:
 
     void setLastSearchPath(juce::PropertiesFile &properties, juce::AudioPluginFormat &format, const juce::FileSearchPath &newPath);
 
+    [[nodiscard]] bool didWorkerLaunchFail() const;
+
     std::set<juce::String> m_initiallyBlacklistedFiles;
     std::unique_ptr<juce::PluginDirectoryScanner> m_dirScanner;
 
@@ -83,6 +88,8 @@ private:
     bool m_allowAsync, m_timerReentrancyCheck = false;
     std::atomic<bool> m_finished{false};
     std::unique_ptr<juce::ThreadPool> m_threadPool;
+    std::shared_ptr<PluginScanCache> m_scanCache;
+    PluginScanProcessPool *m_scanProcessPool = nullptr; // owned by the KnownPluginList while scanning
     juce::ScopedMessageBox m_messageBox;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginScanner)
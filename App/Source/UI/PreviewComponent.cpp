@@ -22,12 +22,14 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 
 #include "UI/PreviewComponent.h"
 #include "BinaryData.h"
+#include "Utilities/AudioLibraryIndex.h"
 #include "Utilities/Utilities.h"
 
 SamplePreviewComponent::SamplePreviewComponent(te::Engine &engine, te::Edit &edit, ApplicationViewState &avs)
     : m_engine(engine),
       m_edit(edit),
       m_avs(avs),
+      m_player(engine),
       m_playBtn("Play/Pause", juce::DrawableButton::ButtonStyle::ImageOnButtonBackground),
       m_stopBtn("Stop", juce::DrawableButton::ButtonStyle::ImageOnButtonBackground),
       m_syncTempoBtn("Sync Tempo", juce::DrawableButton::ButtonStyle::ImageOnButtonBackground),
@@ -35,7 +37,6 @@ SamplePreviewComponent::SamplePreviewComponent(te::Engine &engine, te::Edit &edi
 {
     m_avs.m_applicationStateValueTree.addListener(this);
 
-    m_isSync = std::make_unique<bool>(true);
     m_volumeSlider = std::make_unique<juce::Slider>();
     m_volumeSlider->setRange(.0f, 1.0f);
     m_volumeSlider->getValueObject().referTo(m_avs.m_previewSliderPos.getPropertyAsValue());
@@ -62,11 +63,10 @@ SamplePreviewComponent::SamplePreviewComponent(te::Engine &engine, te::Edit &edi
     m_syncTempoBtn.setTooltip(GUIHelpers::translate("Sync to song tempo", m_avs));
     m_stopBtn.onClick = [this]
     {
-        if (!m_previewEdit)
+        if (!m_thumbnail)
             return;
 
-        auto isPlaying = m_previewEdit->getTransport().isPlaying();
-        if (isPlaying)
+        if (m_player.isPlaying())
         {
             stop();
         }
@@ -76,11 +76,10 @@ SamplePreviewComponent::SamplePreviewComponent(te::Engine &engine, te::Edit &edi
     };
     m_playBtn.onClick = [this]
     {
-        if (!m_previewEdit)
+        if (!m_thumbnail)
             return;
 
-        auto isPlaying = m_previewEdit->getTransport().isPlaying();
-        if (!isPlaying)
+        if (!m_player.isPlaying())
         {
             play();
         }
@@ -118,7 +117,7 @@ void SamplePreviewComponent::paint(juce::Graphics &g)
     g.drawHorizontalLine(m_fileName.getBottom(), 0, getWidth());
     g.drawHorizontalLine(m_fileName.getBottom() + 90 + 1, 0, getWidth());
     g.drawHorizontalLine(m_playBtn.getBottom() + 3, 0, getWidth());
-    if (m_previewEdit)
+    if (m_thumbnail)
     {
         g.setColour(m_avs.getSamplesColour().withAlpha(0.1f));
         g.fillRect(m_thumbnail->getBounds());
@@ -140,7 +139,7 @@ void SamplePreviewComponent::resized()
     auto thumbnailHeight = 90;
     auto thumbRect = area.removeFromTop(thumbnailHeight);
     thumbRect.reduce(4, 4);
-    if (m_previewEdit)
+    if (m_thumbnail)
         m_thumbnail->setBounds(thumbRect);
 
     // Remaining area for buttons
@@ -177,42 +176,24 @@ void SamplePreviewComponent::resized()
 void SamplePreviewComponent::sliderValueChanged(juce::Slider *slider)
 {
     if (slider == m_volumeSlider.get())
-    {
-        auto &sliderpos = m_avs.m_previewSliderPos;
-        if (m_previewEdit)
-            m_previewEdit->getMasterSliderPosParameter()->setParameter(sliderpos, juce::dontSendNotification);
-    }
+        m_player.setGain(te::volumeFaderPositionToGain(static_cast<float>(m_avs.m_previewSliderPos)));
 }
 
 void SamplePreviewComponent::timerCallback()
 {
-    if (m_previewEdit)
+    // the player stops and rewinds by itself at the end of the file
+    if (!m_player.isPlaying())
     {
-        auto &t = m_previewEdit->getTransport();
-        if (t.getPosition().inSeconds() > m_previewEdit->getLength().inSeconds())
-        {
-            t.stop(false, true);
-            rewind();
-            resized();
-            stopTimer();
-        }
-        else
-        {
-            startTimer(200);
-        }
+        stopTimer();
+        resized();
     }
 }
 
 void SamplePreviewComponent::play()
 {
-    if (m_previewEdit)
+    if (m_thumbnail)
     {
-        auto &ptp = m_previewEdit->getTransport();
-        m_previewEdit->dispatchPendingUpdatesSynchronously();
-        ptp.ensureContextAllocated();
-
-        auto sampleLenght = m_previewEdit->getLength().inSeconds() + 0.5;
-        ptp.play(false);
+        m_player.play();
         startTimer(200);
         updateButtonColours();
     }
@@ -220,21 +201,11 @@ void SamplePreviewComponent::play()
 
 void SamplePreviewComponent::stop()
 {
-    if (m_previewEdit)
-    {
-        m_previewEdit->getTransport().stop(false, true);
-        stopTimer();
-    }
+    m_player.stop();
+    stopTimer();
 }
 
-void SamplePreviewComponent::rewind()
-{
-    if (m_previewEdit)
-    {
-        auto &ptp = m_previewEdit->getTransport();
-        ptp.setPosition(tracktion::TimePosition::fromSeconds(0.0));
-    }
-}
+void SamplePreviewComponent::rewind() { m_player.setPosition(0.0); }
 
 bool SamplePreviewComponent::setFile(const juce::File &file)
 {
@@ -252,35 +223,50 @@ bool SamplePreviewComponent::setFile(const juce::File &file)
     m_lenghtLabel.setFont(10);
     m_lenghtLabel.setJustificationType(juce::Justification::centredRight);
 
+    // the tempo comes from the file's loop info or from the library index,
+    // which also knows tempos written in file names
+    auto sourceBpm = audioFile.getInfo().loopInfo.getBpm(audioFile.getInfo());
+    if (sourceBpm <= 0.0)
+    {
+        AudioLibraryIndex::Entry entry;
+        if (AudioLibraryIndex::getInstance()->getEntry(file, entry))
+            sourceBpm = entry.bpm;
+    }
+
+    m_isSync = sourceBpm > 0.0;
+    auto targetBpm = m_syncTempo ? m_edit.tempoSequence.getTempoAt(tracktion::TimePosition()).getBpm() : 0.0;
+
+    if (!m_player.load(file, sourceBpm, targetBpm, EngineHelpers::getPreferredTimeStretchMode(m_avs, m_engine)))
+        return false;
+
     m_file = file;
     m_fileName.setText(m_file.getFileName(), juce::sendNotification);
-    m_previewEdit = te::Edit::createEditForPreviewingFile(m_engine, file, &m_edit, m_syncTempo, false, m_isSync.get(), juce::ValueTree());
-
-    auto &sliderpos = m_avs.m_previewSliderPos;
-    if (m_previewEdit)
-        m_previewEdit->getMasterSliderPosParameter()->setParameter(sliderpos, juce::dontSendNotification);
-    // is needed because, preview edit don't play the attacs of a sample if started. idky
-    te::insertSpaceIntoEdit(*m_previewEdit, {tracktion::TimePosition::fromSeconds(0.0), tracktion::TimeDuration::fromSeconds(0.05)});
-    m_previewEdit->getTransport().setLoopRange({tracktion::TimePosition::fromSeconds(0.05), tracktion::TimeDuration::fromSeconds(lenght)});
+    m_player.setGain(te::volumeFaderPositionToGain(static_cast<float>(m_avs.m_previewSliderPos)));
     updateEngineLooping();
 
-    auto colour = *m_isSync ? m_avs.getPrimeColour() : m_avs.getTextColour();
+    auto colour = m_isSync ? m_avs.getPrimeColour() : m_avs.getTextColour();
     m_fileName.setColour(juce::Label::textColourId, colour);
 
-    m_thumbnail = std::make_unique<SampleDisplay>(m_previewEdit->getTransport(), m_avs);
+    if (!m_thumbnail)
+    {
+        m_thumbnail = std::make_unique<SampleDisplay>(m_engine, m_avs);
+        m_thumbnail->getPlayPosition = [this] { return m_player.getPosition(); };
+        m_thumbnail->onSeek = [this](double time) { m_player.setPosition(time); };
+        addAndMakeVisible(*m_thumbnail);
+    }
+
     m_thumbnail->setFile(audioFile);
     m_thumbnail->setColour(m_avs.getSamplesColour());
-    addAndMakeVisible(*m_thumbnail);
     resized();
 
     return true;
 }
 void SamplePreviewComponent::updateButtonColours()
 {
-    if (m_previewEdit)
+    if (m_thumbnail)
     {
-        auto sync = *m_isSync && m_syncTempo;
-        auto isPlaying = m_previewEdit->getTransport().isPlaying();
+        auto sync = m_isSync && m_syncTempo;
+        auto isPlaying = m_player.isPlaying();
         auto playBtnColour = isPlaying ? juce::Colour(0xff959595) : juce::Colour(0xff474747);
         auto stopBtnColour = isPlaying ? juce::Colour(0xff959515) : juce::Colour(0xff474747);
         auto syncBtnColour = sync ? juce::Colour(0xff959515) : juce::Colour(0xff474747);
@@ -308,6 +294,5 @@ void SamplePreviewComponent::handleAsyncUpdate()
 }
 void SamplePreviewComponent::updateEngineLooping()
 {
-    if (m_previewEdit)
-        m_previewEdit->getTransport().looping = static_cast<bool>(m_avs.m_previewLoop);
+    m_player.setLooping(static_cast<bool>(m_avs.m_previewLoop));
 }
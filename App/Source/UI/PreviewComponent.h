@@ -25,6 +25,7 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "UI/SampleDisplay.h"
 #include "Utilities/ApplicationViewState.h"
+#include "Utilities/SamplePreviewPlayer.h"
 #include "Utilities/Utilities.h"
 
 class SamplePreviewComponent
@@ -58,13 +59,13 @@ private:
     te::Engine &m_engine;
     te::Edit &m_edit;
     ApplicationViewState &m_avs;
-    std::unique_ptr<te::Edit> m_previewEdit;
+    SamplePreviewPlayer m_player;
     std::unique_ptr<juce::Slider> m_volumeSlider;
     juce::DrawableButton m_playBtn, m_stopBtn, m_loopBtn, m_syncTempoBtn;
     juce::Label m_fileName, m_lenghtLabel, m_volumeLabel;
     std::unique_ptr<SampleDisplay> m_thumbnail;
     bool m_syncTempo{false};
-    std::unique_ptr<bool> m_isSync;
+    bool m_isSync{false};
     juce::File m_file;
     float m_volume;
     bool m_updateLooping{false};
@@ -158,9 +158,19 @@ double MarkerComponent::timeFromPosition(const juce::Point<float> &position) con
 //==============================================================================
 
 SampleDisplay::SampleDisplay(te::TransportControl &tc, ApplicationViewState &appViewState)
+    : SampleDisplay(tc.edit.engine, &tc, appViewState)
+{
+}
+
+SampleDisplay::SampleDisplay(te::Engine &engine, ApplicationViewState &appViewState)
+    : SampleDisplay(engine, nullptr, appViewState)
+{
+}
+
+SampleDisplay::SampleDisplay(te::Engine &engine, te::TransportControl *tc, ApplicationViewState &appViewState)
     : transport(tc),
       m_appViewState(appViewState),
-      m_sampleView(tc.edit),
+      m_sampleView(engine),
       m_startMarker(MarkerComponent::Start, appViewState.getPrimeColour()),
       m_endMarker(MarkerComponent::End, appViewState.getPrimeColour())
 {
@@ -236,8 +246,17 @@ void SampleDisplay::setFile(const tracktion_engine::AudioFile &file)
 void SampleDisplay::setColour(juce::Colour colour) { m_sampleView.setColour(colour); }
 void SampleDisplay::updateCursorPosition()
 {
-    const double loopLength = transport.getLoopRange().getLength().inSeconds();
-    const double proportion = loopLength == 0.0 ? 0.0 : transport.getPosition().inSeconds() / loopLength;
+    double proportion = 0.0;
+
+    if (transport != nullptr)
+    {
+        const double loopLength = transport->getLoopRange().getLength().inSeconds();
+        proportion = loopLength == 0.0 ? 0.0 : transport->getPosition().inSeconds() / loopLength;
+    }
+    else if (getPlayPosition && m_totalLength > 0.0)
+    {
+        proportion = getPlayPosition() / m_totalLength;
+    }
 
     auto r = getLocalBounds().toFloat();
     const float x = r.getWidth() * float(proportion);
@@ -252,7 +271,9 @@ void SampleDisplay::mouseDown(const juce::MouseEvent &e)
         return;
 
     // Otherwise handle transport control as before
-    transport.setUserDragging(true);
+    if (transport != nullptr)
+        transport->setUserDragging(true);
+
     mouseDrag(e);
 }
 
@@ -261,11 +282,19 @@ void SampleDisplay::mouseDrag(const juce::MouseEvent &e)
     // Marker components handle their own dragging
     // Just handle transport control as before
     jassert(getWidth() > 0);
-    const float proportion = (float)e.position.x / (float)getWidth();
-    transport.position = tracktion::TimePosition::fromSeconds(transport.getLoopRange().getLength().inSeconds() * proportion);
+    const float proportion = juce::jlimit(0.0f, 1.0f, (float)e.position.x / (float)getWidth());
+
+    if (transport != nullptr)
+        transport->position = tracktion::TimePosition::fromSeconds(transport->getLoopRange().getLength().inSeconds() * proportion);
+    else if (onSeek)
+        onSeek(m_totalLength * proportion);
 }
 
-void SampleDisplay::mouseUp(const juce::MouseEvent &) { transport.setUserDragging(false); }
+void SampleDisplay::mouseUp(const juce::MouseEvent &)
+{
+    if (transport != nullptr)
+        transport->setUserDragging(false);
+}
 
 // New methods for start/end markers
 void SampleDisplay::setStartEndPositions(double start, double end)
@@ -337,10 +366,10 @@ double SampleDisplay::positionToTime(const juce::Point<float> &position) const
     return proportion * m_totalLength;
 }
 
-SampleView::SampleView(te::Edit &edit)
-    : m_edit(edit),
-      m_audioFile(edit.engine, {}),
-      m_smartThumbnail(m_edit.engine, te::AudioFile(m_edit.engine), *this, nullptr)
+SampleView::SampleView(te::Engine &engine)
+    : m_engine(engine),
+      m_audioFile(engine, {}),
+      m_smartThumbnail(m_engine, te::AudioFile(m_engine), *this, nullptr)
 {
     setInterceptsMouseClicks(false, false);
 }
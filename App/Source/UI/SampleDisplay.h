@@ -27,7 +27,7 @@ namespace te = tracktion_engine;
 
 struct SampleView : public juce::Component
 {
-    explicit SampleView(te::Edit &edit);
+    explicit SampleView(te::Engine &engine);
 
     void setFile(const te::AudioFile &file);
     void setColour(juce::Colour colour) { m_colour = colour; }
@@ -36,7 +36,7 @@ struct SampleView : public juce::Component
     te::SmartThumbnail &getSmartThumbnail() { return m_smartThumbnail; }
 
 private:
-    te::Edit &m_edit;
+    te::Engine &m_engine;
     te::AudioFile m_audioFile;
     juce::Colour m_colour;
     te::SmartThumbnail m_smartThumbnail;
@@ -94,6 +94,11 @@ public:
 
     SampleDisplay(te::TransportControl &tc, ApplicationViewState &appViewState);
 
+    // For files that aren't played by an edit, e.g. the browser preview. The
+    // cursor follows getPlayPosition and clicks and drags call onSeek, both
+    // in seconds.
+    SampleDisplay(te::Engine &engine, ApplicationViewState &appViewState);
+
     void resized() override;
 
     void mouseDown(const juce::MouseEvent &e) override;
@@ -110,8 +115,13 @@ public:
     // Callback for marker position changes
     std::function<void(double start, double end)> onMarkerPositionChanged;
 
+    std::function<double()> getPlayPosition;
+    std::function<void(double time)> onSeek;
+
 private:
-    te::TransportControl &transport;
+    SampleDisplay(te::Engine &engine, te::TransportControl *tc, ApplicationViewState &appViewState);
+
+    te::TransportControl *transport;
     ApplicationViewState &m_appViewState;
     juce::DrawableRectangle cursor;
     MarkerComponent m_startMarker;
@@ -142,6 +142,17 @@ SetupWizard::SetupWizard(ApplicationViewState &avs, tracktion::Engine &engine)
     m_guiScaleSlider.setValue(juce::jlimit(0.2f, 3.0f, (float)m_avs.m_appScale.get()), juce::dontSendNotification);
     m_guiScaleSlider.onValueChange = [this]() { updateGuiScale(); };
 
+    addAndMakeVisible(m_languageLabel);
+    m_languageLabel.setText("Language:", juce::dontSendNotification);
+    m_languageLabel.setJustificationType(juce::Justification::centredLeft);
+
+    addAndMakeVisible(m_languageBox);
+    const auto languages = ApplicationViewState::getAvailableLanguages();
+    m_languageBox.addItem("System default", 1);
+    m_languageBox.addItemList(languages, 2);
+    m_languageBox.setSelectedItemIndex(languages.indexOf(m_avs.m_language.get()) + 1, juce::dontSendNotification);
+    m_languageBox.onChange = [this]() { updateLanguage(); };
+
     // Audio Group
     addAndMakeVisible(m_audioGroup);
     m_audioGroup.setText("Audio Device Settings");
@@ -188,6 +199,12 @@ void SetupWizard::updateGuiScale()
     m_avs.m_appScale = guiScale;
 }
 
+void SetupWizard::updateLanguage()
+{
+    const auto index = m_languageBox.getSelectedItemIndex();
+    m_avs.setLanguage(index > 0 ? m_languageBox.getItemText(index) : juce::String());
+}
+
 void SetupWizard::paint(juce::Graphics &g)
 {
     g.fillAll(m_avs.getBackgroundColour1());
@@ -227,12 +244,17 @@ void SetupWizard::resized()
 
     leftColumn.removeFromTop(sectionSpacing);
 
-    auto interfaceArea = leftColumn.removeFromTop(90);
+    auto interfaceArea = leftColumn.removeFromTop(130);
     m_interfaceGroup.setBounds(interfaceArea);
     auto interfaceContent = interfaceArea.reduced(10, 20);
     interfaceContent.removeFromTop(10);
-    m_guiScaleLabel.setBounds(interfaceContent.removeFromLeft(120));
-    m_guiScaleSlider.setBounds(interfaceContent);
+    auto scaleRow = interfaceContent.removeFromTop(30);
+    m_guiScaleLabel.setBounds(scaleRow.removeFromLeft(120));
+    m_guiScaleSlider.setBounds(scaleRow);
+    interfaceContent.removeFromTop(10);
+    auto languageRow = interfaceContent.removeFromTop(30);
+    m_languageLabel.setBounds(languageRow.removeFromLeft(120));
+    m_languageBox.setBounds(languageRow);
 
     // Right column: audio settings.
     m_audioGroup.setBounds(rightColumn);
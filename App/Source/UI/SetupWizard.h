@@ -23,6 +23,7 @@ private:
     void showValidationError(const juce::String &message) const;
     void updatePathLabel();
     void updateGuiScale();
+    void updateLanguage();
 
     ApplicationViewState &m_avs;
     tracktion::Engine &m_engine;
@@ -42,6 +43,8 @@ private:
     juce::GroupComponent m_interfaceGroup;
     juce::Label m_guiScaleLabel;
     juce::Slider m_guiScaleSlider;
+    juce::Label m_languageLabel;
+    juce::ComboBox m_languageBox;
 
     // Audio setup
     juce::GroupComponent m_audioGroup;
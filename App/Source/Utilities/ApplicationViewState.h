@@ -23,6 +23,8 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 #pragma once
 
 #include "../JuceLibraryCode/JuceHeader.h"
+#include "Utilities/IconCache.h"
+#include "Utilities/TranslationCache.h"
 #include "juce_graphics/juce_graphics.h"
 
 namespace IDs
@@ -81,6 +83,10 @@ DECLARE_ID(SidebarCollapsed)
 DECLARE_ID(ExclusiveMidiFocusEnabled)
 DECLARE_ID(TimeStretchMode)
 DECLARE_ID(SetupComplete)
+DECLARE_ID(BinaryPresets)
+DECLARE_ID(RecentPlugins)
+DECLARE_ID(AutomationReduceTolerance)
+DECLARE_ID(Language)
 #undef DECLARE_ID
 } // namespace IDs
 
@@ -112,13 +118,19 @@ struct Favorite
 class ApplicationViewState
 {
 public:
-    ApplicationViewState()
-
+    // A non persistent state starts from the defaults and never touches
+    // AppSettings.xml, so background processes can't overwrite the user's settings.
+    explicit ApplicationViewState(bool persistent = true)
+        : m_isPersistent(persistent)
     {
-        auto settingsFile = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("NextStudio/AppSettings.xml");
-        settingsFile.create();
-        juce::XmlDocument xmlDoc(settingsFile);
-        auto xmlToRead = xmlDoc.getDocumentElement();
+        std::unique_ptr<juce::XmlElement> xmlToRead;
+        if (m_isPersistent)
+        {
+            auto settingsFile = getSettingsFile();
+            settingsFile.create();
+            juce::XmlDocument xmlDoc(settingsFile);
+            xmlToRead = xmlDoc.getDocumentElement();
+        }
         if (xmlToRead)
         {
             m_applicationStateValueTree = juce::ValueTree::fromXml(*xmlToRead);
@@ -188,6 +200,10 @@ public:
         m_exclusiveMidiFocusEnabled.referTo(behavior, IDs::ExclusiveMidiFocusEnabled, nullptr, true);
         m_timeStretchMode.referTo(behavior, IDs::TimeStretchMode, nullptr, juce::String());
         m_setupComplete.referTo(behavior, IDs::SetupComplete, nullptr, false);
+        m_binaryPresets.referTo(behavior, IDs::BinaryPresets, nullptr, false);
+        m_recentPlugins.referTo(behavior, IDs::RecentPlugins, nullptr, juce::String());
+        m_automationReduceTolerance.referTo(behavior, IDs::AutomationReduceTolerance, nullptr, 0.005f);
+        m_language.referTo(behavior, IDs::Language, nullptr, juce::String());
 
         themeState.setProperty(IDs::PrimeColour, juce::var(m_primeColour), nullptr);
         themeState.setProperty(IDs::BorderColour, juce::var(m_borderColour), nullptr);
@@ -252,6 +268,8 @@ public:
             m_trackHeaderBackgroundColour.forceUpdateOfCachedValue();
             m_trackHeaderTextColour.forceUpdateOfCachedValue();
         }
+
+        IconCache::getInstance()->clear();
     }
 
     void addFavoriteType(const juce::Identifier &type)
@@ -274,12 +292,12 @@ public:
         return result;
     }
 
+    static juce::File getLanguageDirectory() { return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("NextStudio/language"); }
+
     juce::File getFileToTranslation()
     {
-        juce::String systemLanguage = juce::SystemStats::getUserLanguage();
-        juce::String fileName = "NextStudio/language/translations_" + systemLanguage + ".lang";
-
-        juce::File languageFile(juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile(fileName));
+        juce::String language = m_language.get().isEmpty() ? juce::SystemStats::getUserLanguage() : m_language.get();
+        juce::File languageFile(getLanguageDirectory().getChildFile("translations_" + language + ".lang"));
 
         if (languageFile.existsAsFile())
             return languageFile;
@@ -287,6 +305,41 @@ public:
         return {};
     }
 
+    // Codes of the installed language files, e.g. "de-DE".
+    static juce::StringArray getAvailableLanguages()
+    {
+        juce::StringArray languages;
+
+        for (const auto &file : getLanguageDirectory().findChildFiles(juce::File::findFiles, false, "translations_*.lang"))
+            languages.add(file.getFileNameWithoutExtension().fromFirstOccurrenceOf("translations_", false, false));
+
+        languages.sort(true);
+        return languages;
+    }
+
+    // An empty language follows the system language.
+    void setLanguage(const juce::String &language)
+    {
+        if (m_language.get() == language)
+            return;
+
+        m_language = language;
+
+        // the system language is resolved again on the next lookup
+        if (language.isEmpty())
+            m_translationCache.invalidate();
+        else
+            reloadTranslations();
+    }
+
+    juce::String translate(const juce::String &text)
+    {
+        return m_translationCache.translate(text, [this] { return getFileToTranslation(); });
+    }
+
+    // Call after the language file or the user language changed.
+    void reloadTranslations() { m_translationCache.reload(getFileToTranslation()); }
+
     void setBounds(juce::Rectangle<int> bounds)
     {
         m_windowXpos = bounds.getX();
@@ -305,8 +358,13 @@ public:
         m_projectsDir = newRoot.getChildFile("Projects").getFullPathName();
     }
 
+    static juce::File getSettingsFile() { return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("NextStudio/AppSettings.xml"); }
+
     void saveState()
     {
+        if (!m_isPersistent)
+            return;
+
         auto favoritesState = m_applicationStateValueTree.getOrCreateChildWithName(IDs::Favorites, nullptr);
         favoritesState.removeAllChildren(nullptr);
         for (auto favEntry : m_favorites)
@@ -316,7 +374,7 @@ public:
 
         auto fileBrowser = m_applicationStateValueTree.getOrCreateChildWithName(IDs::FileBrowser, nullptr);
 
-        auto settingsFile = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("NextStudio/AppSettings.xml");
+        auto settingsFile = getSettingsFile();
         settingsFile.create();
         auto xmlToWrite = m_applicationStateValueTree.createXml();
         if (xmlToWrite->writeTo(settingsFile))
@@ -404,10 +462,12 @@ public:
     juce::OwnedArray<Favorite> m_favorites;
     juce::Array<juce::Colour> m_trackColours{juce::Colour(0xff1dd13d), juce::Colour(0xff008CDC), juce::Colour(0xffFFAD00), juce::Colour(0xffFF3E5A), juce::Colour(0xffC766FF), juce::Colour(0xff356800), juce::Colour(0xff054D77), juce::Colour(0xff9A6C0B), juce::Colour(0xff862835), juce::Colour(0xff5A1582), juce::Colour(0xffFFF800), juce::Colour(0xff84E185), juce::Colour(0xffEC610F), juce::Colour(0xffD6438A), juce::Colour(0xff0053FF), juce::Colour(0xffD3CF4F), juce::Colour(0xff5D937F), juce::Colour(0xffA27956), juce::Colour(0xffAA7A99), juce::Colour(0xff3A5BA1)};
 
-    juce::CachedValue<juce::String> m_workDir, m_presetDir, m_clipsDir, m_samplesDir, m_renderDir, m_projectsDir, m_guiBackground1, m_mainFrameColour, m_primeColour, m_borderColour, m_buttonBackgroundColour, m_buttonTextColour, m_textColour, m_timeLine_strokeColour, m_timeLine_background, m_timeLine_shadowShade, m_timeLine_textColour, m_trackBackgroundColour, m_trackHeaderBackgroundColour, m_trackHeaderTextColour, m_guiBackground2, m_guiBackground3, m_timeStretchMode;
+    juce::CachedValue<juce::String> m_workDir, m_presetDir, m_clipsDir, m_samplesDir, m_renderDir, m_projectsDir, m_guiBackground1, m_mainFrameColour, m_primeColour, m_borderColour, m_buttonBackgroundColour, m_buttonTextColour, m_textColour, m_timeLine_strokeColour, m_timeLine_background, m_timeLine_shadowShade, m_timeLine_textColour, m_trackBackgroundColour, m_trackHeaderBackgroundColour, m_trackHeaderTextColour, m_guiBackground2, m_guiBackground3, m_timeStretchMode, m_recentPlugins, m_language;
     juce::CachedValue<int> m_windowXpos, m_windowYpos, m_windowWidth, m_windowHeight, m_folderTrackIndent, m_autoSaveInterval, m_sidebarWidth;
-    juce::CachedValue<float> m_appScale, m_mouseCursorScale, m_previewSliderPos;
-    juce::CachedValue<bool> m_previewLoop, m_sidebarCollapsed, m_exclusiveMidiFocusEnabled, m_setupComplete;
+    juce::CachedValue<float> m_appScale, m_mouseCursorScale, m_previewSliderPos, m_automationReduceTolerance;
+    juce::CachedValue<bool> m_previewLoop, m_sidebarCollapsed, m_exclusiveMidiFocusEnabled, m_setupComplete, m_binaryPresets;
     const int m_minSidebarWidth{250};
+    const bool m_isPersistent;
+    TranslationCache m_translationCache;
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ApplicationViewState)
 };
@@ -0,0 +1,597 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#include "Utilities/AudioLibraryIndex.h"
+#include "Utilities/Utilities.h"
+#include <unordered_set>
+
+JUCE_IMPLEMENT_SINGLETON(AudioLibraryIndex)
+
+namespace
+{
+bool isKeyToken(const juce::String &token)
+{
+    // "Am", "C#", "Bbmin", "F#maj"... a single letter is too ambiguous
+    auto lower = token.toLowerCase();
+    if (lower.length() < 2 || !juce::String("abcdefg").containsChar(lower[0]))
+        return false;
+
+    auto rest = lower.substring(1);
+    if (rest.startsWithChar('#') || rest.startsWithChar('b'))
+        rest = rest.substring(1);
+    else if (rest.isEmpty())
+        return false;
+
+    return rest.isEmpty() || rest == "m" || rest == "min" || rest == "minor" || rest == "maj" || rest == "major";
+}
+
+juce::String normaliseKey(const juce::String &token)
+{
+    auto lower = token.toLowerCase();
+    auto key = lower.substring(0, 1).toUpperCase();
+    auto rest = lower.substring(1);
+
+    if (rest.startsWithChar('#') || rest.startsWithChar('b'))
+    {
+        key << rest.substring(0, 1);
+        rest = rest.substring(1);
+    }
+
+    if (rest.startsWith("m") && !rest.startsWith("maj"))
+        key << "m";
+
+    return key;
+}
+} // namespace
+
+AudioLibraryIndex::AudioLibraryIndex()
+    : juce::Thread("Audio Library Indexer")
+{
+    m_formatManager.registerBasicFormats();
+}
+
+AudioLibraryIndex::~AudioLibraryIndex()
+{
+    m_headPool.removeAllJobs(true, 2000);
+    stopThread(10000);
+    clearSingletonInstance();
+}
+
+void AudioLibraryIndex::setRoots(const juce::Array<juce::File> &roots)
+{
+    {
+        const juce::ScopedLock sl(m_lock);
+        if (roots == m_roots && isThreadRunning())
+            return;
+
+        m_roots = roots;
+    }
+
+    if (!isThreadRunning())
+        startThread(juce::Thread::Priority::low);
+    else
+        notify();
+}
+
+void AudioLibraryIndex::rescan() { notify(); }
+
+juce::Array<juce::File> AudioLibraryIndex::getFiles(const juce::File &root) const
+{
+    const juce::ScopedLock sl(m_lock);
+
+    juce::Array<juce::File> files;
+
+    if (auto it = m_filesByDirectory.find(root.getFullPathName()); it != m_filesByDirectory.end())
+        for (auto &f : it->second)
+            files.add(f);
+
+    // the paths below root form one contiguous range of the ordered map
+    const auto prefix = root.getFullPathName() + juce::File::getSeparatorString();
+
+    for (auto it = m_filesByDirectory.lower_bound(prefix); it != m_filesByDirectory.end() && it->first.startsWith(prefix); ++it)
+        for (auto &f : it->second)
+            files.add(f);
+
+    return files;
+}
+
+juce::uint64 AudioLibraryIndex::getGeneration(const juce::File &root) const
+{
+    const juce::ScopedLock sl(m_lock);
+
+    auto it = m_subtreeGenerations.find(root.getFullPathName());
+    return it != m_subtreeGenerations.end() ? it->second : 0;
+}
+
+void AudioLibraryIndex::addToDirectory(const juce::File &file) { m_filesByDirectory[file.getParentDirectory().getFullPathName()].insert(file); }
+
+void AudioLibraryIndex::removeFromDirectory(const juce::File &file)
+{
+    auto it = m_filesByDirectory.find(file.getParentDirectory().getFullPathName());
+    if (it == m_filesByDirectory.end())
+        return;
+
+    it->second.erase(file);
+    if (it->second.empty())
+        m_filesByDirectory.erase(it);
+}
+
+void AudioLibraryIndex::markChanged(const juce::File &directory)
+{
+    ++m_generation;
+
+    for (auto dir = directory;; dir = dir.getParentDirectory())
+    {
+        m_subtreeGenerations[dir.getFullPathName()] = m_generation;
+
+        if (dir.isRoot() || dir == dir.getParentDirectory())
+            break;
+    }
+}
+
+bool AudioLibraryIndex::getEntry(const juce::File &file, Entry &result) const
+{
+    const juce::ScopedLock sl(m_lock);
+
+    auto it = m_entries.find(file.getFullPathName());
+    if (it == m_entries.end())
+        return false;
+
+    result = it->second;
+    return true;
+}
+
+bool AudioLibraryIndex::matches(const juce::File &file, const juce::String &query) const
+{
+    juce::StringArray words;
+    words.addTokens(query.toLowerCase(), " ", "");
+    words.removeEmptyStrings();
+
+    if (words.isEmpty())
+        return true;
+
+    {
+        const juce::ScopedLock sl(m_lock);
+
+        auto it = m_entries.find(file.getFullPathName());
+        if (it != m_entries.end())
+            return matches(it->second, words);
+    }
+
+    // not indexed yet, only the name is known
+    auto name = file.getFileNameWithoutExtension().toLowerCase();
+    for (auto &w : words)
+        if (!name.contains(w))
+            return false;
+
+    return true;
+}
+
+bool AudioLibraryIndex::matches(const Entry &entry, const juce::StringArray &words)
+{
+    auto key = entry.key.toLowerCase();
+    auto bpm = entry.bpm > 0.0 ? juce::String(juce::roundToInt(entry.bpm)) + "bpm" : juce::String();
+
+    for (auto &w : words)
+        if (!entry.lowerName.contains(w) && key != w && !(bpm.isNotEmpty() && bpm.startsWith(w)))
+            return false;
+
+    return true;
+}
+
+void AudioLibraryIndex::sortFiles(juce::Array<juce::File> &files, SortOrder order, bool forward) const
+{
+    struct Item
+    {
+        juce::File file;
+        double value;
+    };
+
+    std::vector<Item> items;
+    items.reserve((size_t) files.size());
+
+    {
+        const juce::ScopedLock sl(m_lock);
+
+        for (auto &f : files)
+        {
+            double value = 0.0;
+            auto it = m_entries.find(f.getFullPathName());
+            if (it != m_entries.end())
+                value = order == SortOrder::length ? it->second.lengthInSeconds : it->second.bpm;
+
+            items.push_back({f, value});
+        }
+    }
+
+    std::stable_sort(items.begin(), items.end(),
+                     [order, forward](const Item &a, const Item &b)
+                     {
+                         if (order == SortOrder::name || a.value == b.value)
+                         {
+                             auto r = a.file.getFileName().compareNatural(b.file.getFileName());
+                             return forward ? r < 0 : r > 0;
+                         }
+
+                         return forward ? a.value < b.value : a.value > b.value;
+                     });
+
+    files.clearQuick();
+    for (auto &item : items)
+        files.add(item.file);
+}
+
+std::shared_ptr<const juce::AudioBuffer<float>> AudioLibraryIndex::getHead(const juce::File &file)
+{
+    auto key = getHeadKey(file);
+    if (auto head = findHead(key))
+        return head;
+
+    auto head = readHead(file);
+    if (head != nullptr)
+        storeHead(key, head);
+
+    return head;
+}
+
+void AudioLibraryIndex::prefetchHeads(const juce::Array<juce::File> &files)
+{
+    // only the latest request matters while the user moves through a list
+    m_headPool.removeAllJobs(false, 0);
+
+    for (auto &file : files)
+    {
+        if (file == juce::File())
+            continue;
+
+        m_headPool.addJob(
+            [this, file]
+            {
+                auto key = getHeadKey(file);
+                if (findHead(key) != nullptr)
+                    return;
+
+                if (auto head = readHead(file))
+                    storeHead(key, head);
+            });
+    }
+}
+
+std::shared_ptr<const juce::AudioBuffer<float>> AudioLibraryIndex::readHead(const juce::File &file)
+{
+    std::unique_ptr<juce::AudioFormatReader> reader(m_formatManager.createReaderFor(file));
+    if (reader == nullptr || reader->sampleRate <= 0.0 || reader->numChannels == 0)
+        return {};
+
+    auto numSamples = (int) juce::jmin(reader->lengthInSamples, (juce::int64) (reader->sampleRate * headLengthMs / 1000.0));
+    auto head = std::make_shared<juce::AudioBuffer<float>>((int) juce::jmin(2u, reader->numChannels), numSamples);
+    reader->read(head.get(), 0, numSamples, 0, true, true);
+
+    return head;
+}
+
+std::shared_ptr<const juce::AudioBuffer<float>> AudioLibraryIndex::findHead(const juce::String &key)
+{
+    const juce::ScopedLock sl(m_headLock);
+
+    auto it = m_heads.find(key);
+    if (it == m_heads.end())
+        return {};
+
+    m_headOrder.removeString(key);
+    m_headOrder.add(key);
+    return it->second;
+}
+
+void AudioLibraryIndex::storeHead(const juce::String &key, std::shared_ptr<const juce::AudioBuffer<float>> head)
+{
+    const juce::ScopedLock sl(m_headLock);
+
+    m_heads[key] = std::move(head);
+    m_headOrder.removeString(key);
+    m_headOrder.add(key);
+
+    while (m_headOrder.size() > maxCachedHeads)
+    {
+        m_heads.erase(m_headOrder[0]);
+        m_headOrder.remove(0);
+    }
+}
+
+juce::String AudioLibraryIndex::getHeadKey(const juce::File &file)
+{
+    // a file that was overwritten gets a new key, so no stale audio is played
+    return file.getFullPathName() + "|" + juce::String(file.getLastModificationTime().toMilliseconds());
+}
+
+void AudioLibraryIndex::run()
+{
+    load();
+    m_lastSaveTime = juce::Time::getMillisecondCounter();
+    sendChangeMessage();
+
+    while (!threadShouldExit())
+    {
+        juce::Array<juce::File> roots;
+        {
+            const juce::ScopedLock sl(m_lock);
+            roots = m_roots;
+        }
+
+        m_isScanning = true;
+
+        bool changed = false;
+        for (auto &root : roots)
+            if (root.isDirectory())
+                changed = crawl(root) || changed;
+
+        m_isScanning = false;
+
+        if (changed && !threadShouldExit())
+        {
+            m_needsSaving = true;
+            saveIfDue();
+            sendChangeMessage();
+        }
+
+        wait(rescanIntervalMs);
+    }
+
+    // whatever the last passes found but didn't write yet
+    if (m_needsSaving)
+        save();
+}
+
+bool AudioLibraryIndex::crawl(const juce::File &root)
+{
+    std::unordered_set<juce::String> seen;
+    bool changed = false;
+    auto lastNotifyTime = juce::Time::getMillisecondCounter();
+
+    for (const auto &entry : juce::RangedDirectoryIterator(root, true, getWildcard(), juce::File::findFiles))
+    {
+        if (threadShouldExit())
+            return changed;
+
+        auto file = entry.getFile();
+        auto path = file.getFullPathName();
+        auto size = entry.getFileSize();
+        auto modified = entry.getModificationTime().toMilliseconds();
+
+        seen.insert(path);
+
+        {
+            const juce::ScopedLock sl(m_lock);
+
+            auto it = m_entries.find(path);
+            if (it != m_entries.end() && it->second.size == size && it->second.modified == modified)
+                continue;
+        }
+
+        auto analysed = analyse(file, size, modified);
+
+        {
+            const juce::ScopedLock sl(m_lock);
+            m_entries[path] = std::move(analysed);
+            addToDirectory(file);
+            markChanged(file.getParentDirectory());
+        }
+
+        changed = true;
+        m_needsSaving = true;
+
+        // let the browsers show what's there so far, but don't flood them
+        if (juce::Time::getMillisecondCounter() - lastNotifyTime > (juce::uint32) notifyIntervalMs)
+        {
+            lastNotifyTime = juce::Time::getMillisecondCounter();
+            sendChangeMessage();
+        }
+
+        // a long first crawl shouldn't be lost if the app quits halfway
+        saveIfDue();
+    }
+
+    // forget about files that were deleted or moved away
+    const juce::ScopedLock sl(m_lock);
+
+    for (auto it = m_entries.begin(); it != m_entries.end();)
+    {
+        if (it->second.file.isAChildOf(root) && seen.count(it->first) == 0)
+        {
+            removeFromDirectory(it->second.file);
+            markChanged(it->second.file.getParentDirectory());
+            it = m_entries.erase(it);
+            changed = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return changed;
+}
+
+AudioLibraryIndex::Entry AudioLibraryIndex::analyse(const juce::File &file, juce::int64 size, juce::int64 modified)
+{
+    Entry entry;
+    entry.file = file;
+    entry.size = size;
+    entry.modified = modified;
+    entry.lowerName = file.getFileNameWithoutExtension().toLowerCase();
+
+    readTempoAndKeyFromName(entry);
+
+    // unreadable files stay in the index too, so they aren't opened again
+    std::unique_ptr<juce::AudioFormatReader> reader(m_formatManager.createReaderFor(file));
+    if (reader == nullptr || reader->sampleRate <= 0.0)
+        return entry;
+
+    entry.sampleRate = reader->sampleRate;
+    entry.numChannels = (int) reader->numChannels;
+    entry.lengthInSeconds = (double) reader->lengthInSamples / reader->sampleRate;
+
+    if (auto tempo = reader->metadataValues.getValue(juce::WavAudioFormat::acidTempo, {}).getDoubleValue(); tempo > 0.0)
+        entry.bpm = tempo;
+
+    // long files are only analysed at the start, that's enough to judge levels
+    const auto numToAnalyse = juce::jmin(reader->lengthInSamples, (juce::int64) (maxAnalysisSeconds * reader->sampleRate));
+    const int blockSize = 8192;
+
+    juce::AudioBuffer<float> buffer(entry.numChannels, blockSize);
+    double sumOfSquares = 0.0;
+    float peak = 0.0f;
+
+    for (juce::int64 pos = 0; pos < numToAnalyse && !threadShouldExit(); pos += blockSize)
+    {
+        auto numSamples = (int) juce::jmin((juce::int64) blockSize, numToAnalyse - pos);
+        reader->read(&buffer, 0, numSamples, pos, true, true);
+
+        for (int ch = 0; ch < entry.numChannels; ++ch)
+        {
+            auto *data = buffer.getReadPointer(ch);
+            for (int i = 0; i < numSamples; ++i)
+            {
+                peak = juce::jmax(peak, std::abs(data[i]));
+                sumOfSquares += (double) data[i] * data[i];
+            }
+        }
+    }
+
+    entry.peak = peak;
+
+    if (numToAnalyse > 0 && entry.numChannels > 0)
+        entry.rms = (float) std::sqrt(sumOfSquares / ((double) numToAnalyse * entry.numChannels));
+
+    return entry;
+}
+
+void AudioLibraryIndex::readTempoAndKeyFromName(Entry &entry)
+{
+    // sample packs usually name loops like "Bass_Loop_124bpm_F#m.wav"
+    juce::StringArray tokens;
+    tokens.addTokens(entry.file.getFileNameWithoutExtension(), " _-.()[]", "");
+    tokens.removeEmptyStrings();
+
+    for (int i = 0; i < tokens.size(); ++i)
+    {
+        auto lower = tokens[i].toLowerCase();
+
+        if (entry.bpm <= 0.0)
+        {
+            if (lower.endsWith("bpm") && lower.dropLastCharacters(3).containsOnly("0123456789."))
+                entry.bpm = lower.dropLastCharacters(3).getDoubleValue();
+            else if (lower == "bpm" && i > 0 && tokens[i - 1].containsOnly("0123456789."))
+                entry.bpm = tokens[i - 1].getDoubleValue();
+        }
+
+        if (entry.key.isEmpty() && isKeyToken(tokens[i]))
+            entry.key = normaliseKey(tokens[i]);
+    }
+}
+
+juce::File AudioLibraryIndex::getIndexFile() { return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("NextStudio/AudioLibraryIndex.bin"); }
+
+void AudioLibraryIndex::load()
+{
+    juce::FileInputStream in(getIndexFile());
+    if (!in.openedOk())
+        return;
+
+    juce::GZIPDecompressorInputStream gzip(in);
+    auto state = juce::ValueTree::readFromStream(gzip);
+
+    const juce::ScopedLock sl(m_lock);
+
+    std::set<juce::String> directories;
+
+    for (const auto &v : state)
+    {
+        Entry entry;
+        entry.file = juce::File(v.getProperty("path").toString());
+        entry.size = v.getProperty("size");
+        entry.modified = v.getProperty("modified");
+        entry.lengthInSeconds = v.getProperty("length");
+        entry.sampleRate = v.getProperty("sampleRate");
+        entry.numChannels = v.getProperty("channels");
+        entry.peak = v.getProperty("peak");
+        entry.rms = v.getProperty("rms");
+        entry.bpm = v.getProperty("bpm");
+        entry.key = v.getProperty("key").toString();
+        entry.lowerName = entry.file.getFileNameWithoutExtension().toLowerCase();
+
+        addToDirectory(entry.file);
+        directories.insert(entry.file.getParentDirectory().getFullPathName());
+        m_entries[entry.file.getFullPathName()] = std::move(entry);
+    }
+
+    for (auto &dir : directories)
+        markChanged(juce::File(dir));
+}
+
+void AudioLibraryIndex::saveIfDue()
+{
+    // the whole index is rewritten, so changes are collected for a while
+    if (m_needsSaving && juce::Time::getMillisecondCounter() - m_lastSaveTime >= (juce::uint32) saveIntervalMs)
+        save();
+}
+
+void AudioLibraryIndex::save()
+{
+    m_needsSaving = false;
+    m_lastSaveTime = juce::Time::getMillisecondCounter();
+
+    juce::ValueTree state("AUDIOLIBRARY");
+
+    {
+        const juce::ScopedLock sl(m_lock);
+
+        for (auto &[path, entry] : m_entries)
+        {
+            juce::ValueTree v("FILE");
+            v.setProperty("path", path, nullptr);
+            v.setProperty("size", entry.size, nullptr);
+            v.setProperty("modified", entry.modified, nullptr);
+            v.setProperty("length", entry.lengthInSeconds, nullptr);
+            v.setProperty("sampleRate", entry.sampleRate, nullptr);
+            v.setProperty("channels", entry.numChannels, nullptr);
+            v.setProperty("peak", entry.peak, nullptr);
+            v.setProperty("rms", entry.rms, nullptr);
+            v.setProperty("bpm", entry.bpm, nullptr);
+            v.setProperty("key", entry.key, nullptr);
+            state.appendChild(v, nullptr);
+        }
+    }
+
+    juce::TemporaryFile temp(getIndexFile());
+
+    {
+        juce::FileOutputStream out(temp.getFile());
+        if (!out.openedOk())
+            return;
+
+        juce::GZIPCompressorOutputStream gzip(out);
+        state.writeToStream(gzip);
+    }
+
+    if (!temp.overwriteTargetFileWithTemporary())
+        juce::Logger::writeToLog("AudioLibraryIndex: couldn't write " + getIndexFile().getFullPathName());
+}
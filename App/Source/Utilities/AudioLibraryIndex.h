@@ -0,0 +1,143 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <map>
+#include <set>
+#include <unordered_map>
+
+// Process wide index of the audio files below the sample roots. A background
+// thread crawls the roots, reads format details and level statistics of new
+// or changed files and keeps everything in memory and in a compressed file
+// next to the app settings, so the browsers never have to walk the disk on
+// the message thread. The roots are crawled again every minute to pick up
+// added, changed or removed files; a change message is sent whenever the
+// index changed. Every directory carries the generation of the last change
+// below it, so a browser can tell cheaply whether its own root was affected.
+class AudioLibraryIndex
+    : public juce::ChangeBroadcaster
+    , private juce::Thread
+    , private juce::DeletedAtShutdown
+{
+public:
+    struct Entry
+    {
+        juce::File file;
+        juce::int64 size = 0;
+        juce::int64 modified = 0;
+        double lengthInSeconds = 0.0;
+        double sampleRate = 0.0;
+        int numChannels = 0;
+        float peak = 0.0f; // linear gain over the analysed part
+        float rms = 0.0f;
+        double bpm = 0.0;  // 0 if unknown
+        juce::String key;  // e.g. "Am", empty if unknown
+        juce::String lowerName;
+    };
+
+    enum class SortOrder
+    {
+        name,
+        length,
+        bpm
+    };
+
+    AudioLibraryIndex();
+    ~AudioLibraryIndex() override;
+
+    // Starts crawling if the roots changed.
+    void setRoots(const juce::Array<juce::File> &roots);
+    void rescan();
+    bool isScanning() const { return m_isScanning; }
+
+    // All indexed files below root, sorted by path.
+    juce::Array<juce::File> getFiles(const juce::File &root) const;
+    // Changes whenever a file below root was added, changed or removed.
+    juce::uint64 getGeneration(const juce::File &root) const;
+    bool getEntry(const juce::File &file, Entry &result) const;
+
+    // Every word of the query has to be found in the file name, the key or
+    // the tempo (e.g. "120bpm").
+    bool matches(const juce::File &file, const juce::String &query) const;
+    void sortFiles(juce::Array<juce::File> &files, SortOrder order, bool forward) const;
+
+    // The first headLengthMs of a file, so a preview can start playing before
+    // its streaming reader has buffered anything. getHead() reads the head
+    // right away if it isn't cached, prefetchHeads() reads the heads of files
+    // that are likely to be played next in the background.
+    std::shared_ptr<const juce::AudioBuffer<float>> getHead(const juce::File &file);
+    void prefetchHeads(const juce::Array<juce::File> &files);
+    static constexpr int headLengthMs = 300;
+
+    static const char *getWildcard() { return "*.wav;*.WAV;*.mp3;*.MP3;*.aiff;*.AIFF;*.aif;*.AIF;*.flac;*.FLAC;*.ogg;*.OGG"; }
+
+    JUCE_DECLARE_SINGLETON(AudioLibraryIndex, false)
+
+private:
+    void run() override;
+    bool crawl(const juce::File &root);
+    Entry analyse(const juce::File &file, juce::int64 size, juce::int64 modified);
+    static void readTempoAndKeyFromName(Entry &entry);
+    static bool matches(const Entry &entry, const juce::StringArray &words);
+
+    // these expect m_lock to be held
+    void addToDirectory(const juce::File &file);
+    void removeFromDirectory(const juce::File &file);
+    void markChanged(const juce::File &directory);
+
+    std::shared_ptr<const juce::AudioBuffer<float>> readHead(const juce::File &file);
+    std::shared_ptr<const juce::AudioBuffer<float>> findHead(const juce::String &key);
+    void storeHead(const juce::String &key, std::shared_ptr<const juce::AudioBuffer<float>> head);
+    static juce::String getHeadKey(const juce::File &file);
+
+    void load();
+    void save();
+    void saveIfDue();
+    static juce::File getIndexFile();
+
+    static constexpr int rescanIntervalMs = 60000;
+    static constexpr int saveIntervalMs = 300000;
+    static constexpr double maxAnalysisSeconds = 30.0;
+    static constexpr int notifyIntervalMs = 2000;
+    static constexpr int maxCachedHeads = 32;
+
+    juce::AudioFormatManager m_formatManager;
+    std::unordered_map<juce::String, Entry> m_entries;
+    std::map<juce::String, std::set<juce::File>> m_filesByDirectory;
+    std::unordered_map<juce::String, juce::uint64> m_subtreeGenerations;
+    juce::uint64 m_generation = 0;
+    juce::Array<juce::File> m_roots;
+    juce::CriticalSection m_lock;
+    std::atomic<bool> m_isScanning{false};
+
+    // only touched by the indexer thread
+    bool m_needsSaving = false;
+    juce::uint32 m_lastSaveTime = 0;
+
+    std::unordered_map<juce::String, std::shared_ptr<const juce::AudioBuffer<float>>> m_heads;
+    juce::StringArray m_headOrder; // least recently used first
+    juce::CriticalSection m_headLock;
+    juce::ThreadPool m_headPool{juce::ThreadPool::Options{}.withNumberOfThreads(1).withThreadName("Audio Library Prefetch")};
+
+    JUCE_DECLARE_NON_COPYABLE(AudioLibraryIndex)
+};
@@ -0,0 +1,445 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#include "Utilities/AutoSaveJournal.h"
+#include "Utilities/Utilities.h"
+
+namespace
+{
+constexpr int snapshotMagic = 0x3153534e; // "NSS1"
+constexpr int journalMagic = 0x314a534e;  // "NSJ1"
+} // namespace
+
+// Lives on the autosave thread, all jobs of the journal run one after another
+struct AutoSaveJournal::Worker
+{
+    bool writeSnapshot();
+    bool appendToJournal(const juce::MemoryBlock &records);
+
+    juce::ValueTree shadow;
+    juce::File snapshotFile, journalFile;
+    juce::int64 generation = 0;
+    juce::int64 journalBytes = 0;
+    bool snapshotPending = true;
+    std::atomic<bool> needsResync{false};
+};
+
+bool AutoSaveJournal::Worker::writeSnapshot()
+{
+    snapshotPending = true;
+    ++generation;
+
+    juce::TemporaryFile tempFile(snapshotFile);
+
+    {
+        juce::FileOutputStream out(tempFile.getFile());
+        if (!out.openedOk())
+            return false;
+
+        out.writeInt(snapshotMagic);
+        out.writeInt64(generation);
+
+        {
+            juce::GZIPCompressorOutputStream zipped(out, 6);
+            shadow.writeToStream(zipped);
+        }
+
+        out.flush();
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    if (!tempFile.overwriteTargetFileWithTemporary())
+        return false;
+
+    // the old journal belongs to the previous generation, recovery would
+    // ignore it anyway
+    journalFile.deleteFile();
+    journalBytes = 0;
+    snapshotPending = false;
+
+    return true;
+}
+
+bool AutoSaveJournal::Worker::appendToJournal(const juce::MemoryBlock &records)
+{
+    juce::FileOutputStream out(journalFile);
+    if (!out.openedOk())
+        return false;
+
+    if (out.getPosition() == 0)
+    {
+        out.writeInt(journalMagic);
+        out.writeInt64(generation);
+    }
+
+    out.write(records.getData(), records.getSize());
+    out.flush();
+
+    if (out.getStatus().failed())
+        return false;
+
+    journalBytes = out.getPosition();
+    return true;
+}
+
+//==============================================================================
+AutoSaveJournal::AutoSaveJournal(te::Edit &edit, juce::ThreadPool &pool, const juce::File &snapshotFile)
+    : m_edit(edit),
+      m_pool(pool),
+      m_snapshotFile(snapshotFile),
+      m_worker(std::make_shared<Worker>())
+{
+    m_worker->snapshotFile = snapshotFile;
+    m_worker->journalFile = getJournalFile(snapshotFile);
+    m_worker->generation = juce::Time::currentTimeMillis();
+
+    m_edit.state.addListener(this);
+    scheduleFullSnapshot();
+}
+
+AutoSaveJournal::~AutoSaveJournal() { m_edit.state.removeListener(this); }
+
+juce::File AutoSaveJournal::getJournalFile(const juce::File &snapshotFile) { return snapshotFile.withFileExtension(".nextJournal"); }
+
+void AutoSaveJournal::flush(std::function<void(bool)> onWritten)
+{
+    if (m_worker->needsResync.exchange(false))
+        scheduleFullSnapshot();
+
+    auto records = std::exchange(m_pending, {});
+
+    m_pool.addJob(
+        [worker = m_worker, records = std::move(records), onWritten = std::move(onWritten)]
+        {
+            bool wasSuccessful = true;
+
+            if (records.getSize() > 0)
+            {
+                juce::MemoryInputStream in(records, false);
+
+                if (!replayJournal(worker->shadow, in))
+                {
+                    // the copy is out of step with the edit, start over from a fresh one
+                    GUIHelpers::log("AutoSaveJournal: replay failed, taking a new snapshot");
+                    worker->needsResync = true;
+                    wasSuccessful = false;
+                }
+            }
+
+            if (wasSuccessful)
+            {
+                if (worker->snapshotPending || worker->journalBytes + (juce::int64)records.getSize() > compactionThresholdBytes)
+                    wasSuccessful = worker->writeSnapshot();
+                else if (records.getSize() > 0)
+                    wasSuccessful = worker->appendToJournal(records);
+            }
+
+            if (onWritten)
+                juce::MessageManager::callAsync([onWritten, wasSuccessful] { onWritten(wasSuccessful); });
+        });
+}
+
+void AutoSaveJournal::scheduleFullSnapshot()
+{
+    // the only time the whole state is copied on the message thread
+    m_pending.reset();
+
+    auto copy = m_edit.state.createCopy();
+    rewriteSourcePaths(copy);
+
+    m_pool.addJob(
+        [worker = m_worker, copy]() mutable
+        {
+            worker->shadow = copy;
+            worker->writeSnapshot();
+        });
+}
+
+//==============================================================================
+bool AutoSaveJournal::beginRecord(juce::MemoryOutputStream &record, RecordType type, const juce::ValueTree &node)
+{
+    juce::Array<int> path;
+
+    for (auto n = node; n != m_edit.state; n = n.getParent())
+    {
+        auto parent = n.getParent();
+        if (!parent.isValid())
+            return false;
+
+        path.insert(0, parent.indexOf(n));
+    }
+
+    record.writeByte(static_cast<char>(type));
+    record.writeCompressedInt(path.size());
+
+    for (auto index : path)
+        record.writeCompressedInt(index);
+
+    return true;
+}
+
+void AutoSaveJournal::endRecord(const juce::MemoryOutputStream &record)
+{
+    juce::MemoryOutputStream out(m_pending, true);
+    out.writeInt(static_cast<int>(record.getDataSize()));
+    out.write(record.getData(), record.getDataSize());
+}
+
+void AutoSaveJournal::valueTreePropertyChanged(juce::ValueTree &tree, const juce::Identifier &property)
+{
+    juce::MemoryOutputStream record;
+
+    if (!tree.hasProperty(property))
+    {
+        if (beginRecord(record, propertyRemoved, tree))
+        {
+            record.writeString(property.toString());
+            endRecord(record);
+        }
+
+        return;
+    }
+
+    if (!beginRecord(record, propertySet, tree))
+        return;
+
+    record.writeString(property.toString());
+
+    if (property == te::IDs::source)
+        getSourcePathForSnapshot(tree[property]).writeToStream(record);
+    else
+        tree[property].writeToStream(record);
+
+    endRecord(record);
+}
+
+void AutoSaveJournal::valueTreeChildAdded(juce::ValueTree &parent, juce::ValueTree &child)
+{
+    juce::MemoryOutputStream record;
+
+    if (!beginRecord(record, childAdded, parent))
+        return;
+
+    auto copy = child.createCopy();
+    rewriteSourcePaths(copy);
+
+    record.writeCompressedInt(parent.indexOf(child));
+    copy.writeToStream(record);
+    endRecord(record);
+}
+
+void AutoSaveJournal::valueTreeChildRemoved(juce::ValueTree &parent, juce::ValueTree &, int index)
+{
+    juce::MemoryOutputStream record;
+
+    if (!beginRecord(record, childRemoved, parent))
+        return;
+
+    record.writeCompressedInt(index);
+    endRecord(record);
+}
+
+void AutoSaveJournal::valueTreeChildOrderChanged(juce::ValueTree &parent, int oldIndex, int newIndex)
+{
+    juce::MemoryOutputStream record;
+
+    if (!beginRecord(record, childMoved, parent))
+        return;
+
+    record.writeCompressedInt(oldIndex);
+    record.writeCompressedInt(newIndex);
+    endRecord(record);
+}
+
+void AutoSaveJournal::valueTreeRedirected(juce::ValueTree &) { scheduleFullSnapshot(); }
+
+// Source files are stored relative to the edit file, the snapshot may live
+// somewhere else.
+juce::var AutoSaveJournal::getSourcePathForSnapshot(const juce::var &source) const
+{
+    auto oldRelativePath = source.toString();
+
+    if (oldRelativePath.isEmpty())
+        return source;
+
+    auto absoluteSourceFile = m_edit.filePathResolver(oldRelativePath);
+
+    if (!absoluteSourceFile.existsAsFile())
+    {
+        GUIHelpers::log("WARNING: Source file not found during autosave: " + absoluteSourceFile.getFullPathName());
+        return source;
+    }
+
+    return absoluteSourceFile.getRelativePathFrom(m_snapshotFile.getParentDirectory());
+}
+
+void AutoSaveJournal::rewriteSourcePaths(juce::ValueTree node) const
+{
+    if (node.hasProperty(te::IDs::source))
+        node.setProperty(te::IDs::source, getSourcePathForSnapshot(node[te::IDs::source]), nullptr);
+
+    for (int i = 0; i < node.getNumChildren(); ++i)
+        rewriteSourcePaths(node.getChild(i));
+}
+
+//==============================================================================
+bool AutoSaveJournal::applyRecord(juce::ValueTree &root, juce::InputStream &in)
+{
+    const auto type = static_cast<RecordType>(in.readByte());
+    const auto depth = in.readCompressedInt();
+
+    auto node = root;
+
+    for (int i = 0; i < depth && node.isValid(); ++i)
+        node = node.getChild(in.readCompressedInt());
+
+    if (!node.isValid())
+        return false;
+
+    switch (type)
+    {
+    case propertySet:
+    {
+        juce::Identifier property(in.readString());
+        node.setProperty(property, juce::var::readFromStream(in), nullptr);
+        return true;
+    }
+    case propertyRemoved:
+        node.removeProperty(juce::Identifier(in.readString()), nullptr);
+        return true;
+    case childAdded:
+    {
+        const auto index = in.readCompressedInt();
+        auto child = juce::ValueTree::readFromStream(in);
+
+        if (!child.isValid())
+            return false;
+
+        node.addChild(child, index, nullptr);
+        return true;
+    }
+    case childRemoved:
+    {
+        const auto index = in.readCompressedInt();
+
+        if (!juce::isPositiveAndBelow(index, node.getNumChildren()))
+            return false;
+
+        node.removeChild(index, nullptr);
+        return true;
+    }
+    case childMoved:
+    {
+        const auto oldIndex = in.readCompressedInt();
+        const auto newIndex = in.readCompressedInt();
+
+        if (!juce::isPositiveAndBelow(oldIndex, node.getNumChildren()))
+            return false;
+
+        node.moveChild(oldIndex, newIndex, nullptr);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+bool AutoSaveJournal::replayJournal(juce::ValueTree &root, juce::InputStream &in)
+{
+    while (!in.isExhausted())
+    {
+        const auto size = in.readInt();
+
+        // a crash while appending leaves a cut off record at the end
+        if (size <= 0 || in.getNumBytesRemaining() < size)
+        {
+            GUIHelpers::log("AutoSaveJournal: journal ends with an incomplete record");
+            return true;
+        }
+
+        juce::MemoryBlock block;
+        in.readIntoMemoryBlock(block, size);
+
+        juce::MemoryInputStream record(block, false);
+        if (!applyRecord(root, record))
+            return false;
+    }
+
+    return true;
+}
+
+bool AutoSaveJournal::recover(const juce::File &snapshotFile)
+{
+    juce::ValueTree state;
+    juce::int64 generation = 0;
+
+    {
+        juce::FileInputStream in(snapshotFile);
+        if (!in.openedOk())
+            return false;
+
+        // an edit file or an autosave of an older version, nothing to do
+        if (in.readInt() != snapshotMagic)
+            return true;
+
+        generation = in.readInt64();
+
+        juce::GZIPDecompressorInputStream unzipped(in);
+        state = juce::ValueTree::readFromStream(unzipped);
+    }
+
+    if (!state.isValid())
+    {
+        juce::Logger::writeToLog("Error: autosave snapshot is damaged: " + snapshotFile.getFullPathName());
+        return false;
+    }
+
+    auto journalFile = getJournalFile(snapshotFile);
+
+    {
+        juce::FileInputStream journal(journalFile);
+
+        if (journal.openedOk() && journal.readInt() == journalMagic && journal.readInt64() == generation)
+            if (!replayJournal(state, journal))
+                juce::Logger::writeToLog("Error: autosave journal could only be replayed in part: " + journalFile.getFullPathName());
+    }
+
+    juce::TemporaryFile tempFile(snapshotFile);
+
+    {
+        juce::FileOutputStream out(tempFile.getFile());
+        if (!out.openedOk())
+            return false;
+
+        state.writeToStream(out);
+        out.flush();
+
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    if (!tempFile.overwriteTargetFileWithTemporary())
+        return false;
+
+    journalFile.deleteFile();
+    return true;
+}
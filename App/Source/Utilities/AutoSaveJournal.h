@@ -0,0 +1,91 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+namespace te = tracktion_engine;
+
+// Incremental autosave of an edit.
+// Every change of the edit state is recorded as a small binary record while
+// it happens. flush() hands the recorded records to a worker thread, which
+// appends them to a journal file next to the snapshot and replays them on a
+// private copy of the state. When the journal gets too big, the worker writes
+// that copy as a compressed snapshot and starts a new journal. The message
+// thread only copies the whole state once, when the journal is created.
+//
+// Snapshot: magic, generation, gzip compressed ValueTree.
+// Journal:  magic, generation of its snapshot, then [size][record] entries.
+class AutoSaveJournal : private juce::ValueTree::Listener
+{
+public:
+    AutoSaveJournal(te::Edit &edit, juce::ThreadPool &pool, const juce::File &snapshotFile);
+    ~AutoSaveJournal() override;
+
+    // onWritten is called on the message thread once the records are on disk
+    void flush(std::function<void(bool wasSuccessful)> onWritten);
+
+    [[nodiscard]] const juce::File &getSnapshotFile() const { return m_snapshotFile; }
+    static juce::File getJournalFile(const juce::File &snapshotFile);
+
+    // Crash recovery: reads the snapshot, replays its journal and writes the
+    // result back as a plain ValueTree that te::loadEditFromFile can open.
+    // Files that are not a journal snapshot are left alone.
+    static bool recover(const juce::File &snapshotFile);
+
+    static constexpr juce::int64 compactionThresholdBytes = 4 * 1024 * 1024;
+
+private:
+    enum RecordType
+    {
+        propertySet = 1,
+        propertyRemoved,
+        childAdded,
+        childRemoved,
+        childMoved
+    };
+
+    struct Worker;
+
+    void valueTreePropertyChanged(juce::ValueTree &tree, const juce::Identifier &property) override;
+    void valueTreeChildAdded(juce::ValueTree &parent, juce::ValueTree &child) override;
+    void valueTreeChildRemoved(juce::ValueTree &parent, juce::ValueTree &child, int index) override;
+    void valueTreeChildOrderChanged(juce::ValueTree &parent, int oldIndex, int newIndex) override;
+    void valueTreeRedirected(juce::ValueTree &) override;
+
+    bool beginRecord(juce::MemoryOutputStream &record, RecordType type, const juce::ValueTree &node);
+    void endRecord(const juce::MemoryOutputStream &record);
+    void scheduleFullSnapshot();
+    juce::var getSourcePathForSnapshot(const juce::var &source) const;
+    void rewriteSourcePaths(juce::ValueTree node) const;
+
+    static bool applyRecord(juce::ValueTree &root, juce::InputStream &in);
+    static bool replayJournal(juce::ValueTree &root, juce::InputStream &in);
+
+    te::Edit &m_edit;
+    juce::ThreadPool &m_pool;
+    juce::File m_snapshotFile;
+    juce::MemoryBlock m_pending;
+    std::shared_ptr<Worker> m_worker;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AutoSaveJournal)
+};
@@ -0,0 +1,309 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#include "Utilities/AutomationReducer.h"
+#include "Utilities/ApplicationViewState.h"
+#include "Utilities/Utilities.h"
+
+namespace
+{
+constexpr int pollIntervalMs = 100;
+
+struct ReducerPoint
+{
+    double time = 0.0;
+    float value = 0.0f;
+    float curve = 0.0f;
+
+    // value of the original curve halfway to the next point, only set for
+    // curved segments
+    float midValue = 0.0f;
+};
+
+float interpolate(const ReducerPoint &a, const ReducerPoint &b, double time)
+{
+    const auto length = b.time - a.time;
+
+    if (length <= 0.0)
+        return b.value;
+
+    return a.value + static_cast<float>((time - a.time) / length) * (b.value - a.value);
+}
+
+// first index at or after t, the points of a curve are sorted by time
+int firstIndexAtOrAfter(const te::AutomationCurve &curve, tracktion::TimePosition t)
+{
+    int low = 0, high = curve.getNumPoints();
+
+    while (low < high)
+    {
+        auto mid = (low + high) / 2;
+
+        if (curve.getPointTime(mid) < t)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+} // namespace
+
+AutomationReducer::AutomationReducer(te::Edit &edit, ApplicationViewState &appState)
+    : m_edit(edit),
+      m_appState(appState)
+{
+    startTimer(pollIntervalMs);
+}
+
+AutomationReducer::~AutomationReducer() { stopTimer(); }
+
+int AutomationReducer::reduce(te::AutomationCurve &curve, tracktion::TimeRange range, float tolerance)
+{
+    const int first = firstIndexAtOrAfter(curve, range.getStart());
+    int last = first;
+
+    while (last + 1 < curve.getNumPoints() && curve.getPointTime(last + 1) <= range.getEnd())
+        ++last;
+
+    const int numPoints = last - first + 1;
+
+    if (numPoints < 3 || tolerance <= 0.0f)
+        return 0;
+
+    auto maxError = tolerance;
+
+    if (auto *param = curve.getOwnerParameter())
+        maxError *= param->getValueRange().getLength();
+
+    std::vector<ReducerPoint> points(static_cast<size_t>(numPoints));
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const auto p = curve.getPoint(first + i);
+        auto &rp = points[static_cast<size_t>(i)];
+        rp.time = p.time.inSeconds();
+        rp.value = p.value;
+        rp.curve = p.curve;
+    }
+
+    for (int i = 0; i + 1 < numPoints; ++i)
+    {
+        auto &rp = points[static_cast<size_t>(i)];
+
+        if (rp.curve != 0.0f)
+            rp.midValue = curve.getValueAt(tracktion::TimePosition::fromSeconds((rp.time + points[static_cast<size_t>(i + 1)].time) * 0.5));
+    }
+
+    std::vector<bool> keep(static_cast<size_t>(numPoints), false);
+    keep.front() = true;
+    keep.back() = true;
+
+    std::vector<std::pair<int, int>> spans{{0, numPoints - 1}};
+
+    while (!spans.empty())
+    {
+        const auto [a, b] = spans.back();
+        spans.pop_back();
+
+        if (b - a < 2)
+            continue;
+
+        const auto &pa = points[static_cast<size_t>(a)];
+        const auto &pb = points[static_cast<size_t>(b)];
+
+        auto worstError = 0.0f;
+        int worstIndex = -1;
+
+        for (int i = a; i < b; ++i)
+        {
+            const auto &p = points[static_cast<size_t>(i)];
+
+            if (i > a)
+            {
+                const auto error = std::abs(p.value - interpolate(pa, pb, p.time));
+
+                if (error > worstError)
+                {
+                    worstError = error;
+                    worstIndex = i;
+                }
+            }
+
+            // the bend of a curved segment, split at whichever of its points
+            // lies inside the span
+            if (p.curve != 0.0f)
+            {
+                const auto midTime = (p.time + points[static_cast<size_t>(i + 1)].time) * 0.5;
+                const auto error = std::abs(p.midValue - interpolate(pa, pb, midTime));
+
+                if (error > worstError)
+                {
+                    worstError = error;
+                    worstIndex = i > a ? i : i + 1;
+                }
+            }
+        }
+
+        if (worstIndex > a && worstIndex < b && worstError > maxError)
+        {
+            keep[static_cast<size_t>(worstIndex)] = true;
+            spans.emplace_back(a, worstIndex);
+            spans.emplace_back(worstIndex, b);
+        }
+    }
+
+    std::vector<ReducerPoint> kept;
+
+    for (int i = 0; i < numPoints;)
+    {
+        int next = i + 1;
+
+        while (next < numPoints && !keep[static_cast<size_t>(next)])
+            ++next;
+
+        // a kept point that now spans removed points is joined to the next kept
+        // point with a straight line, that is what the error was measured against
+        auto p = points[static_cast<size_t>(i)];
+        if (next < numPoints && next > i + 1)
+            p.curve = 0.0f;
+
+        kept.push_back(p);
+        i = next;
+    }
+
+    const int removed = numPoints - static_cast<int>(kept.size());
+
+    if (removed == 0)
+        return 0;
+
+    // every single removal would be its own tree change with listeners and an
+    // undo action, so the range is cleared once and only the kept points are
+    // written back
+    const auto firstTime = tracktion::TimePosition::fromSeconds(kept.front().time);
+    const auto lastTime = tracktion::TimePosition::fromSeconds(kept.back().time);
+
+    curve.removePointsInRegion({firstTime, lastTime});
+
+    auto isStillThere = [&curve](tracktion::TimePosition time)
+    {
+        const auto index = firstIndexAtOrAfter(curve, time);
+        return index < curve.getNumPoints() && curve.getPointTime(index) == time;
+    };
+
+    // the first and last point are still there if the region excluded its
+    // ends, the points in between are always added, two of them at the same
+    // time are a step
+    const auto keepFirst = isStillThere(firstTime);
+    const auto keepLast = isStillThere(lastTime);
+    const auto lastIndex = kept.size() - 1;
+
+    for (size_t i = 0; i < kept.size(); ++i)
+    {
+        if ((i == 0 && keepFirst) || (i == lastIndex && keepLast))
+            continue;
+
+        const auto &p = kept[i];
+        curve.addPoint(tracktion::TimePosition::fromSeconds(p.time), p.value, p.curve);
+    }
+
+    return removed;
+}
+
+int AutomationReducer::reduce(const te::TrackAutomationSection &section, float tolerance)
+{
+    int removed = 0;
+
+    for (auto &ap : section.activeParameters)
+        if (ap.param != nullptr)
+            removed += reduce(ap.param->getCurve(), section.position, tolerance);
+
+    return removed;
+}
+
+void AutomationReducer::timerCallback()
+{
+    const auto isRecording = m_edit.getTransport().isRecording();
+
+    if (isRecording)
+    {
+        // the transport may jump back on stop, so remember how far the recording got
+        m_recordEnd = juce::jmax(m_recordEnd, m_edit.getTransport().getPosition());
+    }
+
+    if (isRecording == m_wasRecording)
+        return;
+
+    m_wasRecording = isRecording;
+
+    if (isRecording)
+        recordingStarted();
+    else
+        recordingStopped();
+}
+
+void AutomationReducer::recordingStarted()
+{
+    auto &transport = m_edit.getTransport();
+    m_recordStart = transport.getPosition();
+
+    if (transport.looping)
+        m_recordStart = juce::jmin(m_recordStart, transport.getLoopRange().getStart());
+
+    m_recordEnd = transport.getPosition();
+
+    m_pointCountsAtStart.clear();
+
+    for (auto *ap : m_edit.getAllAutomatableParams(true))
+        m_pointCountsAtStart.add({ap, ap->getCurve().getNumPoints()});
+}
+
+void AutomationReducer::recordingStopped()
+{
+    const float tolerance = m_appState.m_automationReduceTolerance;
+    int removed = 0;
+
+    // the position is polled, the recording may have gone on for one more interval
+    auto recordEnd = m_recordEnd + tracktion::TimeDuration::fromSeconds(pollIntervalMs / 1000.0);
+    auto &transport = m_edit.getTransport();
+
+    // a loop recording never gets past the loop end
+    if (transport.looping)
+        recordEnd = juce::jmax(m_recordEnd, juce::jmin(recordEnd, transport.getLoopRange().getEnd()));
+
+    // only curves that were written to, and only the span that was recorded,
+    // hand drawn points after it are left alone
+    for (auto &[ap, numPointsAtStart] : m_pointCountsAtStart)
+    {
+        auto &curve = ap->getCurve();
+
+        if (curve.getNumPoints() == numPointsAtStart || curve.getNumPoints() == 0)
+            continue;
+
+        if (recordEnd > m_recordStart)
+            removed += reduce(curve, {m_recordStart, recordEnd}, tolerance);
+    }
+
+    m_pointCountsAtStart.clear();
+
+    if (removed > 0)
+        GUIHelpers::log("AutomationReducer: removed " + juce::String(removed) + " recorded automation points");
+}
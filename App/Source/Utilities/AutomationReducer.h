@@ -0,0 +1,64 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+namespace te = tracktion_engine;
+
+class ApplicationViewState;
+
+// Thins out automation curves. Recording from a MIDI controller leaves one
+// point per controller message, which costs both when the curve is evaluated
+// during playback and when the lane is drawn. The points of a range are
+// reduced with a Ramer-Douglas-Peucker pass: a point is only kept when
+// leaving it out would move the curve by more than the tolerance, given as a
+// fraction of the parameter's value range. The pass also measures the bends
+// of curved segments, so a shaped segment is not flattened silently.
+//
+// An instance watches the transport and thins the automation that was written
+// while recording, once the recording has stopped.
+class AutomationReducer : private juce::Timer
+{
+public:
+    AutomationReducer(te::Edit &edit, ApplicationViewState &appState);
+    ~AutomationReducer() override;
+
+    // Returns the number of points removed. The first and the last point of
+    // the range are always kept.
+    static int reduce(te::AutomationCurve &curve, tracktion::TimeRange range, float tolerance);
+    static int reduce(const te::TrackAutomationSection &section, float tolerance);
+
+private:
+    void timerCallback() override;
+    void recordingStarted();
+    void recordingStopped();
+
+    te::Edit &m_edit;
+    ApplicationViewState &m_appState;
+
+    bool m_wasRecording = false;
+    tracktion::TimePosition m_recordStart, m_recordEnd;
+    juce::Array<std::pair<te::AutomatableParameter::Ptr, int>> m_pointCountsAtStart;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AutomationReducer)
+};
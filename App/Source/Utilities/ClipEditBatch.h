@@ -0,0 +1,54 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "Utilities/EditViewState.h"
+
+// Groups a bulk edit of clips (move, copy, split, delete) into one undo
+// transaction. While a batch is open the edit does not reallocate its
+// playback graph, inserting or removing a clip on a track with heavy plugins
+// would otherwise rebuild it for every single clip. The graph is rebuilt once
+// when the outermost batch ends. Nested batches join the outer one.
+class ClipEditBatch
+{
+public:
+    ClipEditBatch(EditViewState &state, const juce::String &transactionName)
+        : m_state(state)
+    {
+        if (m_state.m_clipEditBatchDepth++ > 0)
+            return;
+
+        m_state.m_edit.getUndoManager().beginNewTransaction(transactionName);
+        m_inhibitor = std::make_unique<te::TransportControl::ReallocationInhibitor>(m_state.m_edit.getTransport());
+    }
+
+    ~ClipEditBatch() { --m_state.m_clipEditBatchDepth; }
+
+    ClipEditBatch(const ClipEditBatch &) = delete;
+    ClipEditBatch &operator=(const ClipEditBatch &) = delete;
+    ClipEditBatch(ClipEditBatch &&) = delete;
+    ClipEditBatch &operator=(ClipEditBatch &&) = delete;
+
+private:
+    EditViewState &m_state;
+    std::unique_ptr<te::TransportControl::ReallocationInhibitor> m_inhibitor;
+};
@@ -0,0 +1,291 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#include "Utilities/CpuProfiler.h"
+
+namespace
+{
+constexpr double windowMs = 1000.0;
+constexpr double idleTimeoutMs = 2000.0;
+
+juce::String formatPercent(float fraction) { return juce::String(fraction * 100.0f, 2); }
+
+template <typename Compare>
+void updateIf(std::atomic<float> &target, float value, Compare shouldReplace) noexcept
+{
+    auto current = target.load();
+    while (shouldReplace(value, current) && !target.compare_exchange_weak(current, value))
+    {
+    }
+}
+} // namespace
+
+void CpuProfiler::Accumulator::add(float value) noexcept
+{
+    updateIf(min, value, std::less<>());
+    updateIf(max, value, std::greater<>());
+
+    auto currentSum = sum.load();
+    while (!sum.compare_exchange_weak(currentSum, currentSum + value))
+    {
+    }
+
+    ++count;
+}
+
+CpuProfiler::Stats CpuProfiler::Accumulator::finishWindow() noexcept
+{
+    // a block that lands between the exchanges is counted in the next window
+    if (const auto numBlocks = count.exchange(0); numBlocks > 0)
+        last = {min.exchange(std::numeric_limits<float>::max()), sum.exchange(0.0f) / static_cast<float>(numBlocks), max.exchange(0.0f)};
+
+    return last;
+}
+
+//==============================================================================
+CpuProfiler::CpuProfiler(te::Edit &edit)
+    : m_edit(edit)
+{
+}
+
+CpuProfiler::~CpuProfiler() { stopCollecting(); }
+
+CpuProfiler::Stats CpuProfiler::getPluginStats(const te::Plugin &plugin)
+{
+    keepCollecting();
+
+    auto it = m_plugins.find(plugin.itemID.getRawID());
+    return it != m_plugins.end() ? it->second : Stats{};
+}
+
+CpuProfiler::Stats CpuProfiler::getTrackStats(const te::Track &track)
+{
+    keepCollecting();
+
+    auto it = m_tracks.find(track.itemID.getRawID());
+    return it != m_tracks.end() ? it->second : Stats{};
+}
+
+void CpuProfiler::startTrace()
+{
+    m_trace.clear();
+    m_traceStart = juce::Time::getMillisecondCounterHiRes();
+    m_isTracing = true;
+    keepCollecting();
+}
+
+void CpuProfiler::stopTrace() { m_isTracing = false; }
+
+bool CpuProfiler::writeTraceToCsv(const juce::File &file) const
+{
+    juce::FileOutputStream out(file);
+    if (!out.openedOk())
+        return false;
+
+    out.setPosition(0);
+    out.truncate();
+
+    out << "time_s,track,plugin,min_percent,avg_percent,max_percent\n";
+
+    auto quote = [](const juce::String &s) { return "\"" + s.replace("\"", "\"\"") + "\""; };
+
+    for (const auto &row : m_trace)
+        out << juce::String(row.time, 3) << "," << quote(row.track) << "," << quote(row.plugin) << "," << formatPercent(row.stats.min) << "," << formatPercent(row.stats.avg) << "," << formatPercent(row.stats.max) << "\n";
+
+    out.flush();
+    return out.getStatus().wasOk();
+}
+
+void CpuProfiler::keepCollecting()
+{
+    m_lastRequest = juce::Time::getMillisecondCounterHiRes();
+
+    if (m_isCollecting)
+        return;
+
+    m_isCollecting = true;
+    updateSnapshot();
+    m_edit.engine.getDeviceManager().deviceManager.addAudioCallback(this);
+    startTimer(static_cast<int>(windowMs));
+}
+
+void CpuProfiler::stopCollecting()
+{
+    stopTimer();
+
+    if (!m_isCollecting)
+        return;
+
+    m_isCollecting = false;
+    m_edit.engine.getDeviceManager().deviceManager.removeAudioCallback(this);
+
+    std::unique_ptr<Snapshot> snapshot;
+    {
+        const juce::SpinLock::ScopedLockType sl(m_snapshotLock);
+        std::swap(m_snapshot, snapshot);
+    }
+
+    m_plugins.clear();
+    m_tracks.clear();
+}
+
+juce::Array<te::Plugin *> CpuProfiler::getPluginsOf(te::Track &track) const
+{
+    juce::Array<te::Plugin *> plugins;
+
+    if (!track.isMasterTrack())
+    {
+        for (int i = 0; i < track.pluginList.size(); ++i)
+            plugins.add(track.pluginList[i]);
+
+        return plugins;
+    }
+
+    // the master strip shows the master plugins and the master volume
+    auto &masterPlugins = m_edit.getMasterPluginList();
+
+    for (int i = 0; i < masterPlugins.size(); ++i)
+        plugins.add(masterPlugins[i]);
+
+    if (auto masterVolume = m_edit.getMasterVolumePlugin())
+        plugins.addIfNotAlreadyThere(masterVolume.get());
+
+    return plugins;
+}
+
+void CpuProfiler::updateSnapshot()
+{
+    auto tracks = te::getAllTracks(m_edit);
+
+    auto isUnchanged = [&]
+    {
+        if (m_snapshot == nullptr || m_snapshot->size() != static_cast<size_t>(tracks.size()))
+            return false;
+
+        for (int t = 0; t < tracks.size(); ++t)
+        {
+            auto &slot = *(*m_snapshot)[static_cast<size_t>(t)];
+            auto plugins = getPluginsOf(*tracks[t]);
+
+            if (slot.track.get() != tracks[t] || slot.plugins.size() != static_cast<size_t>(plugins.size()))
+                return false;
+
+            for (int p = 0; p < plugins.size(); ++p)
+                if (slot.plugins[static_cast<size_t>(p)]->plugin.get() != plugins[p])
+                    return false;
+        }
+
+        return true;
+    };
+
+    if (isUnchanged())
+        return;
+
+    auto snapshot = std::make_unique<Snapshot>();
+
+    for (auto track : tracks)
+    {
+        auto slot = std::make_unique<TrackSlot>();
+        slot->track = track;
+
+        for (auto plugin : getPluginsOf(*track))
+        {
+            auto pluginSlot = std::make_unique<PluginSlot>();
+            pluginSlot->plugin = plugin;
+            slot->plugins.push_back(std::move(pluginSlot));
+        }
+
+        snapshot->push_back(std::move(slot));
+    }
+
+    {
+        const juce::SpinLock::ScopedLockType sl(m_snapshotLock);
+        std::swap(m_snapshot, snapshot);
+    }
+
+    // the previous snapshot is deleted here, outside of the lock
+}
+
+void CpuProfiler::timerCallback()
+{
+    if (!m_isTracing && juce::Time::getMillisecondCounterHiRes() - m_lastRequest > idleTimeoutMs)
+    {
+        stopCollecting();
+        return;
+    }
+
+    finishWindow();
+    updateSnapshot();
+}
+
+void CpuProfiler::finishWindow()
+{
+    if (m_snapshot == nullptr)
+        return;
+
+    const auto time = (juce::Time::getMillisecondCounterHiRes() - m_traceStart) / 1000.0;
+
+    for (auto &trackSlot : *m_snapshot)
+    {
+        auto trackStats = trackSlot->stats.finishWindow();
+        m_tracks[trackSlot->track->itemID.getRawID()] = trackStats;
+
+        if (m_isTracing)
+            m_trace.push_back({time, trackSlot->track->getName(), {}, trackStats});
+
+        for (auto &pluginSlot : trackSlot->plugins)
+        {
+            auto pluginStats = pluginSlot->stats.finishWindow();
+            m_plugins[pluginSlot->plugin->itemID.getRawID()] = pluginStats;
+
+            if (m_isTracing)
+                m_trace.push_back({time, trackSlot->track->getName(), pluginSlot->plugin->getName(), pluginStats});
+        }
+    }
+}
+
+void CpuProfiler::audioDeviceIOCallbackWithContext(const float *const *, int, float *const *outputChannelData, int numOutputChannels, int numSamples, const juce::AudioIODeviceCallbackContext &)
+{
+    // JUCE mixes the output of every callback, this one only reads the values
+    // the engine's callback has just updated
+    for (int ch = 0; ch < numOutputChannels; ++ch)
+        if (outputChannelData[ch] != nullptr)
+            juce::FloatVectorOperations::clear(outputChannelData[ch], numSamples);
+
+    const juce::SpinLock::ScopedTryLockType sl(m_snapshotLock);
+    if (!sl.isLocked() || m_snapshot == nullptr)
+        return;
+
+    for (auto &trackSlot : *m_snapshot)
+    {
+        float trackUsage = 0.0f;
+
+        for (auto &pluginSlot : trackSlot->plugins)
+        {
+            auto usage = static_cast<float>(pluginSlot->plugin->getCpuUsage());
+
+            trackUsage += usage;
+            pluginSlot->stats.add(usage);
+        }
+
+        trackSlot->stats.add(trackUsage);
+    }
+}
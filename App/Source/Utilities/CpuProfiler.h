@@ -0,0 +1,124 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <unordered_map>
+
+namespace te = tracktion_engine;
+
+// How much of the audio block time each plugin and each track takes.
+// tracktion times every plugin's applyToBuffer on the audio thread and
+// publishes the last block's value through an atomic (te::Plugin::getCpuUsage()).
+// While the profiler is in use it is added as an extra device callback. That
+// runs after the engine's callback in every device block, so it reads each
+// block's value and adds it to lock-free per plugin sums, maxima and minima.
+// A timer turns those into min/avg/max per second. A track's value is the sum
+// of its plugins, the master track's are the master plugin list and the
+// master volume. Collecting stops on its own when nobody asked for values for
+// a while and no trace is being recorded. While tracing, every finished
+// second is kept and can be written as CSV.
+class CpuProfiler
+    : private juce::Timer
+    , private juce::AudioIODeviceCallback
+{
+public:
+    // fractions of the block time
+    struct Stats
+    {
+        float min = 0.0f;
+        float avg = 0.0f;
+        float max = 0.0f;
+    };
+
+    explicit CpuProfiler(te::Edit &edit);
+    ~CpuProfiler() override;
+
+    // values of the last finished second, also keeps the collecting running
+    Stats getPluginStats(const te::Plugin &plugin);
+    Stats getTrackStats(const te::Track &track);
+
+    void startTrace();
+    void stopTrace();
+    [[nodiscard]] bool isTracing() const { return m_isTracing; }
+    [[nodiscard]] bool hasTrace() const { return !m_trace.empty(); }
+    bool writeTraceToCsv(const juce::File &file) const;
+
+private:
+    // written once per device block on the audio thread, read and reset by
+    // the timer
+    struct Accumulator
+    {
+        void add(float value) noexcept;
+        Stats finishWindow() noexcept;
+
+        std::atomic<float> min{std::numeric_limits<float>::max()}, max{0.0f}, sum{0.0f};
+        std::atomic<int> count{0};
+        Stats last;
+    };
+
+    struct PluginSlot
+    {
+        te::Plugin::Ptr plugin;
+        Accumulator stats;
+    };
+
+    struct TrackSlot
+    {
+        te::Track::Ptr track;
+        Accumulator stats;
+        std::vector<std::unique_ptr<PluginSlot>> plugins;
+    };
+
+    // the tracks and plugins the audio callback reads, rebuilt on the message
+    // thread when they change
+    using Snapshot = std::vector<std::unique_ptr<TrackSlot>>;
+
+    struct TraceRow
+    {
+        double time;
+        juce::String track, plugin;
+        Stats stats;
+    };
+
+    void keepCollecting();
+    void stopCollecting();
+    juce::Array<te::Plugin *> getPluginsOf(te::Track &track) const;
+    void updateSnapshot();
+    void timerCallback() override;
+    void finishWindow();
+
+    void audioDeviceIOCallbackWithContext(const float *const *inputChannelData, int numInputChannels, float *const *outputChannelData, int numOutputChannels, int numSamples, const juce::AudioIODeviceCallbackContext &context) override;
+    void audioDeviceAboutToStart(juce::AudioIODevice *) override {}
+    void audioDeviceStopped() override {}
+
+    te::Edit &m_edit;
+    std::unique_ptr<Snapshot> m_snapshot;
+    juce::SpinLock m_snapshotLock;
+    std::unordered_map<juce::uint64, Stats> m_plugins, m_tracks;
+    double m_traceStart = 0.0, m_lastRequest = 0.0;
+    bool m_isCollecting = false;
+    bool m_isTracing = false;
+    std::vector<TraceRow> m_trace;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CpuProfiler)
+};
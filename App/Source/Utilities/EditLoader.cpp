@@ -0,0 +1,195 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#include "Utilities/EditLoader.h"
+#include "Utilities/Utilities.h"
+
+namespace
+{
+void collectSourceFiles(const juce::ValueTree &node, const juce::File &editFile, juce::Array<juce::File> &files)
+{
+    if (node.hasProperty(te::IDs::source))
+    {
+        auto file = EditLoader::resolveSourceFile(editFile, node[te::IDs::source].toString());
+
+        if (file.existsAsFile())
+            files.addIfNotAlreadyThere(file);
+    }
+
+    for (const auto &child : node)
+        collectSourceFiles(child, editFile, files);
+}
+} // namespace
+
+EditLoader::EditLoader(te::Engine &engine, const juce::File &editFile, Callback onLoaded)
+    : m_engine(engine),
+      m_editFile(editFile),
+      m_onLoaded(std::move(onLoaded)),
+      m_progressWindow(TRANS("Open project"), editFile.getFileNameWithoutExtension(), juce::MessageBoxIconType::NoIcon),
+      m_loadState(std::make_shared<LoadState>())
+{
+    m_progressWindow.addButton(TRANS("Cancel"), 0, juce::KeyPress(juce::KeyPress::escapeKey));
+    m_progressWindow.addProgressBarComponent(m_progress);
+    m_progressWindow.enterModalState();
+
+    auto &deviceManager = engine.getDeviceManager();
+    m_loadState->preloader = std::make_unique<PluginPreloader>(engine, deviceManager.getSampleRate(), deviceManager.getBlockSize());
+
+    m_threadPool.addJob([&engine, editFile, loadState = m_loadState] { load(engine, editFile, *loadState); });
+
+    startTimer(20);
+}
+
+EditLoader::~EditLoader()
+{
+    stopTimer();
+    m_loadState->shouldExit = true;
+
+    // the job shares the load state, it can safely outlive a timeout
+    m_threadPool.removeAllJobs(true, 30000);
+
+    // plugin instances have to be deleted on the message thread
+    m_loadState->preloader->releaseInstances();
+}
+
+juce::ValueTree EditLoader::readEditState(const juce::File &editFile)
+{
+    juce::FileInputStream in(editFile);
+    if (!in.openedOk())
+        return {};
+
+    // saved edits are XML, autosaves are written as binary ValueTree stream
+    if (in.readByte() == '<')
+    {
+        if (auto xml = juce::parseXML(editFile))
+            return juce::ValueTree::fromXml(*xml);
+
+        return {};
+    }
+
+    in.setPosition(0);
+    return juce::ValueTree::readFromStream(in);
+}
+
+juce::File EditLoader::resolveSourceFile(const juce::File &editFile, const juce::String &source)
+{
+    if (source.isEmpty())
+        return {};
+
+    if (juce::File::isAbsolutePath(source))
+        return juce::File(source);
+
+    return editFile.getParentDirectory().getChildFile(source);
+}
+
+std::unique_ptr<te::Edit> EditLoader::createEdit(te::Engine &engine, const juce::File &editFile, const juce::ValueTree &state)
+{
+    auto itemID = te::ProjectItemID::fromProperty(state, te::IDs::projectID);
+    if (!itemID.isValid())
+        itemID = te::ProjectItemID::createNewID(0);
+
+    te::Edit::Options options{engine, state, itemID};
+    options.role = te::Edit::forEditing;
+    options.editFileRetriever = [editFile] { return editFile; };
+    options.filePathResolver = [editFile](const juce::String &source) { return resolveSourceFile(editFile, source); };
+
+    return std::make_unique<te::Edit>(options);
+}
+
+void EditLoader::load(te::Engine &engine, const juce::File &editFile, LoadState &loadState)
+{
+    auto state = readEditState(editFile);
+
+    if (state.isValid())
+        state = te::updateLegacyEdit(state);
+
+    loadState.progress = 0.2f;
+
+    if (state.isValid())
+    {
+        juce::Array<juce::File> sourceFiles;
+        collectSourceFiles(state, editFile, sourceFiles);
+
+        for (int i = 0; i < sourceFiles.size(); ++i)
+        {
+            if (loadState.shouldExit)
+                return;
+
+            // fills the AudioFileManager cache, the clips find their info there later
+            te::AudioFile(engine, sourceFiles[i]).getInfo();
+            loadState.progress = 0.2f + 0.3f * static_cast<float>(i + 1) / static_cast<float>(sourceFiles.size());
+        }
+
+        loadState.preloader->prepare(state);
+
+        if (loadState.shouldExit)
+            return;
+    }
+
+    loadState.state = state;
+    loadState.progress = 0.5f;
+    loadState.finished = true;
+}
+
+void EditLoader::timerCallback()
+{
+    m_progress = m_loadState->progress.load();
+
+    if (!m_progressWindow.isCurrentlyModal())
+    {
+        stopTimer();
+        m_loadState->shouldExit = true;
+        GUIHelpers::log("EditLoader: loading cancelled: " + m_editFile.getFullPathName());
+        return;
+    }
+
+    if (!m_loadState->finished)
+        return;
+
+    // the plugin binaries need the message thread, keep the window responsive between them
+    if (m_loadState->state.isValid() && m_loadState->preloader->loadNext())
+    {
+        m_loadState->progress = 0.5f + 0.5f * m_loadState->preloader->getProgress();
+        return;
+    }
+
+    stopTimer();
+    m_progressWindow.exitModalState(0);
+    m_progressWindow.setVisible(false);
+
+    if (!m_loadState->state.isValid())
+    {
+        juce::Logger::writeToLog("Error: could not read edit file: " + m_editFile.getFullPathName());
+        juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon, TRANS("Open project"), TRANS("Could not read the project file.") + "\n\n" + m_editFile.getFullPathName());
+        return;
+    }
+
+    GUIHelpers::log("EditLoader: read " + m_editFile.getFullPathName());
+
+    m_loadState->preloader->logTimings();
+
+    // the callback may replace this loader, the preloaded instances keep the
+    // plugin modules loaded until it has created the edit
+    auto onLoaded = m_onLoaded;
+    auto loadState = m_loadState;
+    onLoaded(m_editFile, loadState->state);
+    loadState->preloader->releaseInstances();
+}
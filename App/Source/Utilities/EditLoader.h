@@ -0,0 +1,77 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "Utilities/PluginPreloader.h"
+
+namespace te = tracktion_engine;
+
+// Opens an edit file in stages so the window stays responsive while the
+// file is read. The file is parsed on a background thread, where the audio
+// files of its clips are also read into the engine's AudioFile cache. The
+// binaries of its external plugins are then loaded on the message thread, one
+// per timer callback (see PluginPreloader). A progress window with a cancel
+// button is shown meanwhile; the current edit stays open until the new one is
+// ready.
+// The te::Edit itself is still created synchronously on the message thread
+// after the progress window has closed. Its clips no longer wait for the disk,
+// but creating the plugin instances and restoring their state is the biggest
+// stall of opening a project, and it has neither progress nor a cancel button.
+class EditLoader : private juce::Timer
+{
+public:
+    // called on the message thread once the state is read, not after a cancel
+    using Callback = std::function<void(const juce::File &editFile, const juce::ValueTree &state)>;
+
+    EditLoader(te::Engine &engine, const juce::File &editFile, Callback onLoaded);
+    ~EditLoader() override;
+
+    [[nodiscard]] const juce::File &getEditFile() const { return m_editFile; }
+
+    // reads an edit saved as XML or as binary ValueTree stream
+    static juce::ValueTree readEditState(const juce::File &editFile);
+    static juce::File resolveSourceFile(const juce::File &editFile, const juce::String &source);
+    static std::unique_ptr<te::Edit> createEdit(te::Engine &engine, const juce::File &editFile, const juce::ValueTree &state);
+
+private:
+    struct LoadState
+    {
+        std::atomic<float> progress{0.0f};
+        std::atomic<bool> shouldExit{false}, finished{false};
+        juce::ValueTree state;
+        std::unique_ptr<PluginPreloader> preloader;
+    };
+
+    static void load(te::Engine &engine, const juce::File &editFile, LoadState &loadState);
+    void timerCallback() override;
+
+    te::Engine &m_engine;
+    juce::File m_editFile;
+    Callback m_onLoaded;
+    juce::AlertWindow m_progressWindow;
+    double m_progress = 0.0;
+    std::shared_ptr<LoadState> m_loadState;
+    juce::ThreadPool m_threadPool{juce::ThreadPool::Options{}.withNumberOfThreads(1).withThreadName("Edit loader")};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EditLoader)
+};
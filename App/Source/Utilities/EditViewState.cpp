@@ -29,6 +29,7 @@ EditViewState::EditViewState(te::Edit &e, te::SelectionManager &s, ApplicationVi
     m_trackHeightManager = std::make_unique<TrackHeightManager>(tracktion::getAllTracks(e));
     m_trackHeightManager->regenerateTrackHeightsFromEdit(m_edit);
     m_thumbNailManager = std::make_unique<ThumbNailManager>(m_edit.engine);
+    m_renderJobQueue = std::make_unique<RenderJobQueue>(m_edit);
     m_state = m_edit.state.getOrCreateChildWithName(IDs::EDITVIEWSTATE, nullptr);
     m_viewDataTree = m_edit.state.getOrCreateChildWithName(IDs::viewData, nullptr);
     m_pluginPresetManagerUIStates = m_state.getOrCreateChildWithName(IDs::pluginPresetManagerUIStates, nullptr);
@@ -71,6 +72,7 @@ EditViewState::EditViewState(te::Edit &e, te::SelectionManager &s, ApplicationVi
     m_clipHeaderHeight.referTo(m_state, IDs::clipHeaderHeight, um, 20);
     m_syncAutomation.referTo(m_state, IDs::syncAutomation, um, true);
     m_snapToGrid.referTo(m_state, IDs::snapToGrid, um, true);
+    m_showCpuUsage.referTo(m_state, IDs::showCpuUsage, nullptr, false);
     m_editNotesOutsideClipRange.referTo(m_state, IDs::editNoteOutsideOfClipRange, um, false);
 }
 
@@ -387,3 +389,11 @@ void EditViewState::updatePositionFollower(juce::String timeLineID, int width)
 SimpleThumbnail *EditViewState::getOrCreateThumbnail(te::WaveAudioClip::Ptr wac) { return m_thumbNailManager->getOrCreateThumbnail(wac); }
 void EditViewState::clearThumbnails() { m_thumbNailManager->clearThumbnails(); }
 void EditViewState::removeThumbnail(te::EditItemID id) { m_thumbNailManager->removeThumbnail(id); }
+
+CpuProfiler &EditViewState::getCpuProfiler()
+{
+    if (m_cpuProfiler == nullptr)
+        m_cpuProfiler = std::make_unique<CpuProfiler>(m_edit);
+
+    return *m_cpuProfiler;
+}
@@ -23,6 +23,8 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "Utilities/ApplicationViewState.h"
+#include "Utilities/CpuProfiler.h"
+#include "Utilities/RenderJobQueue.h"
 #include "Utilities/TrackHeightManager.h"
 #include "Utilities/Utilities.h"
 
@@ -121,6 +123,11 @@ DECLARE_ID(editNoteOutsideOfClipRange)
 DECLARE_ID(pluginPresetManagerUIStates)
 DECLARE_ID(trackPluginChainViewState)
 DECLARE_ID(selectedModifier)
+DECLARE_ID(frozenClip)
+DECLARE_ID(frozenMutedClips)
+DECLARE_ID(frozenDisabledPlugins)
+DECLARE_ID(freezeJobID)
+DECLARE_ID(showCpuUsage)
 
 #undef DECLARE_ID
 } // namespace IDs
@@ -247,12 +254,16 @@ public:
     void clearThumbnails();
     void removeThumbnail(te::EditItemID id);
 
+    CpuProfiler &getCpuProfiler();
+
     std::unique_ptr<TrackHeightManager> m_trackHeightManager;
     std::unique_ptr<ThumbNailManager> m_thumbNailManager;
+    std::unique_ptr<RenderJobQueue> m_renderJobQueue;
+    std::unique_ptr<CpuProfiler> m_cpuProfiler;
     te::Edit &m_edit;
     te::SelectionManager &m_selectionManager;
 
-    juce::CachedValue<bool> m_showGlobalTrack, m_showMarkerTrack, m_showChordTrack, m_showArrangerTrack, m_showMasterTrack, m_drawWaveforms, m_showHeaders, m_showFooters, m_showMidiDevices, m_showWaveDevices, m_isAutoArmed, m_automationFollowsClip, m_followPlayhead, m_syncAutomation;
+    juce::CachedValue<bool> m_showGlobalTrack, m_showMarkerTrack, m_showChordTrack, m_showArrangerTrack, m_showMasterTrack, m_drawWaveforms, m_showHeaders, m_showFooters, m_showMidiDevices, m_showWaveDevices, m_isAutoArmed, m_automationFollowsClip, m_followPlayhead, m_syncAutomation, m_showCpuUsage;
     juce::CachedValue<int> m_lowerRangeView, m_followModeVal;
     juce::CachedValue<double> m_lastNoteLength, m_playHeadStartTime, m_timeLineZoomUnit;
     juce::CachedValue<int> m_midiEditorHeight, m_velocityEditorHeight, m_clipHeaderHeight;
@@ -267,6 +278,7 @@ public:
     juce::ValueTree m_pluginPresetManagerUIStates;
     juce::ValueTree m_trackPluginChainViewState;
     bool m_isSavingLocked{false}, m_needAutoSave{false};
+    int m_clipEditBatchDepth{0}; // see ClipEditBatch
     ApplicationViewState &m_applicationState;
 
 private:
@@ -0,0 +1,230 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#include "Utilities/HeadlessRenderer.h"
+#include "Utilities/Utilities.h"
+
+HeadlessRenderer::HeadlessRenderer(ApplicationViewState &avs)
+    : m_applicationState(avs)
+{
+    EngineHelpers::registerBuiltInPlugins(m_engine);
+}
+
+HeadlessRenderer::~HeadlessRenderer()
+{
+    if (m_editViewState != nullptr)
+    {
+        m_editViewState->m_renderJobQueue->removeChangeListener(this);
+        m_editViewState->m_renderJobQueue->onJobFinished = nullptr;
+    }
+
+    m_editViewState = nullptr;
+    m_edit = nullptr;
+}
+
+juce::String HeadlessRenderer::getUsage() { return "usage: NextStudio --render <edit> --out <file> [--range a:b] [--stems] [--sr 48000 --bits 24]"; }
+
+bool HeadlessRenderer::parseCommandLine(const juce::StringArray &args, Options &options, juce::String &error)
+{
+    auto valueOf = [&args](const juce::String &option) -> juce::String
+    {
+        auto index = args.indexOf(option);
+        if (index < 0 || index + 1 >= args.size())
+            return {};
+        return args[index + 1].unquoted();
+    };
+
+    auto toFile = [](const juce::String &path) { return juce::File::getCurrentWorkingDirectory().getChildFile(path); };
+
+    auto editPath = valueOf("--render");
+    auto outPath = valueOf("--out");
+
+    if (editPath.isEmpty() || outPath.isEmpty())
+    {
+        error = "--render and --out are required";
+        return false;
+    }
+
+    options.editFile = toFile(editPath);
+    options.outFile = toFile(outPath);
+    options.stems = args.contains("--stems");
+
+    if (!options.editFile.existsAsFile())
+    {
+        error = "edit not found: " + options.editFile.getFullPathName();
+        return false;
+    }
+
+    if (auto range = valueOf("--range"); range.isNotEmpty())
+    {
+        if (!range.containsChar(':'))
+        {
+            error = "--range expects start:end in seconds";
+            return false;
+        }
+
+        auto start = range.upToFirstOccurrenceOf(":", false, false).getDoubleValue();
+        auto end = range.fromFirstOccurrenceOf(":", false, false).getDoubleValue();
+
+        if (end <= start)
+        {
+            error = "--range end has to be after start";
+            return false;
+        }
+
+        options.range = {tracktion::TimePosition::fromSeconds(start), tracktion::TimePosition::fromSeconds(end)};
+    }
+
+    if (auto sr = valueOf("--sr"); sr.isNotEmpty())
+        options.sampleRate = sr.getDoubleValue();
+
+    if (auto bits = valueOf("--bits"); bits.isNotEmpty())
+        options.bitDepth = bits.getIntValue();
+
+    if (options.sampleRate < 8000.0 || options.sampleRate > 384000.0)
+    {
+        error = "unsupported sample rate: " + juce::String(options.sampleRate);
+        return false;
+    }
+
+    if (options.bitDepth != 16 && options.bitDepth != 24 && options.bitDepth != 32)
+    {
+        error = "unsupported bit depth: " + juce::String(options.bitDepth);
+        return false;
+    }
+
+    return true;
+}
+
+void HeadlessRenderer::start(const juce::StringArray &args)
+{
+    Options options;
+    juce::String error;
+
+    if (!parseCommandLine(args, options, error))
+    {
+        print("error: " + error);
+        print(getUsage());
+        finish(invalidArguments);
+        return;
+    }
+
+    m_startTime = juce::Time::getMillisecondCounterHiRes();
+    print("loading " + options.editFile.getFullPathName());
+
+    m_edit = te::loadEditFromFile(m_engine, options.editFile);
+
+    if (m_edit == nullptr)
+    {
+        print("error: could not load " + options.editFile.getFullPathName());
+        finish(loadFailed);
+        return;
+    }
+
+    print("loaded in " + juce::String((juce::Time::getMillisecondCounterHiRes() - m_startTime) / 1000.0, 2) + " s");
+
+    m_editViewState = std::make_unique<EditViewState>(*m_edit, m_selectionManager, m_applicationState);
+
+    auto &queue = *m_editViewState->m_renderJobQueue;
+    queue.addChangeListener(this);
+    queue.onJobFinished = [this](const RenderJobQueue::Result &result)
+    {
+        if (result.succeeded)
+        {
+            print("wrote " + result.file.getFullPathName() + " in " + juce::String(result.secondsTaken, 2) + " s");
+        }
+        else
+        {
+            ++m_numFailed;
+            print("error: " + result.file.getFullPathName() + ": " + result.errorMessage);
+        }
+    };
+
+    m_startTime = juce::Time::getMillisecondCounterHiRes();
+
+    if (options.stems)
+    {
+        const bool useFlac = options.outFile.hasFileExtension(".flac");
+        auto tracks = EngineHelpers::getTracksForStemExport(*m_edit, {});
+        m_numJobs = EngineHelpers::renderStemsToFolder(*m_editViewState, options.outFile, options.editFile.getFileNameWithoutExtension(), tracks, options.range, useFlac, false, options.sampleRate, options.bitDepth);
+    }
+    else
+    {
+        m_numJobs = EngineHelpers::renderEditToFile(*m_editViewState, options.outFile, options.range, options.sampleRate, options.bitDepth) != 0 ? 1 : 0;
+    }
+
+    if (m_numJobs == 0)
+    {
+        print("error: nothing to render");
+        finish(renderFailed);
+    }
+}
+
+void HeadlessRenderer::changeListenerCallback(juce::ChangeBroadcaster *)
+{
+    auto &queue = *m_editViewState->m_renderJobQueue;
+
+    if (!queue.isBusy())
+    {
+        auto seconds = (juce::Time::getMillisecondCounterHiRes() - m_startTime) / 1000.0;
+        print(juce::String(m_numJobs - m_numFailed) + " of " + juce::String(m_numJobs) + " renders finished in " + juce::String(seconds, 2) + " s");
+        finish(m_numFailed == 0 ? success : renderFailed);
+        return;
+    }
+
+    float progress = 0.0f;
+    double realtimeFactor = 0.0;
+    int numRunning = 0;
+
+    for (auto &info : queue.getJobInfos())
+    {
+        if (!info.isRunning)
+            continue;
+
+        progress += info.progress;
+        realtimeFactor += info.realtimeFactor;
+        ++numRunning;
+    }
+
+    if (numRunning == 0)
+        return;
+
+    auto percent = juce::roundToInt(100.0f * progress / (float)numRunning);
+
+    if (percent / 5 == m_lastPrintedPercent / 5)
+        return;
+
+    m_lastPrintedPercent = percent;
+    print(juce::String(percent) + "% (" + juce::String(numRunning) + " running, " + juce::String(realtimeFactor, 1) + "x realtime)");
+}
+
+void HeadlessRenderer::finish(int exitCode)
+{
+    if (m_isFinished)
+        return;
+
+    m_isFinished = true;
+
+    if (onFinished)
+        onFinished(exitCode);
+}
+
+void HeadlessRenderer::print(const juce::String &text) { std::cout << "[render] " << text << std::endl; }
@@ -0,0 +1,93 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "Utilities/ApplicationViewState.h"
+#include "Utilities/EditViewState.h"
+
+namespace te = tracktion_engine;
+
+// Renders an edit from the command line without opening a window:
+//
+//   NextStudio --render <edit> --out <file> [--range a:b] [--stems] [--sr 48000 --bits 24]
+//
+// --range takes start and end in seconds. With --stems, --out is the folder the
+// stems are written to. A .flac extension on --out (or on the folder name with
+// --stems) selects FLAC, everything else renders to WAV.
+// The render goes through the same RenderJobQueue as the render dialog.
+class HeadlessRenderer : private juce::ChangeListener
+{
+public:
+    enum ExitCode
+    {
+        success = 0,
+        renderFailed = 1,
+        invalidArguments = 2,
+        loadFailed = 3
+    };
+
+    struct Options
+    {
+        juce::File editFile, outFile;
+        tracktion::TimeRange range;
+        bool stems = false;
+        double sampleRate = 48000.0;
+        int bitDepth = 24;
+    };
+
+    explicit HeadlessRenderer(ApplicationViewState &avs);
+    ~HeadlessRenderer() override;
+
+    static bool isRenderCommandLine(const juce::StringArray &args) { return args.contains("--render"); }
+    static bool parseCommandLine(const juce::StringArray &args, Options &options, juce::String &error);
+    static juce::String getUsage();
+
+    // Loads the edit and queues the render. onFinished gets called with the
+    // exit code when all jobs are done or if nothing could be started.
+    void start(const juce::StringArray &args);
+
+    std::function<void(int exitCode)> onFinished;
+
+private:
+    struct HeadlessEngineBehaviour : public te::EngineBehaviour
+    {
+        bool autoInitialiseDeviceManager() override { return false; }
+    };
+
+    void changeListenerCallback(juce::ChangeBroadcaster *) override;
+    void finish(int exitCode);
+    static void print(const juce::String &text);
+
+    ApplicationViewState &m_applicationState;
+    te::Engine m_engine{ProjectInfo::projectName, std::make_unique<te::UIBehaviour>(), std::make_unique<HeadlessEngineBehaviour>()};
+    te::SelectionManager m_selectionManager{m_engine};
+    std::unique_ptr<te::Edit> m_edit;
+    std::unique_ptr<EditViewState> m_editViewState;
+
+    double m_startTime{0.0};
+    int m_numJobs{0}, m_numFailed{0};
+    int m_lastPrintedPercent{-1};
+    bool m_isFinished{false};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HeadlessRenderer)
+};
@@ -0,0 +1,127 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#include "Utilities/IconCache.h"
+
+JUCE_IMPLEMENT_SINGLETON(IconCache)
+
+IconCache::~IconCache() { clearSingletonInstance(); }
+
+std::shared_ptr<const juce::Drawable> IconCache::getParsedSvg(const char *svgbinary)
+{
+    auto it = m_parsedSvgs.find(svgbinary);
+    if (it != m_parsedSvgs.end())
+        return it->second;
+
+    std::shared_ptr<const juce::Drawable> drawable;
+
+    if (auto svg = juce::XmlDocument::parse(svgbinary))
+        drawable = juce::Drawable::createFromSVG(*svg);
+
+    // failed parses are stored too, so we don't try again on every paint
+    m_parsedSvgs.emplace(svgbinary, drawable);
+    return drawable;
+}
+
+std::shared_ptr<const juce::Drawable> IconCache::getDrawable(const char *svgbinary, juce::Colour colour)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    const DrawableKey key{svgbinary, colour.getARGB()};
+    auto it = m_drawables.find(key);
+    if (it != m_drawables.end())
+        return it->second;
+
+    std::shared_ptr<juce::Drawable> drawable;
+
+    if (auto parsed = getParsedSvg(svgbinary))
+    {
+        drawable = parsed->createCopy();
+        drawable->replaceColour(juce::Colour(0xff626262), colour);
+    }
+
+    m_drawables.emplace(key, drawable);
+    return drawable;
+}
+
+juce::Image IconCache::getImage(const char *svgbinary, juce::Colour colour, juce::Rectangle<float> drawRect, float pixelScale)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    const auto width = juce::roundToInt(drawRect.getWidth() * pixelScale);
+    const auto height = juce::roundToInt(drawRect.getHeight() * pixelScale);
+
+    if (width <= 0 || height <= 0)
+        return {};
+
+    const ImageKey key{svgbinary, colour.getARGB(), width, height};
+    auto it = m_images.find(key);
+    if (it != m_images.end())
+        return it->second;
+
+    auto drawable = getDrawable(svgbinary, colour);
+    if (drawable == nullptr)
+        return {};
+
+    juce::Image image(juce::Image::ARGB, width, height, true);
+    {
+        juce::Graphics g(image);
+        auto placement = juce::RectanglePlacement(juce::RectanglePlacement::centred);
+        auto transform = placement.getTransformToFit(drawable->getDrawableBounds(), {0.f, 0.f, (float)width, (float)height});
+        drawable->draw(g, 1.f, transform);
+    }
+
+    // icons are requested in a handful of sizes only, this just keeps a
+    // continuously resizing component from growing the cache forever
+    if (m_images.size() >= maxNumImages)
+        m_images.clear();
+
+    m_images.emplace(key, image);
+    return image;
+}
+
+juce::MouseCursor IconCache::getMouseCursor(const char *svgbinary, juce::Point<int> hotSpot, float scale)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    const CursorKey key{svgbinary, hotSpot.x, hotSpot.y, juce::roundToInt(scale * 100.f)};
+    auto it = m_cursors.find(key);
+    if (it != m_cursors.end())
+        return it->second;
+
+    const auto size = static_cast<int>(24 * scale);
+    auto image = getImage(svgbinary, juce::Colours::white, {(float)size, (float)size}, 1.f);
+
+    auto hotX = juce::jlimit(0, juce::jmax(0, size - 1), static_cast<int>(scale * hotSpot.getX()));
+    auto hotY = juce::jlimit(0, juce::jmax(0, size - 1), static_cast<int>(scale * hotSpot.getY()));
+
+    juce::MouseCursor cursor = image.isValid() ? juce::MouseCursor(image, hotX, hotY) : juce::MouseCursor();
+    m_cursors.emplace(key, cursor);
+    return cursor;
+}
+
+void IconCache::clear()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    m_drawables.clear();
+    m_images.clear();
+    m_cursors.clear();
+}
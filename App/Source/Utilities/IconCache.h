@@ -0,0 +1,71 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <map>
+#include <memory>
+#include <tuple>
+
+// Process wide cache for the SVG icons in BinaryData. Every svg is parsed
+// once, recoloured drawables are kept per colour and rasterised images per
+// colour, size and display scale. The svg pointer is used as key, which is
+// fine as long as the data lives in BinaryData.
+// Drawables are components, so the cache is only used from the message
+// thread and needs no locking.
+class IconCache : private juce::DeletedAtShutdown
+{
+public:
+    IconCache() = default;
+    ~IconCache() override;
+
+    // Returns a drawable shared with the cache, it stays valid after clear().
+    // Don't change its transform, use createCopy() if you need to.
+    std::shared_ptr<const juce::Drawable> getDrawable(const char *svgbinary, juce::Colour colour);
+
+    // Returns the icon rendered into an image of drawRect's size times the
+    // given pixel scale.
+    juce::Image getImage(const char *svgbinary, juce::Colour colour, juce::Rectangle<float> drawRect, float pixelScale);
+
+    juce::MouseCursor getMouseCursor(const char *svgbinary, juce::Point<int> hotSpot, float scale);
+
+    // Drops everything, e.g. after loading a new theme.
+    void clear();
+
+    JUCE_DECLARE_SINGLETON(IconCache, false)
+
+private:
+    std::shared_ptr<const juce::Drawable> getParsedSvg(const char *svgbinary);
+
+    using DrawableKey = std::tuple<const char *, juce::uint32>;
+    using ImageKey = std::tuple<const char *, juce::uint32, int, int>;
+    using CursorKey = std::tuple<const char *, int, int, int>;
+
+    static constexpr size_t maxNumImages = 1024;
+
+    std::map<const char *, std::shared_ptr<const juce::Drawable>> m_parsedSvgs;
+    std::map<DrawableKey, std::shared_ptr<const juce::Drawable>> m_drawables;
+    std::map<ImageKey, juce::Image> m_images;
+    std::map<CursorKey, juce::MouseCursor> m_cursors;
+
+    JUCE_DECLARE_NON_COPYABLE(IconCache)
+};
@@ -0,0 +1,492 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#include "Utilities/LoudnessMeter.h"
+
+namespace
+{
+// The device manager's global output processor. It runs the processor set
+// with LoudnessMeter::setOutputProcessor() and then feeds the master meter,
+// so installing one doesn't throw the other away.
+class OutputTapProcessor : public juce::AudioProcessor
+{
+public:
+    OutputTapProcessor(std::shared_ptr<LoudnessMeter> meter, std::unique_ptr<juce::AudioProcessor> next)
+        : m_meterOwner(std::move(meter)),
+          m_meter(m_meterOwner.get()),
+          m_next(std::move(next))
+    {
+    }
+
+    // Starts measuring on an installed tap. The meter is prepared before the
+    // audio thread can see it, and it's only ever set once.
+    void setMeter(std::shared_ptr<LoudnessMeter> meter)
+    {
+        jassert(m_meterOwner == nullptr);
+        meter->prepare(m_sampleRate);
+        m_meterOwner = std::move(meter);
+        m_meter = m_meterOwner.get();
+    }
+
+    [[nodiscard]] std::shared_ptr<LoudnessMeter> getMeter() const { return m_meterOwner; }
+
+    const juce::String getName() const override { return "Output Tap"; }
+
+    void prepareToPlay(double sampleRate, int blockSize) override
+    {
+        m_sampleRate = sampleRate;
+
+        if (m_next != nullptr)
+            m_next->prepareToPlay(sampleRate, blockSize);
+
+        if (auto *meter = m_meter.load())
+            meter->prepare(sampleRate);
+    }
+
+    void releaseResources() override
+    {
+        if (m_next != nullptr)
+            m_next->releaseResources();
+    }
+
+    void processBlock(juce::AudioBuffer<float> &buffer, juce::MidiBuffer &midi) override
+    {
+        if (m_next != nullptr)
+            m_next->processBlock(buffer, midi);
+
+        // only measures, the output is left untouched
+        if (auto *meter = m_meter.load())
+            meter->process(buffer.getArrayOfReadPointers(), buffer.getNumChannels(), buffer.getNumSamples());
+    }
+
+    double getTailLengthSeconds() const override { return 0.0; }
+    bool acceptsMidi() const override { return false; }
+    bool producesMidi() const override { return false; }
+    juce::AudioProcessorEditor *createEditor() override { return nullptr; }
+    bool hasEditor() const override { return false; }
+    int getNumPrograms() override { return 1; }
+    int getCurrentProgram() override { return 0; }
+    void setCurrentProgram(int) override {}
+    const juce::String getProgramName(int) override { return {}; }
+    void changeProgramName(int, const juce::String &) override {}
+    void getStateInformation(juce::MemoryBlock &) override {}
+    void setStateInformation(const void *, int) override {}
+
+private:
+    std::shared_ptr<LoudnessMeter> m_meterOwner;
+    std::atomic<LoudnessMeter *> m_meter;
+    std::unique_ptr<juce::AudioProcessor> m_next;
+    std::atomic<double> m_sampleRate{48000.0};
+};
+
+// owned by the device manager, replaced as a whole when the chained
+// processor changes
+OutputTapProcessor *installedTap = nullptr;
+
+void installOutputTap(te::Engine &engine, std::shared_ptr<LoudnessMeter> meter, std::unique_ptr<juce::AudioProcessor> next)
+{
+    auto &dm = engine.getDeviceManager();
+
+    auto tap = std::make_unique<OutputTapProcessor>(std::move(meter), std::move(next));
+    tap->prepareToPlay(dm.getSampleRate(), dm.getBlockSize());
+
+    installedTap = tap.get();
+    dm.setGlobalOutputAudioProcessor(std::move(tap));
+}
+} // namespace
+
+LoudnessMeter::LoudnessMeter()
+{
+    // windowed sinc for 4x oversampling, cut off at the original Nyquist
+    const auto numTaps = (int) m_truePeakTaps.size();
+    const auto centre = (numTaps - 1) * 0.5;
+
+    for (int i = 0; i < numTaps; ++i)
+    {
+        auto t = (i - centre) / oversampling;
+        auto sinc = std::abs(t) < 1.0e-9 ? 1.0 : std::sin(juce::MathConstants<double>::pi * t) / (juce::MathConstants<double>::pi * t);
+        auto window = 0.5 - 0.5 * std::cos(2.0 * juce::MathConstants<double>::pi * (i + 0.5) / numTaps);
+        m_truePeakTaps[(size_t) i] = (float) (sinc * window);
+    }
+
+    prepare(48000.0);
+}
+
+void LoudnessMeter::prepare(double sampleRate)
+{
+    m_sampleRate = sampleRate > 0.0 ? sampleRate : 48000.0;
+    m_subBlockLength = juce::jmax(1, juce::roundToInt(m_sampleRate * 0.1));
+
+    // K-weighting as in BS.1770, computed for the actual rate
+    {
+        const double f0 = 1681.974450955533, gainDb = 3.999843853973347, q = 0.7071752369554196;
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / m_sampleRate);
+        const double vh = std::pow(10.0, gainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+
+        Biquad shelf;
+        shelf.b0 = (float) ((vh + vb * k / q + k * k) / a0);
+        shelf.b1 = (float) (2.0 * (k * k - vh) / a0);
+        shelf.b2 = (float) ((vh - vb * k / q + k * k) / a0);
+        shelf.a1 = (float) (2.0 * (k * k - 1.0) / a0);
+        shelf.a2 = (float) ((1.0 - k / q + k * k) / a0);
+        m_shelf.fill(shelf);
+    }
+    {
+        const double f0 = 38.13547087602444, q = 0.5003270373238773;
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / m_sampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+
+        Biquad highPass;
+        highPass.b0 = 1.0f;
+        highPass.b1 = -2.0f;
+        highPass.b2 = 1.0f;
+        highPass.a1 = (float) (2.0 * (k * k - 1.0) / a0);
+        highPass.a2 = (float) ((1.0 - k / q + k * k) / a0);
+        m_highPass.fill(highPass);
+    }
+
+    reset();
+}
+
+void LoudnessMeter::reset()
+{
+    for (auto &f : m_shelf)
+        f.z1 = f.z2 = 0.0f;
+    for (auto &f : m_highPass)
+        f.z1 = f.z2 = 0.0f;
+
+    m_subBlockSum.fill(0.0);
+    m_subBlockPosition = 0;
+    m_subBlockEnergies.fill(0.0);
+    m_subBlockIndex = 0;
+    m_numSubBlocks = 0;
+    m_momentaryHistogram.fill(0);
+    m_shortTermHistogram.fill(0);
+
+    for (auto &h : m_truePeakHistory)
+        h.fill(0.0f);
+    m_truePeakHistoryPos.fill(0);
+    m_truePeak = 0.0f;
+    m_maxMomentary = m_maxShortTerm = silence;
+
+    m_momentaryOut = m_shortTermOut = m_integratedOut = m_truePeakOut = silence;
+    m_maxMomentaryOut = m_maxShortTermOut = silence;
+    m_rangeOut = 0.0f;
+}
+
+void LoudnessMeter::process(const float *const *channels, int numChannels, int numSamples)
+{
+    if (m_resetRequested.exchange(false))
+        reset();
+
+    numChannels = juce::jmin(numChannels, maxChannels);
+    if (numChannels <= 0)
+        return;
+
+    const float *chunk[maxChannels] = {};
+
+    for (int offset = 0; offset < numSamples;)
+    {
+        // chunks never cross the end of a 100 ms sub-block
+        auto num = juce::jmin(numSamples - offset, scratchSize, m_subBlockLength - m_subBlockPosition);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            chunk[ch] = channels[ch] + offset;
+
+        processChunk(chunk, numChannels, num);
+
+        offset += num;
+        m_subBlockPosition += num;
+
+        if (m_subBlockPosition >= m_subBlockLength)
+            finishSubBlock();
+    }
+
+    m_truePeakOut = juce::Decibels::gainToDecibels(m_truePeak, silence);
+}
+
+void LoudnessMeter::processChunk(const float *const *channels, int numChannels, int numSamples)
+{
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto *scratch = m_scratch[(size_t) ch].data();
+
+        // the filters run over the whole chunk, the sum of squares is a
+        // plain loop the compiler vectorises
+        m_shelf[(size_t) ch].processBlock(channels[ch], scratch, numSamples);
+        m_highPass[(size_t) ch].processBlock(scratch, scratch, numSamples);
+
+        double sum = 0.0;
+        for (int i = 0; i < numSamples; ++i)
+            sum += scratch[i] * scratch[i];
+
+        m_subBlockSum[(size_t) ch] += sum;
+
+        updateTruePeak(channels[ch], ch, numSamples);
+    }
+}
+
+void LoudnessMeter::Biquad::processBlock(const float *input, float *output, int numSamples) noexcept
+{
+    // transposed direct form II, state kept in locals for the loop
+    auto s1 = z1, s2 = z2;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        auto x = input[i];
+        auto y = b0 * x + s1;
+        s1 = b1 * x - a1 * y + s2;
+        s2 = b2 * x - a2 * y;
+        output[i] = y;
+    }
+
+    // flush denormals when the input goes silent
+    z1 = std::abs(s1) < 1.0e-15f ? 0.0f : s1;
+    z2 = std::abs(s2) < 1.0e-15f ? 0.0f : s2;
+}
+
+void LoudnessMeter::updateTruePeak(const float *input, int channel, int numSamples)
+{
+    auto &history = m_truePeakHistory[(size_t) channel];
+    auto &pos = m_truePeakHistoryPos[(size_t) channel];
+    auto peak = m_truePeak;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        history[(size_t) pos] = history[(size_t) (pos + tapsPerPhase)] = input[i];
+        pos = (pos + 1) % tapsPerPhase;
+
+        // history[pos .. pos + tapsPerPhase) is oldest to newest
+        const auto *x = history.data() + pos;
+
+        for (int phase = 0; phase < oversampling; ++phase)
+        {
+            float y = 0.0f;
+            for (int k = 0; k < tapsPerPhase; ++k)
+                y += m_truePeakTaps[(size_t) (k * oversampling + phase)] * x[tapsPerPhase - 1 - k];
+
+            peak = juce::jmax(peak, std::abs(y));
+        }
+    }
+
+    m_truePeak = peak;
+}
+
+void LoudnessMeter::finishSubBlock()
+{
+    double energy = 0.0;
+    for (auto &sum : m_subBlockSum)
+        energy += sum / m_subBlockLength;
+
+    m_subBlockSum.fill(0.0);
+    m_subBlockPosition = 0;
+
+    m_subBlockEnergies[(size_t) m_subBlockIndex] = energy;
+    m_subBlockIndex = (m_subBlockIndex + 1) % numShortTermBlocks;
+    m_numSubBlocks = juce::jmin(m_numSubBlocks + 1, numShortTermBlocks);
+
+    auto meanOfLast = [this](int numBlocks)
+    {
+        numBlocks = juce::jmin(numBlocks, m_numSubBlocks);
+        double sum = 0.0;
+
+        for (int i = 1; i <= numBlocks; ++i)
+            sum += m_subBlockEnergies[(size_t) ((m_subBlockIndex - i + numShortTermBlocks) % numShortTermBlocks)];
+
+        return sum / juce::jmax(1, numBlocks);
+    };
+
+    // the 400 ms gating blocks overlap by 75%, so there is one per sub-block
+    if (m_numSubBlocks >= numMomentaryBlocks)
+    {
+        auto momentary = energyToLoudness(meanOfLast(numMomentaryBlocks));
+        m_momentaryOut = momentary;
+        m_maxMomentary = juce::jmax(m_maxMomentary, momentary);
+
+        if (momentary > -70.0f)
+            ++m_momentaryHistogram[(size_t) binForLoudness(momentary)];
+    }
+
+    if (m_numSubBlocks >= numShortTermBlocks)
+    {
+        auto shortTerm = energyToLoudness(meanOfLast(numShortTermBlocks));
+        m_shortTermOut = shortTerm;
+        m_maxShortTerm = juce::jmax(m_maxShortTerm, shortTerm);
+
+        if (shortTerm > -70.0f)
+            ++m_shortTermHistogram[(size_t) binForLoudness(shortTerm)];
+    }
+
+    m_maxMomentaryOut = m_maxMomentary;
+    m_maxShortTermOut = m_maxShortTerm;
+
+    updateGatedValues();
+}
+
+void LoudnessMeter::updateGatedValues()
+{
+    // integrated: absolute gate at -70 LUFS (already applied when counting),
+    // relative gate 10 LU below the loudness of everything above it
+    {
+        double sum = 0.0;
+        int count = 0;
+
+        for (int i = 0; i < numHistogramBins; ++i)
+        {
+            sum += m_momentaryHistogram[(size_t) i] * loudnessToEnergy(loudnessForBin(i));
+            count += m_momentaryHistogram[(size_t) i];
+        }
+
+        if (count > 0)
+        {
+            auto firstBin = juce::jlimit(0, numHistogramBins, binForLoudness(energyToLoudness(sum / count) - 10.0f));
+            sum = 0.0;
+            count = 0;
+
+            for (int i = firstBin; i < numHistogramBins; ++i)
+            {
+                sum += m_momentaryHistogram[(size_t) i] * loudnessToEnergy(loudnessForBin(i));
+                count += m_momentaryHistogram[(size_t) i];
+            }
+
+            m_integratedOut = count > 0 ? energyToLoudness(sum / count) : silence;
+        }
+    }
+
+    // loudness range: short-term values above a relative gate 20 LU down,
+    // from the 10th to the 95th percentile
+    {
+        double sum = 0.0;
+        int count = 0;
+
+        for (int i = 0; i < numHistogramBins; ++i)
+        {
+            sum += m_shortTermHistogram[(size_t) i] * loudnessToEnergy(loudnessForBin(i));
+            count += m_shortTermHistogram[(size_t) i];
+        }
+
+        if (count == 0)
+            return;
+
+        auto firstBin = juce::jlimit(0, numHistogramBins, binForLoudness(energyToLoudness(sum / count) - 20.0f));
+        count = 0;
+
+        for (int i = firstBin; i < numHistogramBins; ++i)
+            count += m_shortTermHistogram[(size_t) i];
+
+        if (count == 0)
+            return;
+
+        auto low = silence, high = silence;
+        int cumulative = 0;
+
+        for (int i = firstBin; i < numHistogramBins; ++i)
+        {
+            cumulative += m_shortTermHistogram[(size_t) i];
+
+            if (low == silence && cumulative >= 0.10 * count)
+                low = loudnessForBin(i);
+
+            if (cumulative >= 0.95 * count)
+            {
+                high = loudnessForBin(i);
+                break;
+            }
+        }
+
+        m_rangeOut = juce::jmax(0.0f, high - low);
+    }
+}
+
+LoudnessMeter::Values LoudnessMeter::getValues() const
+{
+    Values v;
+    v.momentary = m_momentaryOut;
+    v.shortTerm = m_shortTermOut;
+    v.integrated = m_integratedOut;
+    v.range = m_rangeOut;
+    v.truePeak = m_truePeakOut;
+    v.maxMomentary = m_maxMomentaryOut;
+    v.maxShortTerm = m_maxShortTermOut;
+    return v;
+}
+
+float LoudnessMeter::energyToLoudness(double energy) { return energy > 0.0 ? (float) juce::jmax((double) silence, -0.691 + 10.0 * std::log10(energy)) : silence; }
+
+double LoudnessMeter::loudnessToEnergy(float loudness) { return std::pow(10.0, (loudness + 0.691) / 10.0); }
+
+int LoudnessMeter::binForLoudness(float loudness) { return juce::jlimit(0, numHistogramBins - 1, (int) ((loudness + 70.0f) * 10.0f)); }
+
+float LoudnessMeter::loudnessForBin(int bin) { return -70.0f + (bin + 0.5f) / 10.0f; }
+
+bool LoudnessMeter::analyseFile(const juce::File &file, juce::AudioFormatManager &formatManager, Values &result, const std::function<bool()> &shouldExit)
+{
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+    if (reader == nullptr || reader->sampleRate <= 0.0)
+        return false;
+
+    LoudnessMeter meter;
+    meter.prepare(reader->sampleRate);
+
+    const int blockSize = 16384;
+    juce::AudioBuffer<float> buffer((int) juce::jmin(2u, reader->numChannels), blockSize);
+
+    for (juce::int64 pos = 0; pos < reader->lengthInSamples; pos += blockSize)
+    {
+        if (shouldExit && shouldExit())
+            return false;
+
+        auto numSamples = (int) juce::jmin((juce::int64) blockSize, reader->lengthInSamples - pos);
+        reader->read(&buffer, 0, numSamples, pos, true, true);
+        meter.process(buffer.getArrayOfReadPointers(), buffer.getNumChannels(), numSamples);
+    }
+
+    result = meter.getValues();
+    return true;
+}
+
+std::shared_ptr<LoudnessMeter> LoudnessMeter::getMasterOutputMeter(te::Engine &engine)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (installedTap != nullptr)
+        if (auto meter = installedTap->getMeter())
+            return meter;
+
+    auto meter = std::make_shared<LoudnessMeter>();
+
+    if (installedTap != nullptr)
+        installedTap->setMeter(meter);
+    else
+        installOutputTap(engine, meter, nullptr);
+
+    return meter;
+}
+
+void LoudnessMeter::setOutputProcessor(te::Engine &engine, std::unique_ptr<juce::AudioProcessor> processor)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    // the new tap keeps measuring into the same meter
+    installOutputTap(engine, installedTap != nullptr ? installedTap->getMeter() : nullptr, std::move(processor));
+}
@@ -0,0 +1,133 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <array>
+
+namespace te = tracktion_engine;
+
+// EBU R128 / ITU-R BS.1770 loudness meter for up to two channels: momentary
+// (400 ms), short-term (3 s) and gated integrated loudness, loudness range
+// and true peak. process() is realtime safe: the gating history is kept in
+// fixed size histograms with 0.1 LU resolution, and the results are published
+// through atomics, so any thread can read them while audio is processed.
+class LoudnessMeter
+{
+public:
+    static constexpr float silence = -100.0f;
+
+    struct Values
+    {
+        float momentary = silence;    // LUFS
+        float shortTerm = silence;    // LUFS
+        float integrated = silence;   // LUFS
+        float range = 0.0f;           // LU
+        float truePeak = silence;     // dBTP
+        float maxMomentary = silence; // LUFS
+        float maxShortTerm = silence; // LUFS
+    };
+
+    LoudnessMeter();
+
+    // Sets the filters up for the sample rate and clears all measurements.
+    void prepare(double sampleRate);
+    void process(const float *const *channels, int numChannels, int numSamples);
+
+    Values getValues() const;
+
+    // Clears the measurement at the start of the next process() call.
+    void requestReset() { m_resetRequested = true; }
+
+    // Measures a whole file, e.g. a finished bounce. Returns false if the file
+    // can't be read or shouldExit returned true.
+    static bool analyseFile(const juce::File &file, juce::AudioFormatManager &formatManager, Values &result, const std::function<bool()> &shouldExit = {});
+
+    // The meter fed with the engine's device output, that is the master bus
+    // plus the click. Sample previews have their own device callback and
+    // aren't measured. tracktion has no hook on the master track's output
+    // short of a plugin in the edit, so the meter sits in the device manager's
+    // global output processor, installed on first use.
+    static std::shared_ptr<LoudnessMeter> getMasterOutputMeter(te::Engine &engine);
+
+    // Sets the processor for the device output. Use this instead of
+    // te::DeviceManager::setGlobalOutputAudioProcessor(), which would replace
+    // the master meter; the processor runs first and the meter measures its
+    // output.
+    static void setOutputProcessor(te::Engine &engine, std::unique_ptr<juce::AudioProcessor> processor);
+
+private:
+    struct Biquad
+    {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+        float z1 = 0.0f, z2 = 0.0f;
+
+        void processBlock(const float *input, float *output, int numSamples) noexcept;
+    };
+
+    static constexpr int maxChannels = 2;
+    static constexpr int scratchSize = 1024;
+    static constexpr int numHistogramBins = 800; // -70 .. +10 LUFS
+    static constexpr int numShortTermBlocks = 30;
+    static constexpr int numMomentaryBlocks = 4;
+    static constexpr int oversampling = 4;
+    static constexpr int tapsPerPhase = 12;
+
+    void reset();
+    void processChunk(const float *const *channels, int numChannels, int numSamples);
+    void updateTruePeak(const float *input, int channel, int numSamples);
+    void finishSubBlock();
+    void updateGatedValues();
+
+    static float energyToLoudness(double energy);
+    static double loudnessToEnergy(float loudness);
+    static int binForLoudness(float loudness);
+    static float loudnessForBin(int bin);
+
+    double m_sampleRate = 48000.0;
+    int m_subBlockLength = 4800; // 100 ms
+    int m_subBlockPosition = 0;
+
+    std::array<Biquad, maxChannels> m_shelf, m_highPass;
+    std::array<double, maxChannels> m_subBlockSum{};
+    std::array<std::array<float, scratchSize>, maxChannels> m_scratch{};
+
+    std::array<double, numShortTermBlocks> m_subBlockEnergies{};
+    int m_subBlockIndex = 0;
+    int m_numSubBlocks = 0;
+
+    std::array<int, numHistogramBins> m_momentaryHistogram{}, m_shortTermHistogram{};
+
+    // 4x oversampling interpolator, the history is stored twice so every
+    // phase can run over a contiguous block
+    std::array<float, oversampling * tapsPerPhase> m_truePeakTaps{};
+    std::array<std::array<float, tapsPerPhase * 2>, maxChannels> m_truePeakHistory{};
+    std::array<int, maxChannels> m_truePeakHistoryPos{};
+    float m_truePeak = 0.0f;
+    float m_maxMomentary = silence, m_maxShortTerm = silence;
+
+    std::atomic<float> m_momentaryOut{silence}, m_shortTermOut{silence}, m_integratedOut{silence}, m_rangeOut{0.0f}, m_truePeakOut{silence};
+    std::atomic<float> m_maxMomentaryOut{silence}, m_maxShortTermOut{silence};
+    std::atomic<bool> m_resetRequested{false};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoudnessMeter)
+};
@@ -0,0 +1,158 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#include "Utilities/MeterHub.h"
+
+JUCE_IMPLEMENT_SINGLETON(MeterHub)
+
+void MeterHub::Client::startMeterUpdates(juce::Component &component) { MeterHub::getInstance()->add(*this, component); }
+
+void MeterHub::Client::stopMeterUpdates()
+{
+    if (auto *hub = MeterHub::getInstanceWithoutCreating())
+        hub->remove(*this);
+}
+
+MeterHub::~MeterHub()
+{
+    stopTimer();
+    m_vblank.reset();
+    clearSingletonInstance();
+}
+
+void MeterHub::add(Client &client, juce::Component &component)
+{
+    for (auto &r : m_clients)
+    {
+        if (r.client == &client)
+        {
+            r.component = &component;
+            return;
+        }
+    }
+
+    m_clients.add({&client, &component});
+    updateClock();
+}
+
+void MeterHub::remove(Client &client)
+{
+    // removal during a pass only clears the slot, tick() compacts the array
+    for (auto &r : m_clients)
+        if (r.client == &client)
+            r.client = nullptr;
+}
+
+void MeterHub::timerCallback()
+{
+    // the fallback only ticks if the vblank went quiet, e.g. when the window
+    // is minimised or on another display
+    if (juce::Time::getMillisecondCounterHiRes() - m_lastVBlank > 100.0)
+        tick();
+
+    updateClock();
+}
+
+void MeterHub::tick()
+{
+    auto now = juce::Time::getMillisecondCounterHiRes();
+
+    // vblank usually comes at 60Hz or more, meters don't need that
+    if (now - m_lastTick < 1000.0 / frameRateHz - 4.0)
+        return;
+
+    m_lastTick = now;
+
+    for (int i = 0; i < m_clients.size(); ++i)
+    {
+        auto r = m_clients[i];
+        if (r.client == nullptr || r.component == nullptr || !isOnScreen(*r.component))
+            continue;
+
+        if (r.client->meterTick())
+            m_toRepaint.add(r.component);
+    }
+
+    m_clients.removeIf([](const Registration &r) { return r.client == nullptr || r.component == nullptr; });
+
+    for (auto &component : m_toRepaint)
+        if (component != nullptr)
+            component->repaint();
+
+    m_toRepaint.clearQuick();
+}
+
+void MeterHub::updateClock()
+{
+    if (m_clients.isEmpty())
+    {
+        stopTimer();
+        m_vblank.reset();
+        m_vblankComponent = nullptr;
+        return;
+    }
+
+    if (!isTimerRunning())
+        startTimerHz(frameRateHz);
+
+    // follow the window most clients are likely in, the first showing one
+    juce::Component *window = nullptr;
+    for (auto &r : m_clients)
+    {
+        if (r.client != nullptr && r.component != nullptr && r.component->isShowing())
+        {
+            window = r.component->getTopLevelComponent();
+            break;
+        }
+    }
+
+    if (window == nullptr || window == m_vblankComponent.getComponent())
+        return;
+
+    m_vblankComponent = window;
+    m_vblank = std::make_unique<juce::VBlankAttachment>(window,
+                                                        [this]
+                                                        {
+                                                            m_lastVBlank = juce::Time::getMillisecondCounterHiRes();
+                                                            tick();
+                                                        });
+}
+
+bool MeterHub::isOnScreen(juce::Component &component)
+{
+    if (!component.isShowing())
+        return false;
+
+    // clip against every parent, so meters in a scrolled viewport that
+    // aren't in view are skipped
+    auto area = component.getLocalBounds();
+
+    for (auto *c = &component; c->getParentComponent() != nullptr; c = c->getParentComponent())
+    {
+        auto *parent = c->getParentComponent();
+        area = parent->getLocalArea(c, area).getIntersection(parent->getLocalBounds());
+
+        if (area.isEmpty())
+            return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,80 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+// One clock for all meters and visualisations. Instead of every meter running
+// its own timer, components derive from MeterHub::Client and are polled in a
+// single pass at frameRateHz. The pass is driven by the vertical blank of the
+// window the clients are shown in, with a timer as fallback while there is no
+// vblank. Clients that are hidden or scrolled out of view are skipped, and
+// the repaints of a pass are issued together at its end.
+class MeterHub
+    : private juce::Timer
+    , private juce::DeletedAtShutdown
+{
+public:
+    class Client
+    {
+    public:
+        virtual ~Client() { stopMeterUpdates(); }
+
+        // Reads the source. Return true if the component needs a repaint.
+        virtual bool meterTick() = 0;
+
+    protected:
+        void startMeterUpdates(juce::Component &component);
+        void stopMeterUpdates();
+    };
+
+    MeterHub() = default;
+    ~MeterHub() override;
+
+    void add(Client &client, juce::Component &component);
+    void remove(Client &client);
+
+    static constexpr int frameRateHz = 30;
+
+    JUCE_DECLARE_SINGLETON(MeterHub, false)
+
+private:
+    struct Registration
+    {
+        Client *client;
+        juce::Component::SafePointer<juce::Component> component;
+    };
+
+    void timerCallback() override;
+    void tick();
+    void updateClock();
+    static bool isOnScreen(juce::Component &component);
+
+    juce::Array<Registration> m_clients;
+    juce::Array<juce::Component::SafePointer<juce::Component>> m_toRepaint;
+    juce::Component::SafePointer<juce::Component> m_vblankComponent;
+    std::unique_ptr<juce::VBlankAttachment> m_vblank;
+    double m_lastTick = 0.0;
+    double m_lastVBlank = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE(MeterHub)
+};
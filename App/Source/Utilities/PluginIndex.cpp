@@ -0,0 +1,201 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#include "Utilities/PluginIndex.h"
+
+namespace
+{
+void addTokens(juce::StringArray &tokens, const juce::String &text)
+{
+    juce::StringArray words;
+    words.addTokens(text.toLowerCase(), " -_.,()[]", "");
+    words.removeEmptyStrings();
+
+    for (auto &w : words)
+        tokens.addIfNotAlreadyThere(w);
+}
+} // namespace
+
+void PluginIndex::rebuild(juce::KnownPluginList &list, const juce::Array<juce::PluginDescription> &extraTypes)
+{
+    m_entries.clear();
+    m_blacklist.clear();
+
+    for (auto &file : list.getBlacklistedFiles())
+        m_blacklist.insert(file);
+
+    auto types = list.getTypes();
+    types.addArray(extraTypes);
+
+    m_entries.reserve((size_t) types.size());
+
+    for (auto &desc : types)
+    {
+        Entry entry;
+        entry.desc = desc;
+        entry.lowerName = desc.name.toLowerCase();
+        entry.identifier = desc.createIdentifierString();
+        entry.isBlacklisted = isBlacklisted(desc.fileOrIdentifier);
+
+        addTokens(entry.tokens, desc.name);
+        addTokens(entry.tokens, desc.manufacturerName);
+        addTokens(entry.tokens, desc.category);
+        addTokens(entry.tokens, desc.isInstrument ? "instrument synth" : "effect fx");
+
+        m_entries.push_back(std::move(entry));
+    }
+}
+
+std::vector<int> PluginIndex::search(const juce::String &query, const std::function<bool(const Entry &)> &filter, const std::vector<int> *candidates, const juce::StringArray &recentlyUsed) const
+{
+    const auto lowerQuery = query.trim().toLowerCase();
+
+    juce::StringArray queryWords;
+    queryWords.addTokens(lowerQuery, " ", "");
+    queryWords.removeEmptyStrings();
+
+    struct Match
+    {
+        int index;
+        int score;
+        int recentRank;
+    };
+
+    std::vector<Match> matches;
+
+    auto check = [&](int index)
+    {
+        const auto &entry = m_entries[(size_t) index];
+        if (filter != nullptr && !filter(entry))
+            return;
+
+        auto score = queryWords.isEmpty() ? 1 : getMatchScore(entry, lowerQuery, queryWords);
+        if (score <= 0)
+            return;
+
+        auto recentRank = recentlyUsed.indexOf(entry.identifier);
+        matches.push_back({index, score, recentRank < 0 ? maxRecentlyUsed : recentRank});
+    };
+
+    if (candidates != nullptr)
+    {
+        for (auto index : *candidates)
+            if (index >= 0 && index < (int) m_entries.size())
+                check(index);
+    }
+    else
+    {
+        for (int i = 0; i < (int) m_entries.size(); ++i)
+            check(i);
+    }
+
+    if (queryWords.size() > 0)
+    {
+        std::stable_sort(matches.begin(), matches.end(),
+                         [](const Match &a, const Match &b)
+                         {
+                             if (a.score != b.score)
+                                 return a.score > b.score;
+
+                             return a.recentRank < b.recentRank;
+                         });
+    }
+
+    std::vector<int> result;
+    result.reserve(matches.size());
+
+    for (auto &m : matches)
+        result.push_back(m.index);
+
+    return result;
+}
+
+juce::StringArray PluginIndex::getRecentlyUsed(ApplicationViewState &appState) { return juce::StringArray::fromLines(appState.m_recentPlugins.get()); }
+
+void PluginIndex::addRecentlyUsed(ApplicationViewState &appState, const juce::PluginDescription &desc)
+{
+    auto recent = getRecentlyUsed(appState);
+    auto identifier = desc.createIdentifierString();
+
+    recent.removeString(identifier);
+    recent.insert(0, identifier);
+    recent.removeEmptyStrings();
+
+    while (recent.size() > maxRecentlyUsed)
+        recent.remove(recent.size() - 1);
+
+    appState.m_recentPlugins = recent.joinIntoString("\n");
+}
+
+int PluginIndex::getMatchScore(const Entry &entry, const juce::String &lowerQuery, const juce::StringArray &queryWords)
+{
+    int score = 0;
+
+    // every word has to match somewhere
+    for (auto &word : queryWords)
+    {
+        auto wordScore = getWordScore(entry, word);
+        if (wordScore == 0)
+            return 0;
+
+        score += wordScore;
+    }
+
+    if (entry.lowerName == lowerQuery)
+        score += 200;
+    else if (entry.lowerName.startsWith(lowerQuery))
+        score += 100;
+
+    return score;
+}
+
+int PluginIndex::getWordScore(const Entry &entry, const juce::String &word)
+{
+    for (auto &token : entry.tokens)
+        if (token.startsWith(word))
+            return 40;
+
+    if (entry.lowerName.contains(word))
+        return 20;
+
+    if (isSubsequence(entry.lowerName, word))
+        return 5;
+
+    return 0;
+}
+
+bool PluginIndex::isSubsequence(const juce::String &text, const juce::String &word)
+{
+    auto t = text.getCharPointer();
+
+    for (auto w = word.getCharPointer(); !w.isEmpty(); ++w)
+    {
+        while (!t.isEmpty() && *t != *w)
+            ++t;
+
+        if (t.isEmpty())
+            return false;
+
+        ++t;
+    }
+
+    return true;
+}
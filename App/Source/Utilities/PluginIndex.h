@@ -0,0 +1,70 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "Utilities/ApplicationViewState.h"
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+// Searchable snapshot of the known plugins plus the built in ones. Names,
+// manufacturers and categories are split into lower case tokens once when
+// the index is built, so searching doesn't touch the KnownPluginList at all.
+// Results are ranked by match quality first and recent use second.
+class PluginIndex
+{
+public:
+    struct Entry
+    {
+        juce::PluginDescription desc;
+        juce::String lowerName;
+        juce::StringArray tokens;
+        juce::String identifier;
+        bool isBlacklisted = false;
+    };
+
+    void rebuild(juce::KnownPluginList &list, const juce::Array<juce::PluginDescription> &extraTypes);
+
+    const std::vector<Entry> &getEntries() const { return m_entries; }
+    bool isBlacklisted(const juce::String &fileOrIdentifier) const { return m_blacklist.count(fileOrIdentifier) > 0; }
+
+    // Returns indices into getEntries(), best match first. An empty query
+    // returns every entry passing the filter in index order. If candidates
+    // is given, only those entries are looked at, e.g. the results of a
+    // shorter query while the user is typing.
+    std::vector<int> search(const juce::String &query, const std::function<bool(const Entry &)> &filter, const std::vector<int> *candidates, const juce::StringArray &recentlyUsed) const;
+
+    // Most recently used first, stored in the application settings.
+    static juce::StringArray getRecentlyUsed(ApplicationViewState &appState);
+    static void addRecentlyUsed(ApplicationViewState &appState, const juce::PluginDescription &desc);
+
+private:
+    static int getMatchScore(const Entry &entry, const juce::String &lowerQuery, const juce::StringArray &queryWords);
+    static int getWordScore(const Entry &entry, const juce::String &word);
+    static bool isSubsequence(const juce::String &text, const juce::String &word);
+
+    static constexpr int maxRecentlyUsed = 32;
+
+    std::vector<Entry> m_entries;
+    std::unordered_set<juce::String> m_blacklist;
+};
@@ -0,0 +1,192 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#include "Utilities/PluginPreloader.h"
+#include "Utilities/Utilities.h"
+
+PluginPreloader::PluginPreloader(te::Engine &engine, double sampleRate, int blockSize)
+    : m_engine(engine),
+      m_sampleRate(sampleRate > 0.0 ? sampleRate : 44100.0),
+      m_blockSize(blockSize > 0 ? blockSize : 512),
+      m_knownTypes(engine.getPluginManager().knownPluginList.getTypes())
+{
+}
+
+void PluginPreloader::prepare(const juce::ValueTree &editState)
+{
+    juce::Array<juce::ValueTree> plugins;
+    findExternalPlugins(editState, plugins);
+
+    m_binaries.clear();
+    m_timings.clear();
+    m_nextBinary = 0;
+    m_totalMs = 0.0;
+
+    for (const auto &plugin : plugins)
+    {
+        auto desc = findDescription(plugin);
+        auto *format = desc ? findFormat(*desc) : nullptr;
+
+        if (format == nullptr)
+        {
+            Timing timing;
+            timing.name = plugin[te::IDs::name].toString();
+            timing.numInstances = 1;
+            timing.failed = true;
+            m_timings.push_back(timing);
+            m_binaries.push_back({});
+            continue;
+        }
+
+        // shell plugins share one binary, it's only loaded once
+        auto existing = std::find_if(m_binaries.begin(), m_binaries.end(), [&](const Binary &b) { return b.format == format && b.description.fileOrIdentifier == desc->fileOrIdentifier; });
+
+        if (existing != m_binaries.end())
+        {
+            ++m_timings[static_cast<size_t>(std::distance(m_binaries.begin(), existing))].numInstances;
+            continue;
+        }
+
+        Timing timing;
+        timing.name = desc->name;
+        timing.numInstances = 1;
+        m_timings.push_back(timing);
+        m_binaries.push_back({*desc, format});
+    }
+}
+
+bool PluginPreloader::loadNext()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    while (m_nextBinary < m_binaries.size())
+    {
+        const auto index = m_nextBinary++;
+        auto &binary = m_binaries[index];
+        auto &timing = m_timings[index];
+
+        if (binary.format == nullptr)
+            continue;
+
+        if (binary.format->requiresUnblockedMessageThreadDuringCreation(binary.description))
+        {
+            timing.leftToEdit = true;
+            continue;
+        }
+
+        const auto start = juce::Time::getMillisecondCounterHiRes();
+        juce::String error;
+        auto instance = binary.format->createInstanceFromDescription(binary.description, m_sampleRate, m_blockSize, error);
+
+        if (instance == nullptr)
+        {
+            timing.failed = true;
+            GUIHelpers::log("PluginPreloader: could not load " + binary.description.name + ": " + error);
+        }
+
+        // the module stays loaded as long as an instance of it is alive
+        if (instance != nullptr)
+            m_instances.push_back(std::move(instance));
+
+        timing.createMs = juce::Time::getMillisecondCounterHiRes() - start;
+        m_totalMs += timing.createMs;
+
+        return m_nextBinary < m_binaries.size();
+    }
+
+    return false;
+}
+
+float PluginPreloader::getProgress() const
+{
+    if (m_binaries.empty())
+        return 1.0f;
+
+    return static_cast<float>(m_nextBinary) / static_cast<float>(m_binaries.size());
+}
+
+void PluginPreloader::releaseInstances()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    m_instances.clear();
+}
+
+void PluginPreloader::logTimings() const
+{
+    if (m_timings.empty())
+        return;
+
+    auto sorted = m_timings;
+    std::sort(sorted.begin(), sorted.end(), [](const Timing &a, const Timing &b) { return a.createMs > b.createMs; });
+
+    const auto numLeftToEdit = std::count_if(sorted.begin(), sorted.end(), [](const Timing &t) { return t.leftToEdit; });
+
+    GUIHelpers::log("PluginPreloader: " + juce::String(static_cast<int>(sorted.size())) + " plugin binaries loaded in " + juce::String(m_totalMs / 1000.0, 2) + " s, " + juce::String(static_cast<int>(numLeftToEdit)) + " left to the edit");
+
+    for (const auto &t : sorted)
+    {
+        const auto instances = " (" + juce::String(t.numInstances) + (t.numInstances == 1 ? " instance)" : " instances)");
+
+        if (t.leftToEdit)
+            GUIHelpers::log("  left to edit    " + t.name + instances);
+        else if (t.failed)
+            GUIHelpers::log("  failed          " + t.name + instances);
+        else
+            GUIHelpers::log("  " + juce::String(t.createMs, 1).paddedLeft(' ', 8) + " ms  " + t.name + instances);
+    }
+}
+
+void PluginPreloader::findExternalPlugins(const juce::ValueTree &node, juce::Array<juce::ValueTree> &plugins)
+{
+    if (node.hasType(te::IDs::PLUGIN) && node[te::IDs::type].toString() == te::ExternalPlugin::xmlTypeName)
+        plugins.add(node);
+
+    for (const auto &child : node)
+        findExternalPlugins(child, plugins);
+}
+
+std::optional<juce::PluginDescription> PluginPreloader::findDescription(const juce::ValueTree &pluginState) const
+{
+    const auto file = pluginState[te::IDs::filename].toString();
+    const auto uniqueId = pluginState[te::IDs::uniqueId].toString().getHexValue32();
+
+    // shell plugins share one file, the id tells them apart
+    for (const auto &desc : m_knownTypes)
+        if (desc.fileOrIdentifier == file && (uniqueId == 0 || desc.uniqueId == uniqueId))
+            return desc;
+
+    const auto name = pluginState[te::IDs::name].toString();
+
+    for (const auto &desc : m_knownTypes)
+        if (desc.name == name)
+            return desc;
+
+    return std::nullopt;
+}
+
+juce::AudioPluginFormat *PluginPreloader::findFormat(const juce::PluginDescription &desc) const
+{
+    for (auto *format : m_engine.getPluginManager().pluginFormatManager.getFormats())
+        if (format->getName() == desc.pluginFormatName)
+            return format;
+
+    return nullptr;
+}
@@ -0,0 +1,88 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+namespace te = tracktion_engine;
+
+// Loads the plugin binaries an edit state uses before the te::Edit is built
+// from it, and reports how long each one takes. tracktion's ExternalPlugin
+// creates its own instance and can't take a ready-made one, so a preloaded
+// instance with restored state would only be thrown away and created again.
+// Instead one instance per distinct binary is created without its state and
+// kept until releaseInstances() is called. JUCE frees a module with its last
+// instance, so the caller keeps them alive until the Edit has created its own
+// and those find the module already loaded. JUCE routes the creation through
+// the message thread anyway, so this runs there, one binary per call, between
+// progress updates.
+class PluginPreloader
+{
+public:
+    struct Timing
+    {
+        juce::String name;
+        int numInstances = 0;
+        double createMs = 0.0;
+        bool leftToEdit = false; // needs an unblocked message thread to be created
+        bool failed = false;
+    };
+
+    PluginPreloader(te::Engine &engine, double sampleRate, int blockSize);
+
+    // Finds the binaries to load. Can be called on any thread.
+    void prepare(const juce::ValueTree &editState);
+
+    // Loads the next binary, returns false once all are done. Message thread only.
+    bool loadNext();
+    [[nodiscard]] float getProgress() const;
+
+    // Deletes the preloaded instances, call it once the Edit has been created.
+    void releaseInstances();
+
+    [[nodiscard]] const std::vector<Timing> &getTimings() const { return m_timings; }
+    void logTimings() const;
+
+private:
+    struct Binary
+    {
+        juce::PluginDescription description;
+        juce::AudioPluginFormat *format = nullptr;
+    };
+
+    static void findExternalPlugins(const juce::ValueTree &node, juce::Array<juce::ValueTree> &plugins);
+    std::optional<juce::PluginDescription> findDescription(const juce::ValueTree &pluginState) const;
+    juce::AudioPluginFormat *findFormat(const juce::PluginDescription &desc) const;
+
+    te::Engine &m_engine;
+    double m_sampleRate;
+    int m_blockSize;
+    juce::Array<juce::PluginDescription> m_knownTypes;
+
+    std::vector<Binary> m_binaries;
+    std::vector<Timing> m_timings; // parallel to m_binaries
+    std::vector<std::unique_ptr<juce::AudioPluginInstance>> m_instances;
+    size_t m_nextBinary = 0;
+    double m_totalMs = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginPreloader)
+};
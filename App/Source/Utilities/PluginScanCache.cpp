@@ -0,0 +1,142 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#include "Utilities/PluginScanCache.h"
+
+PluginScanCache::PluginScanCache(const juce::File &cacheFile)
+    : m_file(cacheFile)
+{
+    load();
+}
+
+juce::File PluginScanCache::getDefaultFile(te::Engine &engine) { return engine.getPropertyStorage().getPropertiesFile().getFile().getSiblingFile("PluginScanCache.xml"); }
+
+bool PluginScanCache::lookup(const juce::String &formatName, const juce::String &fileOrIdentifier, juce::OwnedArray<juce::PluginDescription> &results, bool &failed) const
+{
+    if (!isCacheable(fileOrIdentifier))
+        return false;
+
+    const juce::ScopedLock sl(m_lock);
+
+    auto it = m_entries.find(makeKey(formatName, fileOrIdentifier));
+    if (it == m_entries.end())
+        return false;
+
+    const juce::File file(fileOrIdentifier);
+    const auto &entry = it->second;
+
+    if (entry.size != file.getSize() || entry.modified != file.getLastModificationTime().toMilliseconds())
+        return false;
+
+    for (auto &desc : entry.types)
+        results.add(new juce::PluginDescription(desc));
+
+    failed = entry.failed;
+    return true;
+}
+
+void PluginScanCache::store(const juce::String &formatName, const juce::String &fileOrIdentifier, const juce::OwnedArray<juce::PluginDescription> &results, bool failed)
+{
+    if (!isCacheable(fileOrIdentifier))
+        return;
+
+    const juce::File file(fileOrIdentifier);
+
+    Entry entry;
+    entry.size = file.getSize();
+    entry.modified = file.getLastModificationTime().toMilliseconds();
+    entry.failed = failed;
+
+    for (auto *desc : results)
+        entry.types.add(*desc);
+
+    const juce::ScopedLock sl(m_lock);
+    m_entries[makeKey(formatName, fileOrIdentifier)] = std::move(entry);
+    m_needsSaving = true;
+}
+
+void PluginScanCache::save()
+{
+    const juce::ScopedLock sl(m_lock);
+
+    if (!m_needsSaving)
+        return;
+
+    juce::XmlElement xml("PLUGINSCANCACHE");
+
+    for (auto &[key, entry] : m_entries)
+    {
+        auto *e = xml.createNewChildElement("FILE");
+        e->setAttribute("key", key);
+        e->setAttribute("size", juce::String(entry.size));
+        e->setAttribute("modified", juce::String(entry.modified));
+        e->setAttribute("failed", entry.failed);
+
+        for (auto &desc : entry.types)
+            e->addChildElement(desc.createXml().release());
+    }
+
+    if (xml.writeTo(m_file, {}))
+        m_needsSaving = false;
+    else
+        juce::Logger::writeToLog("PluginScanCache: couldn't write " + m_file.getFullPathName());
+}
+
+void PluginScanCache::clear()
+{
+    const juce::ScopedLock sl(m_lock);
+
+    m_entries.clear();
+    m_needsSaving = false;
+    m_file.deleteFile();
+}
+
+bool PluginScanCache::isCacheable(const juce::String &fileOrIdentifier)
+{
+    // AudioUnits and the like are identified by name, there's no file to compare
+    return juce::File::isAbsolutePath(fileOrIdentifier) && juce::File(fileOrIdentifier).exists();
+}
+
+juce::String PluginScanCache::makeKey(const juce::String &formatName, const juce::String &fileOrIdentifier) { return formatName + "|" + fileOrIdentifier; }
+
+void PluginScanCache::load()
+{
+    auto xml = juce::XmlDocument::parse(m_file);
+    if (xml == nullptr || !xml->hasTagName("PLUGINSCANCACHE"))
+        return;
+
+    for (auto *e : xml->getChildWithTagNameIterator("FILE"))
+    {
+        Entry entry;
+        entry.size = e->getStringAttribute("size").getLargeIntValue();
+        entry.modified = e->getStringAttribute("modified").getLargeIntValue();
+        entry.failed = e->getBoolAttribute("failed");
+
+        for (auto *d : e->getChildIterator())
+        {
+            juce::PluginDescription desc;
+            if (desc.loadFromXml(*d))
+                entry.types.add(desc);
+        }
+
+        m_entries[e->getStringAttribute("key")] = std::move(entry);
+    }
+}
@@ -0,0 +1,67 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <map>
+
+namespace te = tracktion_engine;
+
+// Remembers what probing a plugin file found, keyed by format, path, file
+// size and modification time. Files that didn't change since they were
+// probed are answered from the cache, including the ones that failed or
+// crashed the scanner, so a rescan only touches new or updated plugins.
+class PluginScanCache
+{
+public:
+    explicit PluginScanCache(const juce::File &cacheFile);
+
+    static juce::File getDefaultFile(te::Engine &engine);
+
+    // Returns false if the file isn't cached or changed since. Otherwise
+    // results holds the cached types and failed tells if the probe failed.
+    bool lookup(const juce::String &formatName, const juce::String &fileOrIdentifier, juce::OwnedArray<juce::PluginDescription> &results, bool &failed) const;
+    void store(const juce::String &formatName, const juce::String &fileOrIdentifier, const juce::OwnedArray<juce::PluginDescription> &results, bool failed);
+
+    void save();
+    void clear();
+
+private:
+    struct Entry
+    {
+        juce::int64 size = 0;
+        juce::int64 modified = 0;
+        bool failed = false;
+        juce::Array<juce::PluginDescription> types;
+    };
+
+    static bool isCacheable(const juce::String &fileOrIdentifier);
+    static juce::String makeKey(const juce::String &formatName, const juce::String &fileOrIdentifier);
+    void load();
+
+    juce::File m_file;
+    std::map<juce::String, Entry> m_entries;
+    bool m_needsSaving = false;
+    juce::CriticalSection m_lock;
+
+    JUCE_DECLARE_NON_COPYABLE(PluginScanCache)
+};
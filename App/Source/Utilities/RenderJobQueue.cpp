@@ -0,0 +1,436 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#include "Utilities/RenderJobQueue.h"
+#include "Utilities/LoudnessMeter.h"
+#include "Utilities/Utilities.h"
+
+struct RenderJobQueue::RenderJob : public juce::ThreadPoolJob
+{
+    RenderJob(int id, Request r)
+        : ThreadPoolJob("Render " + juce::String(id)),
+          jobID(id),
+          request(std::move(r))
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        if (shouldExit())
+        {
+            wasCancelled = true;
+            isFinished = true;
+            return jobHasFinished;
+        }
+
+        if (isAnalysing)
+        {
+            writeLoudnessReport(request.destFile, [this] { return shouldExit(); });
+
+            if (shouldExit())
+                wasCancelled = true;
+
+            finish();
+            return jobHasFinished;
+        }
+
+        auto status = task->runJob();
+        progress = task->getCurrentTaskProgress();
+
+        if (status == jobHasFinished)
+        {
+            renderFinished = true;
+
+            // the queue closes the file on the message thread and runs the job
+            // again for the analysis
+            if (request.writeLoudnessReport)
+                return jobHasFinished;
+
+            finish();
+            return jobHasFinished;
+        }
+
+        return jobNeedsRunningAgain;
+    }
+
+    void finish()
+    {
+        progress = 1.0f;
+        finishTime = juce::Time::getMillisecondCounterHiRes();
+        isFinished = true;
+    }
+
+    double getElapsedSeconds() const
+    {
+        if (startTime <= 0.0)
+            return 0.0;
+
+        auto end = isFinished ? finishTime.load() : juce::Time::getMillisecondCounterHiRes();
+        return (end - startTime) / 1000.0;
+    }
+
+    const int jobID;
+    Request request;
+    std::unique_ptr<te::Edit> edit;
+    juce::uint64 editGeneration = 0;
+    std::unique_ptr<te::Renderer::RenderTask> task;
+    juce::String errorMessage;
+
+    bool hasStarted = false;
+    double startTime = 0.0;
+    std::atomic<double> finishTime{0.0};
+    std::atomic<float> progress{0.0f};
+    std::atomic<bool> renderFinished{false}, isAnalysing{false}, isFinished{false}, wasCancelled{false};
+};
+
+//==============================================================================
+RenderJobQueue::RenderJobQueue(te::Edit &edit, int maxConcurrentJobs)
+    : m_edit(edit),
+      m_maxConcurrentJobs(juce::jmax(1, maxConcurrentJobs)),
+      m_threadPool(juce::ThreadPool::Options{}.withNumberOfThreads(juce::jmax(1, juce::SystemStats::getNumCpus())).withThreadName("Render"))
+{
+    m_edit.state.addListener(this);
+}
+
+RenderJobQueue::~RenderJobQueue()
+{
+    m_edit.state.removeListener(this);
+    stopTimer();
+
+    // The pool jobs are owned by m_jobs, so they must all have left the pool
+    // before m_jobs goes away. A render job checks shouldExit() between
+    // blocks, so waiting without a timeout doesn't hang.
+    m_threadPool.removeAllJobs(true, -1);
+
+    for (auto &job : m_jobs)
+    {
+        const bool isIncomplete = job->hasStarted && !job->renderFinished;
+        job->task.reset();
+
+        if (isIncomplete)
+            job->request.destFile.deleteFile();
+    }
+}
+
+int RenderJobQueue::addJob(Request request)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    const auto id = m_nextJobID++;
+    m_jobs.push_back(std::make_unique<RenderJob>(id, std::move(request)));
+
+    // start right away, so the first job doesn't wait for the timer
+    timerCallback();
+    startTimerHz(10);
+
+    return id;
+}
+
+void RenderJobQueue::cancelJob(int jobID)
+{
+    for (auto &job : m_jobs)
+    {
+        if (job->jobID != jobID || job->isFinished)
+            continue;
+
+        job->wasCancelled = true;
+
+        if (job->hasStarted)
+            job->signalJobShouldExit();
+        else
+            job->isFinished = true;
+    }
+
+    // finished jobs are collected by the timer
+    startTimerHz(10);
+}
+
+void RenderJobQueue::cancelAllJobs()
+{
+    for (auto &job : m_jobs)
+        cancelJob(job->jobID);
+}
+
+void RenderJobQueue::setMaxConcurrentJobs(int numJobs)
+{
+    m_maxConcurrentJobs = juce::jlimit(1, m_threadPool.getNumThreads(), numJobs);
+
+    if (!m_jobs.empty())
+        startTimerHz(10);
+}
+
+bool RenderJobQueue::isBusy() const { return !m_jobs.empty(); }
+
+std::vector<RenderJobQueue::JobInfo> RenderJobQueue::getJobInfos() const
+{
+    std::vector<JobInfo> infos;
+
+    for (auto &job : m_jobs)
+    {
+        JobInfo info;
+        info.jobID = job->jobID;
+        info.description = job->request.description;
+        info.destFile = job->request.destFile;
+        info.isRunning = job->hasStarted && !job->isFinished;
+        info.progress = job->progress;
+        info.elapsedSeconds = job->getElapsedSeconds();
+
+        if (info.progress > 0.0f && info.elapsedSeconds > 0.0)
+        {
+            info.remainingSeconds = info.elapsedSeconds * (1.0 - info.progress) / info.progress;
+            info.realtimeFactor = job->request.range.getLength().inSeconds() * info.progress / info.elapsedSeconds;
+        }
+
+        infos.push_back(info);
+    }
+
+    return infos;
+}
+
+std::unique_ptr<te::Edit> RenderJobQueue::createEditCopy()
+{
+    // make sure plugins have written their current state to the tree
+    m_edit.flushState();
+
+    te::Edit::Options options{m_edit.engine, m_edit.state.createCopy(), m_edit.getProjectItemID()};
+    options.role = te::Edit::forRendering;
+    options.numUndoLevelsToStore = 0;
+    options.editFileRetriever = m_edit.editFileRetriever;
+    options.filePathResolver = m_edit.filePathResolver;
+
+    return std::make_unique<te::Edit>(options);
+}
+
+std::unique_ptr<te::Edit> RenderJobQueue::acquireEditCopy(RenderJob &job)
+{
+    // flushing only touches the tree when a plugin state really changed
+    m_edit.flushState();
+
+    while (!m_spareEditCopies.empty())
+    {
+        auto spare = std::move(m_spareEditCopies.back());
+        m_spareEditCopies.pop_back();
+
+        if (spare.generation == m_editGeneration)
+        {
+            job.editGeneration = spare.generation;
+            return std::move(spare.edit);
+        }
+    }
+
+    auto copy = createEditCopy();
+    job.editGeneration = m_editGeneration;
+    return copy;
+}
+
+bool RenderJobQueue::startJob(RenderJob &job)
+{
+    auto &engine = m_edit.engine;
+    auto &request = job.request;
+
+    job.hasStarted = true;
+    job.startTime = juce::Time::getMillisecondCounterHiRes();
+
+    if (!request.destFile.getParentDirectory().createDirectory())
+    {
+        job.errorMessage = "Could not create folder " + request.destFile.getParentDirectory().getFullPathName();
+        job.isFinished = true;
+        return false;
+    }
+
+    job.edit = request.prepareEdit ? createEditCopy() : acquireEditCopy(job);
+
+    if (request.prepareEdit)
+        request.prepareEdit(*job.edit);
+
+    te::Renderer::Parameters params(*job.edit);
+    params.destFile = request.destFile;
+    params.audioFormat = request.audioFormat != nullptr ? request.audioFormat : engine.getAudioFileFormatManager().getWavFormat();
+    params.bitDepth = request.bitDepth;
+    // without an open device (e.g. headless rendering) fall back to sane defaults
+    const auto deviceBlockSize = engine.getDeviceManager().getBlockSize();
+    const auto deviceSampleRate = engine.getDeviceManager().getSampleRate();
+    params.blockSizeForAudio = deviceBlockSize > 0 ? deviceBlockSize : 512;
+    params.sampleRateForAudio = request.sampleRate > 0.0 ? request.sampleRate : (deviceSampleRate > 0.0 ? deviceSampleRate : 44100.0);
+    params.time = request.range;
+    params.tracksToDo = request.tracksToDo;
+    params.usePlugins = request.usePlugins;
+    params.useMasterPlugins = request.useMasterPlugins;
+
+    for (auto clipID : request.clipsToDo)
+        if (auto clip = te::findClipForID(*job.edit, clipID))
+            params.allowedClips.add(clip);
+
+    job.task = std::make_unique<te::Renderer::RenderTask>(request.description, params, nullptr, nullptr);
+
+    if (job.task->errorMessage.isNotEmpty())
+    {
+        job.errorMessage = job.task->errorMessage;
+        job.isFinished = true;
+        return false;
+    }
+
+    m_threadPool.addJob(&job, false);
+    return true;
+}
+
+void RenderJobQueue::releaseRender(RenderJob &job)
+{
+    if (job.errorMessage.isEmpty() && job.task != nullptr)
+        job.errorMessage = job.task->errorMessage;
+
+    // the task owns the writer, it has to be gone before we look at the file
+    job.task.reset();
+
+    // an unchanged copy can render the next job
+    if (job.edit != nullptr && !job.request.prepareEdit && job.editGeneration == m_editGeneration)
+        m_spareEditCopies.push_back({std::move(job.edit), job.editGeneration});
+
+    job.edit.reset();
+}
+
+void RenderJobQueue::startAnalysis(RenderJob &job)
+{
+    releaseRender(job);
+
+    if (job.wasCancelled || job.errorMessage.isNotEmpty() || !job.request.destFile.existsAsFile())
+    {
+        job.finish();
+        return;
+    }
+
+    job.isAnalysing = true;
+    m_threadPool.addJob(&job, false);
+}
+
+void RenderJobQueue::finishJob(RenderJob &job)
+{
+    releaseRender(job);
+
+    Result result;
+    result.jobID = job.jobID;
+    result.wasCancelled = job.wasCancelled;
+    result.secondsTaken = job.getElapsedSeconds();
+    result.file = job.request.destFile;
+    result.errorMessage = job.errorMessage;
+
+    // a cancel during the loudness pass keeps the finished bounce
+    if (result.wasCancelled && !job.renderFinished)
+        result.file.deleteFile();
+    else if (result.errorMessage.isEmpty() && !result.file.existsAsFile())
+        result.errorMessage = "Render produced no output file.";
+
+    result.succeeded = !result.wasCancelled && result.errorMessage.isEmpty();
+
+    if (!result.succeeded && !result.wasCancelled)
+        juce::Logger::writeToLog("Render failed: " + result.errorMessage);
+
+    m_lastResult = result;
+
+    if (job.request.onFinished)
+        job.request.onFinished(result);
+
+    if (onJobFinished)
+        onJobFinished(result);
+}
+
+juce::File RenderJobQueue::getLoudnessReportFile(const juce::File &renderedFile) { return renderedFile.getSiblingFile(renderedFile.getFileNameWithoutExtension() + "_loudness.txt"); }
+
+void RenderJobQueue::writeLoudnessReport(const juce::File &renderedFile, const std::function<bool()> &shouldExit)
+{
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    LoudnessMeter::Values values;
+    if (!LoudnessMeter::analyseFile(renderedFile, formatManager, values, shouldExit))
+        return;
+
+    auto formatLoudness = [](float value, const char *unit) { return value <= LoudnessMeter::silence ? juce::String("-inf ") + unit : juce::String(value, 1) + " " + unit; };
+
+    juce::String report;
+    report << "Loudness report (EBU R128) for " << renderedFile.getFileName() << juce::newLine
+           << "Created " << juce::Time::getCurrentTime().toString(true, true) << juce::newLine << juce::newLine
+           << "Integrated loudness:  " << formatLoudness(values.integrated, "LUFS") << juce::newLine
+           << "Loudness range:       " << juce::String(values.range, 1) << " LU" << juce::newLine
+           << "True peak:            " << formatLoudness(values.truePeak, "dBTP") << juce::newLine
+           << "Max. momentary:       " << formatLoudness(values.maxMomentary, "LUFS") << juce::newLine
+           << "Max. short-term:      " << formatLoudness(values.maxShortTerm, "LUFS") << juce::newLine;
+
+    auto reportFile = getLoudnessReportFile(renderedFile);
+    if (!reportFile.replaceWithText(report))
+        juce::Logger::writeToLog("Error: Could not write loudness report " + reportFile.getFullPathName());
+    else
+        GUIHelpers::log("Loudness of " + renderedFile.getFileName() + ": " + formatLoudness(values.integrated, "LUFS"));
+}
+
+void RenderJobQueue::timerCallback()
+{
+    // reap finished jobs first, the callbacks may add new ones
+    std::vector<std::unique_ptr<RenderJob>> finished;
+
+    for (auto &job : m_jobs)
+        if (job->renderFinished && !job->isAnalysing && !job->isFinished && !m_threadPool.contains(job.get()))
+            startAnalysis(*job);
+
+    for (auto it = m_jobs.begin(); it != m_jobs.end();)
+    {
+        if ((*it)->isFinished && !m_threadPool.contains(it->get()))
+        {
+            finished.push_back(std::move(*it));
+            it = m_jobs.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (auto &job : finished)
+        finishJob(*job);
+
+    int numRunning = 0;
+    for (auto &job : m_jobs)
+        if (job->hasStarted && !job->isFinished)
+            ++numRunning;
+
+    for (auto &job : m_jobs)
+    {
+        if (job->hasStarted || job->isFinished)
+            continue;
+
+        const auto maxJobs = job->request.maxConcurrentJobs > 0 ? juce::jlimit(1, m_threadPool.getNumThreads(), job->request.maxConcurrentJobs) : m_maxConcurrentJobs;
+
+        // jobs start in order, a later one doesn't overtake a waiting one
+        if (numRunning >= maxJobs)
+            break;
+
+        if (startJob(*job))
+            ++numRunning;
+    }
+
+    if (m_jobs.empty())
+    {
+        m_spareEditCopies.clear();
+        stopTimer();
+    }
+
+    sendChangeMessage();
+}
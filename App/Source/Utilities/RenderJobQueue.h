@@ -0,0 +1,145 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+namespace te = tracktion_engine;
+
+// Renders edits to files on a background thread.
+// Every job renders a private copy of the edit taken when the job starts, so
+// the user can keep working (and playing) while a bounce is running. Jobs are
+// started and finished on the message thread, only the rendering itself runs
+// on the worker threads. Listeners get a change message whenever the state or
+// the progress of a job changes.
+// Building the copy has to happen on the message thread. Copies of jobs that
+// don't change their edit are handed on to the next job as long as the edit
+// hasn't changed, so a batch builds at most one copy per concurrent job.
+class RenderJobQueue
+    : public juce::ChangeBroadcaster
+    , private juce::Timer
+    , private juce::ValueTree::Listener
+{
+public:
+    struct Result
+    {
+        int jobID = 0;
+        bool succeeded = false;
+        bool wasCancelled = false;
+        juce::File file;
+        juce::String errorMessage;
+        double secondsTaken = 0.0;
+    };
+
+    struct Request
+    {
+        juce::String description{"Render"};
+        juce::File destFile;
+        tracktion::TimeRange range;
+        juce::BigInteger tracksToDo;
+        juce::Array<te::EditItemID> clipsToDo;
+        bool usePlugins = true;
+        bool useMasterPlugins = true;
+        juce::AudioFormat *audioFormat = nullptr; // nullptr renders to wav
+        double sampleRate = 0.0;                  // 0 uses the device rate
+        int bitDepth = 24;
+        bool writeLoudnessReport = false;         // see getLoudnessReportFile()
+        int maxConcurrentJobs = 0;                // > 0 overrides the queue's limit when this job starts
+        // called on the message thread with the job's copy of the edit, before
+        // the render starts. Lets a job change the copy without touching the
+        // edit the user works on.
+        std::function<void(te::Edit &)> prepareEdit;
+        std::function<void(const Result &)> onFinished;
+    };
+
+    struct JobInfo
+    {
+        int jobID = 0;
+        juce::String description;
+        juce::File destFile;
+        bool isRunning = false;
+        float progress = 0.0f;
+        double elapsedSeconds = 0.0;
+        double remainingSeconds = -1.0; // < 0 means unknown
+        double realtimeFactor = 0.0;
+    };
+
+    explicit RenderJobQueue(te::Edit &edit, int maxConcurrentJobs = 1);
+    ~RenderJobQueue() override;
+
+    // Returns the id of the new job
+    int addJob(Request request);
+    void cancelJob(int jobID);
+    void cancelAllJobs();
+
+    // How many jobs may render at the same time. Every running job holds its
+    // own copy of the edit, so keep this low for plugin heavy projects.
+    void setMaxConcurrentJobs(int numJobs);
+    [[nodiscard]] int getMaxConcurrentJobs() const { return m_maxConcurrentJobs; }
+
+    [[nodiscard]] bool isBusy() const;
+    [[nodiscard]] std::vector<JobInfo> getJobInfos() const;
+    [[nodiscard]] const Result &getLastResult() const { return m_lastResult; }
+
+    // Called on the message thread for every job that finished, failed or got
+    // cancelled, after the job's own onFinished callback.
+    std::function<void(const Result &)> onJobFinished;
+
+    // Where the loudness analysis of a bounce is written, next to the file.
+    // The analysis is the last step of the job, it runs on the render threads
+    // once the rendered file is closed and the job counts as busy until then.
+    static juce::File getLoudnessReportFile(const juce::File &renderedFile);
+
+private:
+    struct RenderJob;
+
+    struct SpareEditCopy
+    {
+        std::unique_ptr<te::Edit> edit;
+        juce::uint64 generation = 0;
+    };
+
+    void timerCallback() override;
+    void valueTreePropertyChanged(juce::ValueTree &, const juce::Identifier &) override { ++m_editGeneration; }
+    void valueTreeChildAdded(juce::ValueTree &, juce::ValueTree &) override { ++m_editGeneration; }
+    void valueTreeChildRemoved(juce::ValueTree &, juce::ValueTree &, int) override { ++m_editGeneration; }
+    void valueTreeChildOrderChanged(juce::ValueTree &, int, int) override { ++m_editGeneration; }
+
+    bool startJob(RenderJob &job);
+    void startAnalysis(RenderJob &job);
+    void releaseRender(RenderJob &job);
+    void finishJob(RenderJob &job);
+    static void writeLoudnessReport(const juce::File &renderedFile, const std::function<bool()> &shouldExit);
+    std::unique_ptr<te::Edit> createEditCopy();
+    std::unique_ptr<te::Edit> acquireEditCopy(RenderJob &job);
+
+    te::Edit &m_edit;
+    int m_maxConcurrentJobs;
+    juce::ThreadPool m_threadPool;
+    std::vector<std::unique_ptr<RenderJob>> m_jobs;
+    std::vector<SpareEditCopy> m_spareEditCopies;
+    juce::uint64 m_editGeneration = 0;
+    Result m_lastResult;
+    int m_nextJobID{1};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RenderJobQueue)
+};
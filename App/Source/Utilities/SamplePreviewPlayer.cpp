@@ -0,0 +1,300 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#include "Utilities/SamplePreviewPlayer.h"
+#include "Utilities/AudioLibraryIndex.h"
+
+struct SamplePreviewPlayer::Voice
+{
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    std::shared_ptr<const juce::AudioBuffer<float>> head;
+    double sampleRate = 0.0;
+    juce::int64 length = 0;
+    juce::int64 readPosition = 0;
+
+    std::unique_ptr<te::TimeStretcher> stretcher;
+    juce::LagrangeInterpolator interpolators[2];
+
+    // source holds what was read from the file, stretched the output of the
+    // stretcher and pending everything at the file's rate that the
+    // interpolators haven't consumed yet
+    juce::AudioBuffer<float> source, stretched, pending;
+    int numPending = 0;
+
+    bool reachedEnd = false;
+    int samplesUntilEnd = 0;
+};
+
+SamplePreviewPlayer::SamplePreviewPlayer(te::Engine &engine)
+    : m_engine(engine)
+{
+    m_formatManager.registerBasicFormats();
+    m_readThread.startThread();
+    m_smoothedGain.setCurrentAndTargetValue(1.0f);
+    m_engine.getDeviceManager().deviceManager.addAudioCallback(this);
+}
+
+SamplePreviewPlayer::~SamplePreviewPlayer()
+{
+    m_engine.getDeviceManager().deviceManager.removeAudioCallback(this);
+    unload();
+    m_readThread.stopThread(2000);
+}
+
+bool SamplePreviewPlayer::load(const juce::File &file, double sourceBpm, double targetBpm, te::TimeStretcher::Mode stretchMode)
+{
+    std::unique_ptr<juce::AudioFormatReader> reader(m_formatManager.createReaderFor(file));
+    if (reader == nullptr || reader->sampleRate <= 0.0 || reader->lengthInSamples <= 0)
+        return false;
+
+    auto voice = std::make_unique<Voice>();
+    voice->sampleRate = reader->sampleRate;
+    voice->length = reader->lengthInSamples;
+    voice->head = AudioLibraryIndex::getInstance()->getHead(file);
+    voice->reader = std::make_unique<juce::BufferingAudioReader>(reader.release(), m_readThread, (int) (bufferedSeconds * voice->sampleRate));
+
+    // the stretch factor is output length / input length, > 1 plays slower
+    auto stretchFactor = sourceBpm > 0.0 && targetBpm > 0.0 ? sourceBpm / targetBpm : 1.0;
+    if (std::abs(stretchFactor - 1.0) > 0.001 && stretchMode != te::TimeStretcher::disabled)
+    {
+        voice->stretcher = std::make_unique<te::TimeStretcher>();
+        voice->stretcher->initialise(voice->sampleRate, blockSize, 2, stretchMode, {}, true);
+
+        if (!voice->stretcher->isInitialised() || !voice->stretcher->setSpeedAndPitch((float) stretchFactor, 0.0f))
+            voice->stretcher.reset();
+    }
+
+    auto maxFrames = voice->stretcher != nullptr ? juce::jmax(blockSize, voice->stretcher->getMaxFramesNeeded()) : blockSize;
+    voice->source.setSize(2, maxFrames);
+    voice->stretched.setSize(2, blockSize * 4);
+    voice->pending.setSize(2, pendingSize);
+
+    {
+        const juce::SpinLock::ScopedLockType sl(m_voiceLock);
+        std::swap(m_voice, voice);
+        m_position = 0;
+        m_seekPosition = -1;
+        m_sourceSampleRate = m_voice->sampleRate;
+        m_lengthInSeconds = (double) m_voice->length / m_voice->sampleRate;
+    }
+
+    // the previous voice is deleted here, outside of the lock
+    return true;
+}
+
+void SamplePreviewPlayer::unload()
+{
+    std::unique_ptr<Voice> voice;
+
+    const juce::SpinLock::ScopedLockType sl(m_voiceLock);
+    std::swap(m_voice, voice);
+    m_isPlaying = false;
+    m_lengthInSeconds = 0.0;
+    m_position = 0;
+}
+
+void SamplePreviewPlayer::setPosition(double seconds)
+{
+    auto position = (juce::int64) (juce::jmax(0.0, seconds) * m_sourceSampleRate);
+    m_position = position;
+    m_seekPosition = position;
+}
+
+double SamplePreviewPlayer::getPosition() const
+{
+    auto sampleRate = m_sourceSampleRate.load();
+    return sampleRate > 0.0 ? (double) m_position / sampleRate : 0.0;
+}
+
+void SamplePreviewPlayer::audioDeviceAboutToStart(juce::AudioIODevice *device)
+{
+    m_deviceSampleRate = device->getCurrentSampleRate();
+    m_smoothedGain.reset(m_deviceSampleRate, 0.02);
+
+    // restarts the interpolators at the new rate
+    m_seekPosition = m_position.load();
+}
+
+void SamplePreviewPlayer::audioDeviceIOCallbackWithContext(const float *const *, int, float *const *outputChannelData, int numOutputChannels, int numSamples, const juce::AudioIODeviceCallbackContext &)
+{
+    for (int ch = 0; ch < numOutputChannels; ++ch)
+        if (outputChannelData[ch] != nullptr)
+            juce::FloatVectorOperations::clear(outputChannelData[ch], numSamples);
+
+    if (!m_isPlaying || numOutputChannels == 0)
+        return;
+
+    const juce::SpinLock::ScopedTryLockType sl(m_voiceLock);
+    if (!sl.isLocked() || m_voice == nullptr)
+        return;
+
+    auto &voice = *m_voice;
+    if (auto position = m_seekPosition.exchange(-1); position >= 0)
+        seek(voice, position);
+
+    const auto ratio = voice.sampleRate / m_deviceSampleRate;
+    m_smoothedGain.setTargetValue(m_gain);
+
+    for (int done = 0; done < numSamples;)
+    {
+        auto numThisTime = juce::jmin(numSamples - done, blockSize);
+
+        // the interpolators look a few samples ahead
+        fillPending(voice, (int) std::ceil(numThisTime * ratio) + 4);
+
+        int numUsed = 0;
+        for (int ch = 0; ch < 2; ++ch)
+            numUsed = voice.interpolators[ch].process(ratio, voice.pending.getReadPointer(ch), m_output.getWritePointer(ch), numThisTime);
+
+        numUsed = juce::jmin(numUsed, voice.numPending);
+        for (int ch = 0; ch < 2; ++ch)
+            std::memmove(voice.pending.getWritePointer(ch), voice.pending.getReadPointer(ch) + numUsed, sizeof(float) * (size_t) (voice.numPending - numUsed));
+
+        voice.numPending -= numUsed;
+
+        auto startGain = m_smoothedGain.getCurrentValue();
+        m_smoothedGain.skip(numThisTime);
+        m_output.applyGainRamp(0, numThisTime, startGain, m_smoothedGain.getCurrentValue());
+
+        for (int ch = 0; ch < numOutputChannels; ++ch)
+            if (outputChannelData[ch] != nullptr)
+                juce::FloatVectorOperations::copy(outputChannelData[ch] + done, m_output.getReadPointer(juce::jmin(ch, 1)), numThisTime);
+
+        done += numThisTime;
+
+        if (voice.reachedEnd)
+        {
+            voice.samplesUntilEnd -= numUsed;
+
+            if (voice.samplesUntilEnd <= 0)
+            {
+                m_isPlaying = false;
+                seek(voice, 0);
+                break;
+            }
+        }
+    }
+
+    m_position = voice.readPosition;
+}
+
+void SamplePreviewPlayer::fillPending(Voice &voice, int numNeeded)
+{
+    numNeeded = juce::jmin(numNeeded, pendingSize);
+
+    // a stretcher may ask for no input while it still has output buffered,
+    // so the number of rounds is limited
+    for (int round = 0; voice.numPending < numNeeded && round < 32; ++round)
+    {
+        auto numFrames = voice.stretcher != nullptr ? juce::jlimit(1, voice.source.getNumSamples(), voice.stretcher->getFramesNeeded()) : blockSize;
+        auto hasMore = readSource(voice, numFrames);
+
+        auto numProduced = numFrames;
+        const float *const *data = voice.source.getArrayOfReadPointers();
+
+        if (voice.stretcher != nullptr)
+        {
+            numProduced = voice.stretcher->processData(voice.source.getArrayOfReadPointers(), numFrames, voice.stretched.getArrayOfWritePointers());
+            data = voice.stretched.getArrayOfReadPointers();
+        }
+
+        numProduced = juce::jlimit(0, pendingSize - voice.numPending, numProduced);
+        for (int ch = 0; ch < 2; ++ch)
+            voice.pending.copyFrom(ch, voice.numPending, data[ch], numProduced);
+
+        voice.numPending += numProduced;
+
+        if (!hasMore && !voice.reachedEnd)
+        {
+            voice.reachedEnd = true;
+            voice.samplesUntilEnd = voice.numPending;
+        }
+    }
+
+    if (voice.numPending < numNeeded)
+        voice.pending.clear(voice.numPending, numNeeded - voice.numPending);
+}
+
+bool SamplePreviewPlayer::readSource(Voice &voice, int numFrames)
+{
+    voice.source.clear(0, numFrames);
+
+    for (int written = 0; written < numFrames;)
+    {
+        if (voice.readPosition >= voice.length)
+        {
+            if (!m_looping)
+                return false;
+
+            voice.readPosition = 0;
+        }
+
+        auto num = (int) juce::jmin((juce::int64) (numFrames - written), voice.length - voice.readPosition);
+        readFrames(voice, written, num);
+        voice.readPosition += num;
+        written += num;
+    }
+
+    return true;
+}
+
+void SamplePreviewPlayer::readFrames(Voice &voice, int destStart, int numFrames)
+{
+    auto position = voice.readPosition;
+
+    if (voice.head != nullptr && position < voice.head->getNumSamples())
+    {
+        auto numFromHead = (int) juce::jmin((juce::int64) numFrames, voice.head->getNumSamples() - position);
+
+        for (int ch = 0; ch < 2; ++ch)
+            voice.source.copyFrom(ch, destStart, *voice.head, juce::jmin(ch, voice.head->getNumChannels() - 1), (int) position, numFromHead);
+
+        destStart += numFromHead;
+        position += numFromHead;
+        numFrames -= numFromHead;
+    }
+
+    if (numFrames <= 0)
+        return;
+
+    // the buffering reader doesn't block, it returns silence for parts that
+    // haven't been read from disk yet
+    voice.reader->read(&voice.source, destStart, numFrames, position, true, true);
+
+    if (voice.reader->numChannels == 1)
+        voice.source.copyFrom(1, destStart, voice.source, 0, destStart, numFrames);
+}
+
+void SamplePreviewPlayer::seek(Voice &voice, juce::int64 position)
+{
+    voice.readPosition = juce::jlimit((juce::int64) 0, voice.length, position);
+    voice.numPending = 0;
+    voice.reachedEnd = false;
+    voice.samplesUntilEnd = 0;
+
+    for (auto &interpolator : voice.interpolators)
+        interpolator.reset();
+
+    if (voice.stretcher != nullptr)
+        voice.stretcher->reset();
+
+    m_position = voice.readPosition;
+}
@@ -0,0 +1,93 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+namespace te = tracktion_engine;
+
+// Plays a single audio file for auditioning in the browsers. The player is an
+// additional callback on the audio device, so nothing has to be built per
+// file the way a preview edit does: the start of the file comes from the
+// AudioLibraryIndex head cache and the rest streams from disk through a
+// BufferingAudioReader, so a new file is heard with the next audio block.
+// Optionally the file is time-stretched to a target tempo.
+class SamplePreviewPlayer : private juce::AudioIODeviceCallback
+{
+public:
+    explicit SamplePreviewPlayer(te::Engine &engine);
+    ~SamplePreviewPlayer() override;
+
+    // With a sourceBpm and targetBpm > 0 the file is stretched to the target
+    // tempo using stretchMode.
+    bool load(const juce::File &file, double sourceBpm = 0.0, double targetBpm = 0.0, te::TimeStretcher::Mode stretchMode = te::TimeStretcher::defaultMode);
+    void unload();
+
+    void play() { m_isPlaying = m_lengthInSeconds > 0.0; }
+    void stop() { m_isPlaying = false; }
+    bool isPlaying() const { return m_isPlaying; }
+
+    // Times are in seconds of the source file.
+    void setPosition(double seconds);
+    double getPosition() const;
+    double getLength() const { return m_lengthInSeconds; }
+
+    void setLooping(bool shouldLoop) { m_looping = shouldLoop; }
+    void setGain(float gain) { m_gain = gain; }
+
+private:
+    struct Voice;
+
+    void audioDeviceIOCallbackWithContext(const float *const *inputChannelData, int numInputChannels, float *const *outputChannelData, int numOutputChannels, int numSamples, const juce::AudioIODeviceCallbackContext &context) override;
+    void audioDeviceAboutToStart(juce::AudioIODevice *device) override;
+    void audioDeviceStopped() override {}
+
+    void fillPending(Voice &voice, int numNeeded);
+    bool readSource(Voice &voice, int numFrames);
+    void readFrames(Voice &voice, int destStart, int numFrames);
+    void seek(Voice &voice, juce::int64 position);
+
+    static constexpr int blockSize = 512;
+    static constexpr int pendingSize = 16384;
+    static constexpr double bufferedSeconds = 2.0;
+
+    te::Engine &m_engine;
+    juce::AudioFormatManager m_formatManager;
+    juce::TimeSliceThread m_readThread{"Sample Preview Reader"};
+
+    // the voice is swapped on the message thread, the audio thread only
+    // tries to take the lock and plays silence if that fails
+    std::unique_ptr<Voice> m_voice;
+    juce::SpinLock m_voiceLock;
+
+    std::atomic<double> m_deviceSampleRate{44100.0};
+    std::atomic<double> m_lengthInSeconds{0.0};
+    std::atomic<double> m_sourceSampleRate{0.0};
+    std::atomic<juce::int64> m_position{0};
+    std::atomic<juce::int64> m_seekPosition{-1};
+    std::atomic<bool> m_isPlaying{false}, m_looping{false};
+    std::atomic<float> m_gain{1.0f};
+    juce::SmoothedValue<float> m_smoothedGain;
+    juce::AudioBuffer<float> m_output{2, blockSize};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SamplePreviewPlayer)
+};
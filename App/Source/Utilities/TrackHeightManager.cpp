@@ -33,14 +33,18 @@ void TrackHeightManager::regenerateTrackHeightsFromEdit(tracktion_engine::Edit &
     regenerateTrackHeightsFromStates(allTracks);
 }
 
-juce::Array<tracktion::EditItemID> TrackHeightManager::getShowedTracks(tracktion::Edit &edit)
+juce::Array<tracktion::EditItemID> TrackHeightManager::getShowedTracks(tracktion::Edit &)
 {
+    ensureLayout();
+
     juce::Array<tracktion::EditItemID> showedTracks;
 
-    for (auto t : tracktion_engine::getAllTracks(edit))
-        if (isTrackShowable(t))
-            if (getTrackHeight(t, true) > 0)
-                showedTracks.add(t->itemID);
+    for (size_t i = 0; i < layoutRows.size(); i++)
+    {
+        const auto &row = layoutRows[i];
+        if (row.param == nullptr && row.showable && getTrackBottom(i) > row.y)
+            showedTracks.add(row.track->itemID);
+    }
 
     return showedTracks;
 }
@@ -59,70 +63,25 @@ int TrackHeightManager::getTrackHeight(tracktion_engine::Track *track, bool with
     if (track == nullptr)
         return 0;
 
-    TrackHeightInfo *trackInfo = getTrackInfoForTrack(track);
-    if (trackInfo == nullptr)
-        return 0;
+    ensureLayout();
 
-    if (isTrackInMinimizedFolderRecursive(track))
+    auto it = trackRows.find(track);
+    if (it == trackRows.end())
         return 0;
 
-    if (trackInfo->isMinimized)
-        return trackMinimizedHeight;
-
-    int totalHeight = trackInfo->baseHeight;
+    const auto &row = layoutRows[it->second];
 
-    if (trackInfo->type == TrackType::Folder)
-        totalHeight = folderTrackHeight;
+    if (!withAutomation)
+        return row.height;
 
-    if (withAutomation)
-    {
-        juce::Array<te::AutomatableParameter *> params;
-        for (const auto &[ap, height] : trackInfo->automationParameterHeights)
-            params.add(ap);
-
-        // Sort the parameters by their ID string to ensure a consistent order
-        std::sort(params.begin(), params.end(), [](const auto *a, const auto *b) { return a->paramID < b->paramID; });
-
-        for (const auto &ap : params)
-            totalHeight += trackInfo->automationParameterHeights[ap];
-    }
-
-    return totalHeight;
+    return getTrackBottom(it->second) - row.y;
 }
 
 tracktion_engine::Track *TrackHeightManager::getTrackForY(int y, int scrollOffsetY)
 {
-    int currentY = -scrollOffsetY;
-
-    for (auto *info : trackInfos)
-    {
-        int trackHeight = info->baseHeight;
-
-        if (y >= currentY && y < currentY + trackHeight)
-        {
-            return info->track;
-        }
-
-        int paramY = currentY + trackHeight;
-
-        juce::Array<te::AutomatableParameter *> params;
-        for (const auto &[param, height] : info->automationParameterHeights)
-            params.add(param);
-
-        std::sort(params.begin(), params.end(), [](const auto *a, const auto *b) { return a->paramID < b->paramID; });
-
-        for (const auto &param : params)
-        {
-            const int height = info->automationParameterHeights[param];
-            if (y >= paramY && y < paramY + height)
-            {
-                return nullptr;
-            }
-            paramY += height;
-        }
-
-        currentY += getTrackHeight(info->track, true);
-    }
+    if (auto *row = findRow(y + scrollOffsetY, &LayoutRow::y))
+        if (row->param == nullptr)
+            return row->track;
 
     return nullptr;
 }
@@ -143,105 +102,39 @@ int TrackHeightManager::getAutomationHeight(tracktion_engine::AutomatableParamet
         }
     }
 
-    for (const auto *trackInfo : trackInfos)
-    {
-        auto it = trackInfo->automationParameterHeights.find(ap);
-        if (it != trackInfo->automationParameterHeights.end())
-            return it->second;
-    }
+    ensureLayout();
+
+    auto it = automationRows.find(ap);
+    if (it != automationRows.end())
+        return layoutRows[it->second].info->automationParameterHeights[ap];
 
     return 0;
 }
 
 tracktion_engine::AutomatableParameter::Ptr TrackHeightManager::getAutomatableParameterForY(int y, int scrollOffsetY)
 {
-    int currentY = -scrollOffsetY;
-
-    for (auto *info : trackInfos)
-    {
-        const int trackHeightWithAutomation = getTrackHeight(info->track, true);
-        const int trackEndY = currentY + trackHeightWithAutomation;
-
-        // Early continue if y is not in current track range
-        if (y < currentY || y >= trackEndY)
-        {
-            currentY = trackEndY;
-            continue;
-        }
-
-        // Track found, check parameters
-        int paramY = currentY + info->baseHeight;
-
-        juce::Array<te::AutomatableParameter *> params;
-        for (const auto &[ap, height] : info->automationParameterHeights)
-            params.add(ap);
-
-        // Sort the parameters by their ID string to ensure a consistent order
-        std::sort(params.begin(), params.end(), [](const auto *a, const auto *b) { return a->paramID < b->paramID; });
-
-        for (const auto &ap : params)
-        {
-            const int height = info->automationParameterHeights[ap];
-            const int paramEndY = paramY + height;
-
-            if (y >= paramY && y < paramEndY)
-                return ap;
-
-            paramY = paramEndY;
-        }
-
-        // No parameter found but track matched, break search
-        break;
-    }
+    if (auto *row = findRow(y + scrollOffsetY, &LayoutRow::y))
+        return row->param;
 
     return nullptr;
 }
 
 int TrackHeightManager::getYForAutomatableParameter(tracktion_engine::Track *track, const tracktion::AutomatableParameter::Ptr ap, int scrollOffsetY)
 {
-    int currentY = -scrollOffsetY;
-
-    for (auto *info : trackInfos)
-    {
-        if (info->track == track)
-        {
-            int paramY = currentY + info->baseHeight;
+    ensureLayout();
 
-            juce::Array<te::AutomatableParameter *> params;
-            for (const auto &[param, height] : info->automationParameterHeights)
-                params.add(param);
+    auto it = automationRows.find(ap.get());
+    if (it == automationRows.end() || layoutRows[it->second].track != track)
+        return -1;
 
-            std::sort(params.begin(), params.end(), [](const auto *a, const auto *b) { return a->paramID < b->paramID; });
-
-            for (const auto &storedParam : params)
-            {
-                if (storedParam == ap.get())
-                {
-                    return paramY;
-                }
-                paramY += info->automationParameterHeights[storedParam];
-            }
-        }
-
-        currentY += getTrackHeight(info->track, true);
-    }
-
-    return -1;
+    return layoutRows[it->second].y - scrollOffsetY;
 }
 int TrackHeightManager::getYForTrack(tracktion_engine::Track *track, int scrollOffsetY)
 {
-    int currentY = -scrollOffsetY;
-
-    for (auto *info : trackInfos)
-    {
-        if (info->track == track)
-        {
-            return currentY;
-        }
-        currentY += getTrackHeight(info->track, true);
-    }
+    if (auto *row = getTrackRow(track))
+        return row->y - scrollOffsetY;
 
-    return -1; // Track nicht gefunden
+    return -1;
 }
 
 bool TrackHeightManager::isTrackMinimized(tracktion_engine::Track *track)
@@ -261,6 +154,8 @@ void TrackHeightManager::setMinimized(tracktion_engine::Track *track, bool minim
 
     trackInfo->isMinimized = minimized;
 
+    // changes the height of all tracks in a folder, rebuild the whole table
+    invalidateLayout();
     triggerFlashState();
 }
 
@@ -303,13 +198,31 @@ void TrackHeightManager::setAutomationHeight(const tracktion_engine::Automatable
     if (trackInfo == nullptr)
         return;
 
+    auto isNew = trackInfo->automationParameterHeights.count(ap) == 0;
     trackInfo->automationParameterHeights[ap] = height;
 
+    auto it = automationRows.find(ap.get());
+    if (isNew || layoutNeedsRebuild || it == automationRows.end())
+    {
+        invalidateLayout();
+    }
+    else if (areAutomationLanesShown(*trackInfo))
+    {
+        layoutRows[it->second].height = height;
+        invalidateLayoutFrom(it->second);
+    }
+
     GUIHelpers::log("ParameterHeight set to: ", height);
     triggerFlashState();
 }
 tracktion::Track::Ptr TrackHeightManager::getTrackFromID(tracktion_engine::Edit &edit, const tracktion_engine::EditItemID &id)
 {
+    ensureLayout();
+
+    auto it = trackRowsByID.find(id.getRawID());
+    if (it != trackRowsByID.end() && &layoutRows[it->second].track->edit == &edit)
+        return layoutRows[it->second].track;
+
     tracktion::Track::Ptr foundTrack;
 
     edit.visitAllTracks(
@@ -327,16 +240,17 @@ tracktion::Track::Ptr TrackHeightManager::getTrackFromID(tracktion_engine::Edit
 
     return foundTrack;
 }
-void TrackHeightManager::addTrackInfo(TrackHeightInfo *info) { trackInfos.add(info); }
+void TrackHeightManager::addTrackInfo(TrackHeightInfo *info)
+{
+    trackInfos.add(info);
+    trackInfoMap[info->track] = info;
+    invalidateLayout();
+}
 
 TrackHeightManager::TrackHeightInfo *TrackHeightManager::getTrackInfoForTrack(tracktion_engine::Track *track) const
 {
-    for (auto *info : trackInfos)
-    {
-        if (info->track == track)
-            return info;
-    }
-    return nullptr;
+    auto it = trackInfoMap.find(track);
+    return it != trackInfoMap.end() ? it->second : nullptr;
 }
 
 tracktion_engine::AutomatableParameter::Ptr TrackHeightManager::findAutomatableParameterByID(tracktion_engine::Track *track, const juce::String &paramID)
@@ -356,12 +270,14 @@ tracktion_engine::AutomatableParameter::Ptr TrackHeightManager::findAutomatableP
 void TrackHeightManager::flashStateFromTrackInfos()
 {
     GUIHelpers::log("Update State from TrackInfos");
-    // Sort TrackInfos by hierarchy depth so parent folders are processed first
+    // Sort TrackInfos by hierarchy depth so parent folders are processed first.
+    // Sort a copy, trackInfos is in layout order.
+    auto sortedInfos = trackInfos;
     TrackHeightInfoComparator comparator;
-    trackInfos.sort(comparator);
+    sortedInfos.sort(comparator, true);
 
     // First pass: Set individual track states
-    for (const auto *info : trackInfos)
+    for (const auto *info : sortedInfos)
     {
         auto *track = info->track;
         if (!track)
@@ -407,6 +323,12 @@ void TrackHeightManager::setTrackHeight(tracktion_engine::Track *track, int heig
     height = juce::jlimit(30, 300, height);
     trackInfo->baseHeight = height;
 
+    if (auto it = trackRows.find(track); it != trackRows.end() && !layoutNeedsRebuild)
+    {
+        layoutRows[it->second].height = getTrackRowHeight(*trackInfo);
+        invalidateLayoutFrom(it->second);
+    }
+
     triggerFlashState();
 }
 void TrackHeightManager::triggerFlashState()
@@ -445,6 +367,8 @@ void TrackHeightManager::regenerateTrackHeightsFromStates(const juce::Array<trac
     GUIHelpers::log("Update TrackInfo from State");
 
     trackInfos.clear();
+    trackInfoMap.clear();
+    invalidateLayout();
 
     for (auto *track : allTracks)
     {
@@ -475,29 +399,139 @@ void TrackHeightManager::regenerateTrackHeightsFromStates(const juce::Array<trac
         info->hierarchyDepth = calculateHierarchyDepth(track);
         info->parentFolder = track->getParentFolderTrack();
 
-        auto addAutomationParameter = [&](te::AutomatableParameter *ap)
+        collectAutomationParameterHeights(*info);
+        addTrackInfo(info);
+    }
+}
+
+void TrackHeightManager::collectAutomationParameterHeights(TrackHeightInfo &info)
+{
+    auto addAutomationParameter = [&](te::AutomatableParameter *ap)
+    {
+        if (ap == nullptr)
+            return;
+
+        if (ap->getCurve().getNumPoints() == 0)
+            return;
+
+        int height = static_cast<int>(ap->getCurve().state.getProperty(tracktion_engine::IDs::height, 50));
+        info.automationParameterHeights[ap] = height;
+    };
+
+    for (auto *ap : info.track->getAllAutomatableParams())
+        addAutomationParameter(ap);
+
+    if (info.track->isMasterTrack())
+    {
+        addAutomationParameter(info.track->edit.getMasterSliderPosParameter().get());
+        addAutomationParameter(info.track->edit.getMasterPanParameter().get());
+    }
+}
+
+void TrackHeightManager::updateAutomationParameters(tracktion_engine::Track *track)
+{
+    if (track == nullptr)
+        return;
+
+    auto *info = getTrackInfoForTrack(track);
+    if (info == nullptr)
+    {
+        regenerateTrackHeightsFromEdit(track->edit);
+        return;
+    }
+
+    auto previous = std::move(info->automationParameterHeights);
+    info->automationParameterHeights.clear();
+    collectAutomationParameterHeights(*info);
+
+    bool sameLanes = previous.size() == info->automationParameterHeights.size();
+
+    for (auto &[ap, height] : info->automationParameterHeights)
+    {
+        // a height that wasn't flashed to the state yet wins
+        if (auto it = previous.find(ap); it != previous.end())
+            height = it->second;
+        else
+            sameLanes = false;
+    }
+
+    if (!sameLanes)
+        invalidateLayout();
+}
+
+bool TrackHeightManager::updateFromState(const juce::ValueTree &state, const juce::Identifier &property)
+{
+    if (state.hasType(te::IDs::AUTOMATIONCURVE))
+    {
+        if (property != te::IDs::height)
+            return true;
+
+        for (auto *info : trackInfos)
         {
-            if (ap == nullptr)
-                return;
+            for (auto &[ap, height] : info->automationParameterHeights)
+            {
+                if (ap->getCurve().state != state)
+                    continue;
 
-            if (ap->getCurve().getNumPoints() == 0)
-                return;
+                const int newHeight = state.getProperty(te::IDs::height, 50);
+                if (newHeight == height)
+                    return true; // usually our own flashed value
 
-            int height = static_cast<int>(ap->getCurve().state.getProperty(tracktion_engine::IDs::height, 50));
-            info->automationParameterHeights[ap] = height;
-        };
+                height = newHeight;
 
-        for (auto *ap : track->getAllAutomatableParams())
-            addAutomationParameter(ap);
+                auto it = automationRows.find(ap.get());
+                if (layoutNeedsRebuild || it == automationRows.end())
+                    invalidateLayout();
+                else if (areAutomationLanesShown(*info))
+                {
+                    layoutRows[it->second].height = newHeight;
+                    invalidateLayoutFrom(it->second);
+                }
+
+                return true;
+            }
+        }
+
+        // a curve that has no lane yet
+        return state.getNumChildren() == 0;
+    }
 
-        if (track->isMasterTrack())
+    if (!te::TrackList::isTrack(state))
+        return true;
+
+    for (auto *info : trackInfos)
+    {
+        if (info->track == nullptr || info->track->state != state)
+            continue;
+
+        if (property == IDs::isTrackMinimized)
+        {
+            const bool minimized = state.getProperty(IDs::isTrackMinimized, false);
+            if (minimized != info->isMinimized)
+            {
+                info->isMinimized = minimized;
+                invalidateLayout();
+            }
+        }
+        else if (property == te::IDs::height && info->type != TrackType::Folder)
         {
-            addAutomationParameter(track->edit.getMasterSliderPosParameter().get());
-            addAutomationParameter(track->edit.getMasterPanParameter().get());
+            const int newHeight = state.getProperty(te::IDs::height, 50);
+            if (newHeight != info->baseHeight)
+            {
+                info->baseHeight = newHeight;
+
+                if (auto it = trackRows.find(info->track); it != trackRows.end() && !layoutNeedsRebuild)
+                {
+                    layoutRows[it->second].height = getTrackRowHeight(*info);
+                    invalidateLayoutFrom(it->second);
+                }
+            }
         }
 
-        addTrackInfo(info);
+        return true;
     }
+
+    return false;
 }
 bool TrackHeightManager::isAutomationVisible(const tracktion_engine::AutomatableParameter &ap)
 {
@@ -547,3 +581,234 @@ bool TrackHeightManager::isAutomationVisible(const tracktion_engine::Automatable
 
     return !isTrackInMinimizedFolder(apTrack);
 }
+
+int TrackHeightManager::getShowedYForTrack(tracktion_engine::Track *track)
+{
+    ensureLayout();
+
+    auto it = trackRows.find(track);
+    if (it == trackRows.end())
+        return -1;
+
+    const auto &row = layoutRows[it->second];
+    if (!row.showable || getTrackBottom(it->second) == row.y)
+        return -1;
+
+    return row.showedY;
+}
+
+tracktion_engine::Track *TrackHeightManager::getShowedTrackForY(int y)
+{
+    if (auto *row = findRow(y, &LayoutRow::showedY))
+        if (row->showable)
+            return row->track;
+
+    return nullptr;
+}
+
+int TrackHeightManager::getShowedLayoutHeight()
+{
+    ensureLayout();
+
+    if (layoutRows.empty())
+        return 0;
+
+    const auto &last = layoutRows.back();
+    return last.showedY + (last.showable ? last.height : 0);
+}
+
+juce::Array<tracktion_engine::Track *> TrackHeightManager::getShowedTracksInRange(juce::Range<int> range)
+{
+    ensureLayout();
+
+    juce::Array<tracktion_engine::Track *> tracks;
+
+    // start at the track of the last row that begins above the range
+    auto it = std::upper_bound(layoutRows.begin(), layoutRows.end(), range.getStart(), [](int value, const LayoutRow &row) { return value < row.showedY; });
+    size_t i = 0;
+
+    if (it != layoutRows.begin())
+        i = trackRows[std::prev(it)->track];
+
+    for (; i < layoutRows.size(); i++)
+    {
+        const auto &row = layoutRows[i];
+        if (row.param != nullptr || !row.showable)
+            continue;
+
+        if (row.showedY >= range.getEnd())
+            break;
+
+        const auto bottom = getTrackBottom(i);
+        if (bottom > row.y && row.showedY + (bottom - row.y) > range.getStart())
+            tracks.add(row.track);
+    }
+
+    return tracks;
+}
+
+std::vector<TrackHeightManager::ShowedAutomationLane> TrackHeightManager::getShowedAutomationLanesInRange(juce::Range<int> range)
+{
+    ensureLayout();
+
+    std::vector<ShowedAutomationLane> lanes;
+
+    // the rows before the first one that begins in the range end above it,
+    // except the last of them
+    auto it = std::upper_bound(layoutRows.begin(), layoutRows.end(), range.getStart(), [](int value, const LayoutRow &row) { return value < row.showedY; });
+
+    if (it != layoutRows.begin())
+        --it;
+
+    for (; it != layoutRows.end(); ++it)
+    {
+        const auto &row = *it;
+
+        if (row.showedY >= range.getEnd())
+            break;
+
+        if (row.param == nullptr || !row.showable || row.height == 0)
+            continue;
+
+        if (row.showedY + row.height > range.getStart())
+            lanes.push_back({row.param, row.showedY, row.height});
+    }
+
+    return lanes;
+}
+
+int TrackHeightManager::getTrackRowHeight(TrackHeightInfo &info)
+{
+    if (isTrackInMinimizedFolderRecursive(info.track))
+        return 0;
+
+    if (info.isMinimized)
+        return trackMinimizedHeight;
+
+    if (info.type == TrackType::Folder)
+        return folderTrackHeight;
+
+    return info.baseHeight;
+}
+
+bool TrackHeightManager::areAutomationLanesShown(TrackHeightInfo &info) { return !info.isMinimized && !isTrackInMinimizedFolderRecursive(info.track); }
+
+void TrackHeightManager::rebuildLayout()
+{
+    layoutRows.clear();
+    trackRows.clear();
+    automationRows.clear();
+    trackRowsByID.clear();
+
+    for (auto *info : trackInfos)
+    {
+        auto *track = info->track;
+        if (track == nullptr)
+            continue;
+
+        const auto trackRow = layoutRows.size();
+        const bool showable = isTrackShowable(track);
+        const bool showLanes = areAutomationLanesShown(*info);
+
+        LayoutRow row;
+        row.track = track;
+        row.info = info;
+        row.height = getTrackRowHeight(*info);
+        row.showable = showable;
+        row.numAutomationRows = static_cast<int>(info->automationParameterHeights.size());
+        layoutRows.push_back(row);
+
+        trackRows[track] = trackRow;
+        trackRowsByID[track->itemID.getRawID()] = trackRow;
+
+        // Sort the parameters by their ID string to ensure a consistent order
+        std::vector<te::AutomatableParameter *> params;
+        for (const auto &[ap, height] : info->automationParameterHeights)
+            params.push_back(ap.get());
+
+        std::sort(params.begin(), params.end(), [](const auto *a, const auto *b) { return a->paramID < b->paramID; });
+
+        for (auto *ap : params)
+        {
+            LayoutRow laneRow;
+            laneRow.track = track;
+            laneRow.param = ap;
+            laneRow.info = info;
+            laneRow.height = showLanes ? info->automationParameterHeights[ap] : 0;
+            laneRow.showable = showable;
+
+            automationRows[ap] = layoutRows.size();
+            layoutRows.push_back(laneRow);
+        }
+    }
+
+    layoutNeedsRebuild = false;
+    firstDirtyRow = 0;
+}
+
+void TrackHeightManager::ensureLayout()
+{
+    if (layoutNeedsRebuild)
+        rebuildLayout();
+
+    if (firstDirtyRow >= layoutRows.size())
+        return;
+
+    // only the offsets below the first changed row have to be summed again
+    int y = 0;
+    int showedY = 0;
+
+    if (firstDirtyRow > 0)
+    {
+        const auto &prev = layoutRows[firstDirtyRow - 1];
+        y = prev.y + prev.height;
+        showedY = prev.showedY + (prev.showable ? prev.height : 0);
+    }
+
+    for (auto i = firstDirtyRow; i < layoutRows.size(); i++)
+    {
+        auto &row = layoutRows[i];
+        row.y = y;
+        row.showedY = showedY;
+        y += row.height;
+        if (row.showable)
+            showedY += row.height;
+    }
+
+    firstDirtyRow = std::numeric_limits<size_t>::max();
+}
+
+const TrackHeightManager::LayoutRow *TrackHeightManager::findRow(int y, int LayoutRow::*offset)
+{
+    ensureLayout();
+
+    // last row that starts at or above y, rows of height 0 sort before the
+    // row that covers y
+    auto it = std::upper_bound(layoutRows.begin(), layoutRows.end(), y, [offset](int value, const LayoutRow &row) { return value < row.*offset; });
+
+    if (it == layoutRows.begin())
+        return nullptr;
+
+    const auto &row = *std::prev(it);
+
+    // rows of tracks that are not showable take no space in the showed layout
+    const auto height = (offset == &LayoutRow::showedY && !row.showable) ? 0 : row.height;
+    if (y >= row.*offset + height)
+        return nullptr;
+
+    return &row;
+}
+
+const TrackHeightManager::LayoutRow *TrackHeightManager::getTrackRow(const tracktion_engine::Track *track)
+{
+    ensureLayout();
+
+    auto it = trackRows.find(track);
+    return it != trackRows.end() ? &layoutRows[it->second] : nullptr;
+}
+
+int TrackHeightManager::getTrackBottom(size_t trackRow) const
+{
+    const auto lastRow = trackRow + static_cast<size_t>(layoutRows[trackRow].numAutomationRows);
+    return layoutRows[lastRow].y + layoutRows[lastRow].height;
+}
@@ -71,6 +71,13 @@ public:
     void flashStateFromTrackInfos();
     void regenerateTrackHeightsFromStates(const juce::Array<tracktion_engine::Track *> &allTracks);
     void regenerateTrackHeightsFromEdit(tracktion_engine::Edit &edit);
+    // Picks up the automation lanes of one track, the layout table is only
+    // rebuilt if the set of lanes changed.
+    void updateAutomationParameters(tracktion_engine::Track *track);
+    // Takes over a height or minimized state changed in the edit (e.g. by
+    // undo) without regenerating everything. Returns false if the state
+    // belongs to a track or curve the manager doesn't know yet.
+    bool updateFromState(const juce::ValueTree &state, const juce::Identifier &property);
 
     TrackHeightInfo *getTrackInfoForTrack(tracktion_engine::Track *track) const;
     tracktion_engine::AutomatableParameter::Ptr findAutomatableParameterByID(tracktion_engine::Track *track, const juce::String &paramID);
@@ -94,16 +101,74 @@ public:
 
     bool isAutomationVisible(const tracktion_engine::AutomatableParameter &ap);
 
+    // Layout of the song editor: the showed tracks, each followed by its
+    // automation lanes. Y values start at the top of the first showed track
+    // and do not include scrolling. getShowedTrackForY also returns the track
+    // when y hits one of its automation lanes.
+    int getShowedYForTrack(tracktion_engine::Track *track);
+    tracktion_engine::Track *getShowedTrackForY(int y);
+    int getShowedLayoutHeight();
+    // The showed tracks whose rows, automation lanes included, intersect the
+    // given range, top to bottom.
+    juce::Array<tracktion_engine::Track *> getShowedTracksInRange(juce::Range<int> range);
+
+    struct ShowedAutomationLane
+    {
+        tracktion_engine::AutomatableParameter *param = nullptr;
+        int showedY = 0;
+        int height = 0;
+    };
+
+    // The automation lanes that are shown and intersect the given range, top
+    // to bottom. Taken from the layout, so it doesn't matter whether the lane
+    // components exist.
+    std::vector<ShowedAutomationLane> getShowedAutomationLanesInRange(juce::Range<int> range);
+
     void triggerFlashState();
     void timerCallback() override;
 
 private:
+    // One row per track and per automation lane, in trackInfos order. y sums
+    // the heights of all rows above, showedY only those of showable tracks.
+    // Hidden automation lanes stay in the table with a height of 0, so the
+    // offsets are monotonic and a row can be found by binary search.
+    struct LayoutRow
+    {
+        tracktion_engine::Track *track = nullptr;
+        tracktion_engine::AutomatableParameter *param = nullptr;
+        TrackHeightInfo *info = nullptr;
+        int height = 0;
+        int y = 0;
+        int showedY = 0;
+        bool showable = false;
+        int numAutomationRows = 0;
+    };
+
     void addTrackInfo(TrackHeightInfo *info);
+    void collectAutomationParameterHeights(TrackHeightInfo &info);
     int calculateHierarchyDepth(tracktion_engine::Track *track);
 
+    void ensureLayout();
+    void rebuildLayout();
+    void invalidateLayout() { layoutNeedsRebuild = true; }
+    void invalidateLayoutFrom(size_t row) { firstDirtyRow = std::min(firstDirtyRow, row); }
+    int getTrackRowHeight(TrackHeightInfo &info);
+    bool areAutomationLanesShown(TrackHeightInfo &info);
+    const LayoutRow *findRow(int y, int LayoutRow::*offset);
+    const LayoutRow *getTrackRow(const tracktion_engine::Track *track);
+    int getTrackBottom(size_t trackRow) const;
+
     juce::Array<TrackHeightInfo *> trackInfos;
+    std::unordered_map<const tracktion_engine::Track *, TrackHeightInfo *> trackInfoMap;
     bool pendingFlashState = false;
 
+    std::vector<LayoutRow> layoutRows;
+    std::unordered_map<const tracktion_engine::Track *, size_t> trackRows;
+    std::unordered_map<const tracktion_engine::AutomatableParameter *, size_t> automationRows;
+    std::unordered_map<juce::uint64, size_t> trackRowsByID;
+    bool layoutNeedsRebuild = true;
+    size_t firstDirtyRow = std::numeric_limits<size_t>::max();
+
     class TrackHeightInfoComparator
     {
     public:
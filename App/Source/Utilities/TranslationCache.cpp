@@ -0,0 +1,75 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#include "Utilities/TranslationCache.h"
+
+juce::String TranslationCache::translate(const juce::String &text, const std::function<juce::File()> &languageFileProvider)
+{
+    const juce::ScopedLock sl(m_lock);
+
+    if (!m_isLoaded && languageFileProvider)
+        reload(languageFileProvider());
+
+    auto it = m_table.find(text);
+    if (it != m_table.end())
+        return it->second;
+
+    return text;
+}
+
+void TranslationCache::reload(const juce::File &languageFile)
+{
+    const juce::ScopedLock sl(m_lock);
+
+    m_table.clear();
+    m_languageFile = languageFile;
+    m_isLoaded = true;
+
+    if (!languageFile.existsAsFile())
+        return;
+
+    // LocalisedStrings stores its mappings in a StringPairArray, which does a
+    // linear search per lookup. We only use it for parsing and copy the pairs
+    // into a hash table.
+    juce::LocalisedStrings parsed(languageFile, false);
+    const auto &mappings = parsed.getMappings();
+    const auto &keys = mappings.getAllKeys();
+    const auto &values = mappings.getAllValues();
+
+    m_table.reserve(static_cast<size_t>(keys.size()));
+
+    for (int i = 0; i < keys.size(); ++i)
+        m_table.emplace(keys[i], values[i]);
+}
+
+void TranslationCache::invalidate()
+{
+    const juce::ScopedLock sl(m_lock);
+    m_table.clear();
+    m_languageFile = juce::File();
+    m_isLoaded = false;
+}
+
+juce::File TranslationCache::getLanguageFile() const
+{
+    const juce::ScopedLock sl(m_lock);
+    return m_languageFile;
+}
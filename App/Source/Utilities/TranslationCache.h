@@ -0,0 +1,54 @@
+/*
+
+This file is part of NextStudio.
+Copyright (c) Steffen Baranowsky 2019-2025.
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU Affero General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Affero General Public License for more details.
+
+You should have received a copy of the GNU Affero General Public License
+along with this program.  If not, see https://www.gnu.org/licenses/.
+
+==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <unordered_map>
+
+// Holds the parsed language file in memory so GUIHelpers::translate doesn't
+// have to read and parse it for every string. The table is built lazily on
+// the first lookup and only rebuilt when reload() is called.
+class TranslationCache
+{
+public:
+    TranslationCache() = default;
+
+    // Returns the translation for the given text, or the text itself if the
+    // current language has no entry for it.
+    juce::String translate(const juce::String &text, const std::function<juce::File()> &languageFileProvider);
+
+    // Drops the current table and parses the given language file. Pass an
+    // invalid file to fall back to untranslated strings.
+    void reload(const juce::File &languageFile);
+
+    void invalidate();
+
+    [[nodiscard]] juce::File getLanguageFile() const;
+
+private:
+    std::unordered_map<juce::String, juce::String> m_table;
+    juce::File m_languageFile;
+    bool m_isLoaded = false;
+    juce::CriticalSection m_lock;
+
+    JUCE_DECLARE_NON_COPYABLE(TranslationCache)
+};
@@ -32,7 +32,9 @@ along with this program.  If not, see https://www.gnu.org/licenses/.
 #include "Plugins/Saturation/NextSaturationPlugin.h"
 #include "Plugins/SimpleSynth/SimpleSynthPlugin.h"
 #include "Plugins/SpectrumAnalyzer/SpectrumAnalyzerPlugin.h"
+#include "Utilities/ClipEditBatch.h"
 #include "Utilities/EditViewState.h"
+#include "Utilities/IconCache.h"
 #include "juce_graphics/juce_graphics.h"
 #include "juce_graphics/native/juce_EventTracing.h"
 #include "tracktion_core/utilities/tracktion_Time.h"
@@ -458,20 +460,10 @@ void GUIHelpers::drawHeaderBox(juce::Graphics &g, juce::Rectangle<float> area, j
 
 void GUIHelpers::drawFromSvg(juce::Graphics &g, const char *svgbinary, juce::Colour newColour, juce::Rectangle<float> drawRect)
 {
-    if (auto svg = juce::XmlDocument::parse(svgbinary))
-    {
-        std::unique_ptr<juce::Drawable> drawable;
-        {
-            const juce::MessageManagerLock mmLock;
-            drawable = juce::Drawable::createFromSVG(*svg);
-        }
-        if (drawable != nullptr)
-        {
-            drawable->setTransformToFit(drawRect, juce::RectanglePlacement::centred);
-            drawable->replaceColour(juce::Colour(0xff626262), newColour);
-            drawable->draw(g, 2.f);
-        }
-    }
+    const auto pixelScale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+    if (auto image = IconCache::getInstance()->getImage(svgbinary, newColour, drawRect, pixelScale); image.isValid())
+        g.drawImage(image, drawRect, juce::RectanglePlacement::stretchToFit);
 }
 
 void GUIHelpers::setDrawableOnButton(juce::DrawableButton &button, const char *svgbinary, juce::Colour colour)
@@ -482,21 +474,8 @@ void GUIHelpers::setDrawableOnButton(juce::DrawableButton &button, const char *s
 
 std::unique_ptr<juce::Drawable> GUIHelpers::getDrawableFromSvg(const char *svgbinary, juce::Colour colour)
 {
-    if (auto svg = juce::XmlDocument::parse(svgbinary))
-    {
-        std::unique_ptr<juce::Drawable> drawable;
-        {
-            const juce::MessageManagerLock mmLock;
-            drawable = juce::Drawable::createFromSVG(*svg);
-        }
-
-        if (drawable != nullptr)
-        {
-            drawable->replaceColour(juce::Colour(0xff626262), colour);
-        }
-
-        return drawable;
-    }
+    if (auto drawable = IconCache::getInstance()->getDrawable(svgbinary, colour))
+        return drawable->createCopy();
 
     return nullptr;
 }
@@ -555,19 +534,7 @@ juce::MouseCursor GUIHelpers::getMouseCursorFromPng(const char *png, const int s
     return juce::MouseCursor(si, hotSpot);
 }
 
-juce::MouseCursor GUIHelpers::getMouseCursorFromSvg(const char *svgbinary, juce::Point<int> hotSpot, float scale)
-{
-    auto imageType = juce::Image::ARGB;
-    juce::Image image(imageType, 24 * scale, 24 * scale, true);
-    juce::Graphics g(image);
-
-    GUIHelpers::drawFromSvg(g, svgbinary, juce::Colours::white, {24 * scale, 24 * scale});
-
-    auto hotX = juce::jlimit(0, static_cast<int>(24 * scale) - 1, static_cast<int>(scale * hotSpot.getX()));
-    auto hotY = juce::jlimit(0, static_cast<int>(24 * scale) - 1, static_cast<int>(scale * hotSpot.getY()));
-
-    return juce::MouseCursor(image, hotX, hotY);
-}
+juce::MouseCursor GUIHelpers::getMouseCursorFromSvg(const char *svgbinary, juce::Point<int> hotSpot, float scale) { return IconCache::getInstance()->getMouseCursor(svgbinary, hotSpot, scale); }
 
 juce::Image GUIHelpers::drawableToImage(const juce::Drawable &drawable, float targetWidth, float targetHeight)
 {
@@ -896,13 +863,7 @@ void GUIHelpers::drawLogo(juce::Graphics &g, juce::Colour colour, float scale)
     g.fillPath(logoPath);
 }
 
-juce::String GUIHelpers::translate(juce::String stringToTranslate, ApplicationViewState &avs)
-{
-    juce::LocalisedStrings translations(avs.getFileToTranslation(), false);
-    auto translatedString = translations.translate(stringToTranslate);
-
-    return translatedString;
-}
+juce::String GUIHelpers::translate(juce::String stringToTranslate, ApplicationViewState &avs) { return avs.translate(stringToTranslate); }
 
 juce::String PlayHeadHelpers::timeToTimecodeString(double seconds)
 {
@@ -941,9 +902,11 @@ te::AudioTrack::Ptr EngineHelpers::getAudioTrack(te::Track::Ptr track, EditViewS
 bool EngineHelpers::renderToNewTrack(EditViewState &evs, juce::Array<tracktion_engine::Track *> tracksToRender, tracktion::TimeRange range)
 {
     auto sampleDir = juce::File(evs.m_applicationState.m_samplesDir);
-    auto renderFile = sampleDir.getNonexistentChildFile("render", ".wav");
 
-    juce::BigInteger tracksToDo{0};
+    RenderJobQueue::Request request;
+    request.description = "Render to new track";
+    request.destFile = sampleDir.getNonexistentChildFile("render", ".wav");
+    request.range = range;
 
     auto allTracks = te::getAllTracks(evs.m_edit);
 
@@ -951,12 +914,19 @@ bool EngineHelpers::renderToNewTrack(EditViewState &evs, juce::Array<tracktion_e
     {
         int index = allTracks.indexOf(trackToRender);
         if (index != -1)
-            tracksToDo.setBit(index);
+            request.tracksToDo.setBit(index);
     }
 
-    te::Renderer::renderToFile("Render", renderFile, evs.m_edit, range, tracksToDo);
+    if (request.tracksToDo.isZero())
+        return false;
 
-    EngineHelpers::loadAudioFileOnNewTrack(evs, renderFile, juce::Colours::plum, range.getStart().inSeconds());
+    request.onFinished = [&evs, range](const RenderJobQueue::Result &result)
+    {
+        if (result.succeeded)
+            EngineHelpers::loadAudioFileOnNewTrack(evs, result.file, juce::Colours::plum, range.getStart().inSeconds());
+    };
+
+    evs.m_renderJobQueue->addJob(std::move(request));
 
     return true;
 }
@@ -965,24 +935,235 @@ bool EngineHelpers::renderCliptoNewTrack(EditViewState &evs, te::Clip::Ptr clip)
 {
     auto range = clip->getEditTimeRange();
     auto index = te::getAllTracks(evs.m_edit).indexOf(clip->getTrack());
-    auto trackToRender = juce::BigInteger{index};
+
+    if (index < 0)
+        return false;
 
     auto sampleDir = juce::File(evs.m_applicationState.m_samplesDir);
-    auto renderFile = sampleDir.getNonexistentChildFile("render", ".wav");
 
-    te::Renderer::renderToFile("Render", renderFile, evs.m_edit, range, trackToRender);
+    RenderJobQueue::Request request;
+    request.description = "Render clip";
+    request.destFile = sampleDir.getNonexistentChildFile("render", ".wav");
+    request.range = range;
+    request.tracksToDo.setBit(index);
+    request.onFinished = [&evs, range](const RenderJobQueue::Result &result)
+    {
+        if (result.succeeded)
+            EngineHelpers::loadAudioFileOnNewTrack(evs, result.file, juce::Colours::plum, range.getStart().inSeconds());
+    };
+
+    evs.m_renderJobQueue->addJob(std::move(request));
+
+    return true;
+}
+
+// Volume, pan and meters stay live on a frozen track, the render is pre-fader
+static bool isPluginKeptWhileFrozen(te::Plugin &plugin)
+{
+    return dynamic_cast<te::VolumeAndPanPlugin *>(&plugin) != nullptr || dynamic_cast<te::LevelMeterPlugin *>(&plugin) != nullptr || dynamic_cast<te::AuxSendPlugin *>(&plugin) != nullptr;
+}
+
+// The cache file is named after everything that changes the rendered audio,
+// so an unchanged track finds its old render again. The plugins that stay
+// live and the mute button aren't part of the pre-fader render, moving a
+// fader doesn't make it stale.
+static juce::File getFreezeCacheFile(EditViewState &evs, te::AudioTrack &track)
+{
+    for (auto plugin : track.pluginList)
+        if (!isPluginKeptWhileFrozen(*plugin))
+            plugin->flushPluginStateToValueTree();
+
+    auto trackState = track.state.createCopy();
+    trackState.removeProperty(te::IDs::mute, nullptr);
+
+    for (auto plugin : track.pluginList)
+        if (isPluginKeptWhileFrozen(*plugin))
+            trackState.removeChild(trackState.getChildWithProperty(te::IDs::id, plugin->itemID.toString()), nullptr);
+
+    auto key = evs.m_edit.getProjectItemID().toString() + trackState.toXmlString() + evs.m_edit.tempoSequence.state.toXmlString();
+
+    return juce::File(evs.m_applicationState.m_renderDir).getChildFile("Freeze").getChildFile("freeze_" + juce::String::toHexString(key.hashCode64()) + ".wav");
+}
+
+static bool applyFreeze(EditViewState &evs, te::AudioTrack &track, const juce::File &file, tracktion::TimeRange range)
+{
+    te::AudioFile audioFile(evs.m_edit.engine, file);
+    if (!audioFile.isValid())
+    {
+        juce::Logger::writeToLog("Error: freezing " + track.getName() + " failed, can't read " + file.getFullPathName());
+        return false;
+    }
+
+    auto *um = &evs.m_edit.getUndoManager();
+    um->beginNewTransaction("Freeze Track");
+
+    te::ClipPosition pos;
+    pos.time = {range.getStart(), tracktion::TimeDuration::fromSeconds(audioFile.getLength())};
+
+    // the original clips stay where they are, muted, so unfreezing finds them again.
+    // The frozen clip goes in first, if that fails the track is left untouched.
+    auto frozenClip = track.insertWaveClip(track.getName() + " (frozen)", file, pos, false);
+    if (frozenClip == nullptr)
+    {
+        juce::Logger::writeToLog("Error: freezing " + track.getName() + " failed, couldn't insert the frozen clip");
+        return false;
+    }
+
+    frozenClip->setAutoTempo(false);
+    frozenClip->setAutoPitch(false);
+
+    juce::StringArray mutedClips, disabledPlugins;
+
+    for (auto clip : track.getClips())
+    {
+        if (clip == frozenClip.get())
+            continue;
+
+        if (!clip->isMuted())
+        {
+            clip->setMuted(true);
+            mutedClips.add(clip->itemID.toString());
+        }
+    }
+
+    for (auto plugin : track.pluginList)
+    {
+        if (plugin->isEnabled() && !isPluginKeptWhileFrozen(*plugin))
+        {
+            plugin->setEnabled(false);
+            disabledPlugins.add(plugin->itemID.toString());
+        }
+    }
 
-    EngineHelpers::loadAudioFileOnNewTrack(evs, renderFile, juce::Colours::plum, range.getStart().inSeconds());
+    track.state.setProperty(IDs::frozenClip, frozenClip->itemID.toString(), um);
+    track.state.setProperty(IDs::frozenMutedClips, mutedClips.joinIntoString(","), um);
+    track.state.setProperty(IDs::frozenDisabledPlugins, disabledPlugins.joinIntoString(","), um);
 
     return true;
 }
 
-void EngineHelpers::renderEditToFile(EditViewState &evs, juce::File renderFile, tracktion::TimeRange range)
+bool EngineHelpers::freezeTrack(EditViewState &evs, te::AudioTrack &track)
+{
+    if (isTrackFrozen(track) || isTrackFreezing(evs, track))
+        return false;
+
+    auto end = tracktion::TimePosition();
+
+    for (auto clip : track.getClips())
+        end = std::max(end, clip->getPosition().getEnd());
+
+    if (end == tracktion::TimePosition())
+        return false;
+
+    // leave room for reverb and delay tails
+    const tracktion::TimeRange range{tracktion::TimePosition(), end + tracktion::TimeDuration::fromSeconds(4.0)};
+    const auto cacheFile = getFreezeCacheFile(evs, track);
+
+    if (cacheFile.existsAsFile())
+    {
+        GUIHelpers::log("Freeze: using cached render " + cacheFile.getFullPathName());
+        return applyFreeze(evs, track, cacheFile, range);
+    }
+
+    auto index = te::getAllTracks(evs.m_edit).indexOf(&track);
+    if (index < 0)
+        return false;
+
+    RenderJobQueue::Request request;
+    request.description = "Freeze " + track.getName();
+    request.destFile = cacheFile;
+    request.range = range;
+    request.tracksToDo.setBit(index);
+    request.useMasterPlugins = false;
+
+    request.prepareEdit = [trackID = track.itemID](te::Edit &copy)
+    {
+        if (auto at = dynamic_cast<te::AudioTrack *>(te::findTrackForID(copy, trackID)))
+        {
+            at->setMute(false);
+
+            for (auto plugin : at->pluginList)
+                if (isPluginKeptWhileFrozen(*plugin))
+                    plugin->setEnabled(false);
+        }
+    };
+
+    request.onFinished = [&evs, trackID = track.itemID, range](const RenderJobQueue::Result &result)
+    {
+        auto at = dynamic_cast<te::AudioTrack *>(te::findTrackForID(evs.m_edit, trackID));
+
+        if (at == nullptr)
+            return;
+
+        at->state.removeProperty(IDs::freezeJobID, nullptr);
+
+        // the render belongs to the track as it was when the job started. It
+        // stays in the cache for that state, but an edited track isn't frozen.
+        if (result.succeeded && getFreezeCacheFile(evs, *at) != result.file)
+            GUIHelpers::log("Freeze: " + at->getName() + " changed while rendering, render discarded");
+        else if (result.succeeded)
+            applyFreeze(evs, *at, result.file, range);
+        else if (!result.wasCancelled)
+            juce::Logger::writeToLog("Error: freezing " + at->getName() + " failed: " + result.errorMessage);
+    };
+
+    auto jobID = evs.m_renderJobQueue->addJob(std::move(request));
+    track.state.setProperty(IDs::freezeJobID, jobID, nullptr);
+
+    return true;
+}
+
+void EngineHelpers::unfreezeTrack(EditViewState &evs, te::AudioTrack &track)
+{
+    if (!isTrackFrozen(track))
+        return;
+
+    auto *um = &evs.m_edit.getUndoManager();
+    um->beginNewTransaction("Unfreeze Track");
+
+    if (auto frozenClip = te::findClipForID(evs.m_edit, te::EditItemID::fromVar(track.state[IDs::frozenClip])))
+        frozenClip->removeFromParent();
+
+    for (auto &id : juce::StringArray::fromTokens(track.state[IDs::frozenMutedClips].toString(), ",", {}))
+        if (auto clip = te::findClipForID(evs.m_edit, te::EditItemID::fromVar(id)))
+            clip->setMuted(false);
+
+    auto disabledPlugins = juce::StringArray::fromTokens(track.state[IDs::frozenDisabledPlugins].toString(), ",", {});
+
+    for (auto plugin : track.pluginList)
+        if (disabledPlugins.contains(plugin->itemID.toString()))
+            plugin->setEnabled(true);
+
+    track.state.removeProperty(IDs::frozenClip, um);
+    track.state.removeProperty(IDs::frozenMutedClips, um);
+    track.state.removeProperty(IDs::frozenDisabledPlugins, um);
+}
+
+bool EngineHelpers::isTrackFrozen(const te::Track &track)
+{
+    return track.state.hasProperty(IDs::frozenClip);
+}
+
+bool EngineHelpers::isTrackFreezing(EditViewState &evs, const te::Track &track)
+{
+    if (!track.state.hasProperty(IDs::freezeJobID))
+        return false;
+
+    const int jobID = track.state[IDs::freezeJobID];
+
+    for (auto &info : evs.m_renderJobQueue->getJobInfos())
+        if (info.jobID == jobID)
+            return true;
+
+    return false;
+}
+
+int EngineHelpers::renderEditToFile(EditViewState &evs, juce::File renderFile, tracktion::TimeRange range, double sampleRate, int bitDepth)
 {
     if (!renderFile.create())
     {
         juce::Logger::writeToLog("Error: Could not create file. Check permissions.");
-        return;
+        return 0;
     }
     else
     {
@@ -995,16 +1176,130 @@ void EngineHelpers::renderEditToFile(EditViewState &evs, juce::File renderFile,
     if (te::getAudioTracks(evs.m_edit).size() == 0)
     {
         juce::Logger::writeToLog("Error: The edit contains no tracks.");
-        return;
+        return 0;
     }
 
-    juce::BigInteger tracksToDo{0};
+    RenderJobQueue::Request request;
+    request.description = "Render " + renderFile.getFileName();
+    request.destFile = renderFile;
+    request.range = range;
+    request.sampleRate = sampleRate;
+    request.bitDepth = bitDepth;
+    request.writeLoudnessReport = true;
+    if (renderFile.hasFileExtension(".flac"))
+        request.audioFormat = evs.m_edit.engine.getAudioFileFormatManager().getFlacFormat();
 
     for (auto i = 0; i < te::getAllTracks(evs.m_edit).size(); ++i)
-        tracksToDo.setBit(i);
+        request.tracksToDo.setBit(i);
+
+    return evs.m_renderJobQueue->addJob(std::move(request));
+}
+
+int EngineHelpers::renderStemsToFolder(EditViewState &evs, const juce::File &folder, const juce::String &baseName, const juce::Array<te::Track *> &tracks, tracktion::TimeRange range, bool useFlac, bool includeMaster, double sampleRate, int bitDepth)
+{
+    if (!folder.createDirectory())
+    {
+        juce::Logger::writeToLog("Error: Could not create folder " + folder.getFullPathName());
+        return 0;
+    }
+
+    // every stem gets the same range, so they line up when imported elsewhere
+    if (range == tracktion::TimeRange{})
+        range = {tracktion::TimePosition::fromSeconds(0.0), evs.m_edit.getLength()};
+
+    auto &engine = evs.m_edit.engine;
+    auto *format = useFlac ? engine.getAudioFileFormatManager().getFlacFormat() : engine.getAudioFileFormatManager().getWavFormat();
+    auto suffix = useFlac ? juce::String(".flac") : juce::String(".wav");
+    auto allTracks = te::getAllTracks(evs.m_edit);
+
+    auto &queue = *evs.m_renderJobQueue;
+    const auto maxConcurrentStems = juce::jmax(1, juce::SystemStats::getNumCpus() / 2);
+
+    auto addStem = [&](const juce::String &stemName, const juce::BigInteger &tracksToDo, bool useMasterPlugins)
+    {
+        RenderJobQueue::Request request;
+        request.description = "Stem " + stemName;
+        request.destFile = folder.getNonexistentChildFile(baseName + "_" + juce::File::createLegalFileName(stemName), suffix, false);
+        request.range = range;
+        request.tracksToDo = tracksToDo;
+        request.useMasterPlugins = useMasterPlugins;
+        request.audioFormat = format;
+        request.sampleRate = sampleRate;
+        request.bitDepth = bitDepth;
+        request.maxConcurrentJobs = maxConcurrentStems;
+        queue.addJob(std::move(request));
+    };
+
+    int numStems = 0;
+
+    for (auto *track : tracks)
+    {
+        juce::BigInteger tracksToDo;
 
-    te::Renderer::renderToFile("Render", renderFile, evs.m_edit, range, tracksToDo);
+        if (auto index = allTracks.indexOf(track); index != -1)
+            tracksToDo.setBit(index);
+
+        // a folder stem is the sum of everything inside it
+        if (auto ft = dynamic_cast<te::FolderTrack *>(track))
+            for (auto *sub : ft->getAllSubTracks(true))
+                if (auto index = allTracks.indexOf(sub); index != -1)
+                    tracksToDo.setBit(index);
+
+        if (tracksToDo.isZero())
+            continue;
+
+        ++numStems;
+        addStem(juce::String(numStems).paddedLeft('0', 2) + "_" + track->getName(), tracksToDo, false);
+    }
+
+    if (includeMaster)
+    {
+        juce::BigInteger tracksToDo;
+        tracksToDo.setRange(0, allTracks.size(), true);
+        addStem("Master", tracksToDo, true);
+        ++numStems;
+    }
+
+    return numStems;
 }
+
+juce::Array<te::Track *> EngineHelpers::getTracksForStemExport(te::Edit &edit, juce::Array<te::Track *> tracks)
+{
+    if (tracks.isEmpty())
+    {
+        for (auto *t : te::getAllTracks(edit))
+            if (t->isAudioTrack() || t->isFolderTrack())
+                tracks.add(t);
+    }
+
+    // a track inside a listed folder would end up in two stems
+    juce::Array<te::Track *> stemTracks;
+    for (auto *t : tracks)
+    {
+        bool isInListedFolder = false;
+        for (auto *parent = t->getParentFolderTrack(); parent != nullptr; parent = parent->getParentFolderTrack())
+            isInListedFolder = isInListedFolder || tracks.contains(parent);
+
+        if (!isInListedFolder)
+            stemTracks.add(t);
+    }
+
+    return stemTracks;
+}
+
+void EngineHelpers::registerBuiltInPlugins(te::Engine &engine)
+{
+    engine.getPluginManager().createBuiltInType<SimpleSynthPlugin>();
+    engine.getPluginManager().createBuiltInType<ArpeggiatorPlugin>();
+    engine.getPluginManager().createBuiltInType<SpectrumAnalyzerPlugin>();
+    engine.getPluginManager().createBuiltInType<PeakLimiterPlugin>();
+    engine.getPluginManager().createBuiltInType<NextDelayPlugin>();
+    engine.getPluginManager().createBuiltInType<NextChorusPlugin>();
+    engine.getPluginManager().createBuiltInType<NextPhaserPlugin>();
+    engine.getPluginManager().createBuiltInType<NextSaturationPlugin>();
+    engine.getPluginManager().createBuiltInType<NextFilterPlugin>();
+}
+
 void EngineHelpers::setMidiInputFocusToSelection(EditViewState &evs)
 {
     auto &dm = evs.m_edit.engine.getDeviceManager();
@@ -1145,6 +1440,8 @@ te::MidiInputDevice *EngineHelpers::getVirtualMidiInputDevice(te::Edit &edit)
 tracktion::core::TimePosition EngineHelpers::getTimePos(double t) { return tracktion::core::TimePosition::fromSeconds(t); }
 void EngineHelpers::deleteSelectedClips(EditViewState &evs)
 {
+    ClipEditBatch batch(evs, "Delete Clips");
+
     for (auto selectedClip : evs.m_selectionManager.getSelectedObjects().getItemsOfType<te::Clip>())
     {
         if (selectedClip->getTrack() != nullptr)
@@ -1245,88 +1542,13 @@ double EngineHelpers::getNoteEndBeat(const te::MidiClip *midiClip, const te::Mid
 
 bool EngineHelpers::isTrackItemInRange(te::TrackItem *ti, const tracktion::TimeRange &tr) { return ti->getEditTimeRange().intersects(tr); }
 
-juce::ValueTree exportPluginStates(const tracktion::engine::PluginList &pluginList)
-{
-    juce::ValueTree pluginsTree("Plugins");
-
-    for (auto *plugin : pluginList.getPlugins())
-    {
-        if (plugin != nullptr)
-        {
-            // Create a copy of the plugin's state and add it to the tree
-            pluginsTree.appendChild(plugin->state.createCopy(), nullptr);
-        }
-    }
-
-    return pluginsTree;
-}
-
-void storePluginStatesAndClear(juce::Array<te::Track *> &involvedTracks, juce::Array<juce::ValueTree> &states, const juce::Array<te::Clip *> &selectedClips, int verticalOffset)
-{
-    for (const auto &selectedClip : selectedClips)
-    {
-        if (auto *sourceTrack = selectedClip->getTrack())
-        {
-            if (auto *targetTrack = EngineHelpers::getTargetTrack(sourceTrack, verticalOffset))
-            {
-                for (auto *track : {sourceTrack, targetTrack})
-                {
-                    if (involvedTracks.addIfNotAlreadyThere(track))
-                    {
-                        juce::ValueTree exportedState = exportPluginStates(track->pluginList);
-                        if (!exportedState.isValid())
-                        {
-                            GUIHelpers::log("Warning: Plugin state export failed for track " + track->getName());
-                        }
-                        states.add(exportedState);
-                        track->pluginList.clear();
-                    }
-                }
-            }
-            else
-            {
-                GUIHelpers::log("Warning: Target track not found for source track " + sourceTrack->getName());
-            }
-        }
-        else
-        {
-            GUIHelpers::log("Warning: Selected clip has no valid source track!");
-        }
-    }
-
-    jassert(involvedTracks.size() == states.size());
-    GUIHelpers::log("Stored states: " + juce::String(states.size()));
-    GUIHelpers::log("Stored tracks: " + juce::String(involvedTracks.size()));
-}
-
-void restorePluginStates(const juce::Array<te::Track *> &involvedTracks, const juce::Array<juce::ValueTree> &states)
-{
-    for (auto i = 0; i < involvedTracks.size(); i++)
-    {
-        involvedTracks[i]->pluginList.addPluginsFrom(states[i], true, false);
-    }
-
-    jassert(involvedTracks.size() == states.size());
-    GUIHelpers::log("Restored plugins. Tracks involved: " + juce::String(involvedTracks.size()));
-}
-
 void EngineHelpers::moveSelectedClips(bool copy, double timeDelta, int verticalOffset, EditViewState &evs)
 {
     // If not copying and no movement occurred, return early to avoid unnecessary processing
     if (!copy && std::abs(timeDelta) < 1.0e-9 && verticalOffset == 0)
         return;
 
-    //---------------------------------------------------
-    // when we insert a clip on a track with a plugin with a lot of parameters
-    // the needed time is much more higher than a track without a plugin.
-    // If you have to duplicate a lot of clips, this could take a lot of time.
-    // So this approach removes all plugins and save them in a value tree. After
-    // moving or coping the clips, we reinsert the plugins from the state
-    // The time is reduced a lot, but I don't know, if this is the best approach.
-    //---------------------------------------------------
-    bool testOptimisation = false;
-    testOptimisation = true;
-    //---------------------------------------------------
+    ClipEditBatch batch(evs, copy ? "Copy Clips" : "Move Clips");
 
     if (verticalOffset == 0)
         copyAutomationForSelectedClips(timeDelta, evs.m_selectionManager, copy);
@@ -1334,11 +1556,6 @@ void EngineHelpers::moveSelectedClips(bool copy, double timeDelta, int verticalO
     auto selectedClips = evs.m_selectionManager.getItemsOfType<te::Clip>();
     auto tempPosition = evs.m_edit.getLength().inSeconds() + timeDelta;
 
-    auto involvedTracks = juce::Array<te::Track *>();
-    auto states = juce::Array<juce::ValueTree>();
-    if (testOptimisation == true)
-        storePluginStatesAndClear(involvedTracks, states, selectedClips, verticalOffset);
-
     juce::Array<te::Clip *> newClips;
 
     for (auto selectedClip : selectedClips)
@@ -1377,9 +1594,6 @@ void EngineHelpers::moveSelectedClips(bool copy, double timeDelta, int verticalO
             }
         }
     }
-
-    if (testOptimisation)
-        restorePluginStates(involvedTracks, states);
 }
 
 void EngineHelpers::duplicateSelectedClips(EditViewState &evs) { moveSelectedClips(true, getTimeRangeOfSelectedClips(evs).getLength().inSeconds(), 0, evs); }
@@ -1392,12 +1606,14 @@ void EngineHelpers::copyAutomationForSelectedClips(double offset, te::SelectionM
         return;
 
     juce::Array<te::TrackAutomationSection> sections;
+    sections.ensureStorageAllocated(clipSelection.size());
 
     for (const auto &selectedClip : clipSelection)
         if (selectedClip->getTrack() != nullptr)
             sections.add(te::TrackAutomationSection(*selectedClip));
 
-    te::moveAutomation(sections, tracktion::TimeDuration::fromSeconds(offset), copy);
+    // one bulk move, the sections of neighbouring clips are merged first
+    moveAutomationOrCopy(sections, tracktion::TimeDuration::fromSeconds(offset), copy);
 }
 
 void EngineHelpers::selectAllClips(te::SelectionManager &sm, te::Edit &edit)
@@ -1438,25 +1654,77 @@ static tracktion::AutomationCurve *getDestCurve(tracktion::Track &t, const track
 
     return {};
 }
-static bool mergeInto(const tracktion::TrackAutomationSection &s, juce::Array<tracktion::TrackAutomationSection> &dst)
+// index of the last point at or before t, like AutomationCurve::indexBefore
+// but with a binary search, the points of a curve are sorted by time
+static int pointIndexAtOrBefore(const tracktion::AutomationCurve &curve, tracktion::TimePosition t)
 {
-    for (auto &dstSeg : dst)
+    int low = 0, high = curve.getNumPoints();
+
+    while (low < high)
     {
-        if (dstSeg.overlaps(s))
-        {
-            dstSeg.mergeIn(s);
-            return true;
-        }
+        auto mid = (low + high) / 2;
+
+        if (curve.getPointTime(mid) <= t)
+            low = mid + 1;
+        else
+            high = mid;
     }
 
-    return false;
+    return low - 1;
 }
 
-static void mergeSections(const juce::Array<tracktion::TrackAutomationSection> &src, juce::Array<tracktion::TrackAutomationSection> &dst)
+// index of the first point at or after t, or the number of points if there
+// is none
+static int firstPointIndexAtOrAfter(const tracktion::AutomationCurve &curve, tracktion::TimePosition t)
 {
-    for (const auto &srcSeg : src)
-        if (!mergeInto(srcSeg, dst))
-            dst.add(srcSeg);
+    int low = 0, high = curve.getNumPoints();
+
+    while (low < high)
+    {
+        auto mid = (low + high) / 2;
+
+        if (curve.getPointTime(mid) < t)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
+// Merges the overlapping sections of each source/destination track pair.
+// Sorted by track pair and start, every section only has to be compared with
+// the last merged one instead of with all sections merged so far, and
+// sections joined by a later merge end up in one section as well.
+static juce::Array<tracktion::TrackAutomationSection> mergeSections(const juce::Array<tracktion::TrackAutomationSection> &src)
+{
+    std::vector<const tracktion::TrackAutomationSection *> sorted;
+    sorted.reserve(static_cast<size_t>(src.size()));
+
+    for (const auto &section : src)
+        sorted.push_back(&section);
+
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const auto *a, const auto *b)
+                     {
+                         if (a->src != b->src)
+                             return std::less<>()(a->src.get(), b->src.get());
+                         if (a->dst != b->dst)
+                             return std::less<>()(a->dst.get(), b->dst.get());
+                         return a->position.getStart() < b->position.getStart();
+                     });
+
+    juce::Array<tracktion::TrackAutomationSection> merged;
+
+    for (auto *section : sorted)
+    {
+        if (!merged.isEmpty() && merged.getReference(merged.size() - 1).overlaps(*section))
+            merged.getReference(merged.size() - 1).mergeIn(*section);
+        else
+            merged.add(*section);
+    }
+
+    return merged;
 }
 
 void EngineHelpers::moveAutomationOrCopy(const juce::Array<tracktion::TrackAutomationSection> &origSections, tracktion::TimeDuration offset, bool copy)
@@ -1464,33 +1732,69 @@ void EngineHelpers::moveAutomationOrCopy(const juce::Array<tracktion::TrackAutom
     if (origSections.isEmpty())
         return;
 
-    juce::Array<tracktion::TrackAutomationSection> sections;
-    mergeSections(origSections, sections);
+    auto sections = mergeSections(origSections);
+
+    // find all the original curves, a parameter is only copied once no matter
+    // how many sections it is part of
+    std::map<tracktion::AutomatableParameter *, juce::ValueTree> originalCurves;
 
-    // find all the original curves
     for (auto &&section : sections)
     {
         for (auto &ap : section.activeParameters)
-            ap.curve.state = ap.curve.state.createCopy();
+        {
+            auto &original = originalCurves[ap.param.get()];
+
+            if (!original.isValid())
+                original = ap.curve.state.createCopy();
+
+            ap.curve.state = original;
+        }
     }
 
+    // All sections are applied to detached copies of the curves they touch.
+    // Each live curve is written back once at the end, so moving or copying
+    // the whole selection is one region change per curve instead of a series
+    // of removes and adds for every section.
+    struct WorkingCurve
+    {
+        tracktion::AutomationCurve curve;
+        tracktion::TimeRange editedRange;
+    };
+
+    std::map<tracktion::AutomationCurve *, std::unique_ptr<WorkingCurve>> workingCurves;
+
+    auto getWorkingCurve = [&workingCurves](tracktion::AutomationCurve &liveCurve, tracktion::TimeRange editedRange) -> tracktion::AutomationCurve &
+    {
+        auto &working = workingCurves[&liveCurve];
+
+        if (working == nullptr)
+        {
+            working = std::make_unique<WorkingCurve>(WorkingCurve{liveCurve, editedRange});
+            working->curve.state = liveCurve.state.createCopy();
+        }
+        else
+        {
+            working->editedRange = working->editedRange.getUnionWith(editedRange);
+        }
+
+        return working->curve;
+    };
+
     // delete all the old curves
     if (!copy)
     {
         for (auto &section : sections)
         {
-            auto sectionTime = section.position;
-
-            for (auto &&activeParam : section.activeParameters)
+            for (auto &activeParam : section.activeParameters)
             {
-                auto param = activeParam.param;
-                auto &curve = param->getCurve();
+                auto sectionTime = section.position;
                 constexpr auto tolerance = tracktion::TimeDuration::fromSeconds(0.0001);
+                auto &curve = getWorkingCurve(activeParam.param->getCurve(), sectionTime.expanded(tolerance));
 
                 auto startValue = curve.getValueAt(sectionTime.getStart() - tolerance);
                 auto endValue = curve.getValueAt(sectionTime.getEnd() + tolerance);
 
-                auto idx = curve.indexBefore(sectionTime.getEnd() + tolerance);
+                auto idx = pointIndexAtOrBefore(curve, sectionTime.getEnd() + tolerance);
                 auto endCurve = (idx == -1) ? 0.0f : curve.getPointCurve(idx);
 
                 curve.removePointsInRegion(sectionTime.expanded(tolerance));
@@ -1523,70 +1827,109 @@ void EngineHelpers::moveAutomationOrCopy(const juce::Array<tracktion::TrackAutom
     {
         for (auto &activeParam : section.activeParameters)
         {
+            auto liveDstCurve = (section.src == section.dst) ? &activeParam.param->getCurve() : getDestCurve(*section.dst, activeParam.param);
+
+            if (liveDstCurve == nullptr)
+                continue;
+
             auto sectionTime = section.position;
+            constexpr auto errorMargin = tracktion::TimeDuration::fromSeconds(0.0001);
+
+            auto start = sectionTime.getStart();
+            auto end = sectionTime.getEnd();
+            auto newStart = start + offset;
+            auto newEnd = end + offset;
+
+            tracktion::TimeRange totalRegionWithMargin(newStart - errorMargin, newEnd + errorMargin);
+            tracktion::TimeRange startWithMargin(newStart - errorMargin, newStart + errorMargin);
+            tracktion::TimeRange endWithMargin(newEnd - errorMargin, newEnd + errorMargin);
 
-            if (auto dstCurve = (section.src == section.dst) ? &activeParam.param->getCurve() : getDestCurve(*section.dst, activeParam.param))
+            auto dstCurve = &getWorkingCurve(*liveDstCurve, totalRegionWithMargin);
+            auto &srcCurve = activeParam.curve;
+
+            auto idx1 = pointIndexAtOrBefore(srcCurve, newEnd + errorMargin);
+            auto endCurve = idx1 < 0 ? 0 : srcCurve.getPointCurve(idx1);
+
+            auto idx2 = pointIndexAtOrBefore(srcCurve, start - errorMargin);
+            auto startCurve = idx2 < 0 ? 0 : srcCurve.getPointCurve(idx2);
+
+            auto srcStartVal = srcCurve.getValueAt(start - errorMargin);
+            auto srcEndVal = srcCurve.getValueAt(end + errorMargin);
+
+            auto dstStartVal = dstCurve->getValueAt(newStart - errorMargin);
+            auto dstEndVal = dstCurve->getValueAt(newEnd + errorMargin);
+
+            juce::Array<tracktion::AutomationCurve::AutomationPoint> origPoints;
+
+            for (int i = firstPointIndexAtOrAfter(srcCurve, start - errorMargin); i < srcCurve.getNumPoints(); ++i)
             {
-                constexpr auto errorMargin = tracktion::TimeDuration::fromSeconds(0.0001);
+                auto pt = srcCurve.getPoint(i);
 
-                auto start = sectionTime.getStart();
-                auto end = sectionTime.getEnd();
-                auto newStart = start + offset;
-                auto newEnd = end + offset;
+                if (pt.time > end + errorMargin)
+                    break;
 
-                auto &srcCurve = activeParam.curve;
+                origPoints.add(pt);
+            }
 
-                auto idx1 = srcCurve.indexBefore(newEnd + errorMargin);
-                auto endCurve = idx1 < 0 ? 0 : srcCurve.getPointCurve(idx1);
+            dstCurve->removePointsInRegion(totalRegionWithMargin);
 
-                auto idx2 = srcCurve.indexBefore(start - errorMargin);
-                auto startCurve = idx2 < 0 ? 0 : srcCurve.getPointCurve(idx2);
+            for (const auto &pt : origPoints)
+                dstCurve->addPoint(pt.time + offset, pt.value, pt.curve);
 
-                auto srcStartVal = srcCurve.getValueAt(start - errorMargin);
-                auto srcEndVal = srcCurve.getValueAt(end + errorMargin);
+            auto startPoints = dstCurve->getPointsInRegion(startWithMargin);
+            auto endPoints = dstCurve->getPointsInRegion(endWithMargin);
 
-                auto dstStartVal = dstCurve->getValueAt(newStart - errorMargin);
-                auto dstEndVal = dstCurve->getValueAt(newEnd + errorMargin);
+            dstCurve->removePointsInRegion(startWithMargin);
+            dstCurve->removePointsInRegion(endWithMargin);
 
-                tracktion::TimeRange totalRegionWithMargin(newStart - errorMargin, newEnd + errorMargin);
-                tracktion::TimeRange startWithMargin(newStart - errorMargin, newStart + errorMargin);
-                tracktion::TimeRange endWithMargin(newEnd - errorMargin, newEnd + errorMargin);
+            dstCurve->addPoint(newStart, dstStartVal, startCurve);
+            dstCurve->addPoint(newStart, srcStartVal, startCurve);
 
-                juce::Array<tracktion::AutomationCurve::AutomationPoint> origPoints;
+            for (auto &point : startPoints)
+                dstCurve->addPoint(newStart, point.value, point.curve);
 
-                for (int i = 0; i < srcCurve.getNumPoints(); ++i)
-                {
-                    auto pt = srcCurve.getPoint(i);
+            for (auto &point : endPoints)
+                dstCurve->addPoint(newEnd, point.value, point.curve);
 
-                    if (pt.time >= start - errorMargin && pt.time <= sectionTime.getEnd() + errorMargin)
-                        origPoints.add(pt);
-                }
+            dstCurve->addPoint(newEnd, srcEndVal, endCurve);
+            dstCurve->addPoint(newEnd, dstEndVal, endCurve);
 
-                dstCurve->removePointsInRegion(totalRegionWithMargin);
+            dstCurve->removeRedundantPoints(totalRegionWithMargin);
+        }
+    }
 
-                for (const auto &pt : origPoints)
-                    dstCurve->addPoint(pt.time + offset, pt.value, pt.curve);
+    // write every edited curve back in one batch, the edited range is widened
+    // so that the points on its bounds are the same in the working copy and
+    // the live curve
+    for (auto &[liveCurve, working] : workingCurves)
+    {
+        constexpr auto margin = tracktion::TimeDuration::fromSeconds(0.0001);
+        auto region = working->editedRange.expanded(margin);
+        auto &result = working->curve;
 
-                auto startPoints = dstCurve->getPointsInRegion(startWithMargin);
-                auto endPoints = dstCurve->getPointsInRegion(endWithMargin);
+        auto first = firstPointIndexAtOrAfter(result, region.getStart());
+        auto last = pointIndexAtOrBefore(result, region.getEnd());
 
-                dstCurve->removePointsInRegion(startWithMargin);
-                dstCurve->removePointsInRegion(endWithMargin);
+        liveCurve->removePointsInRegion(region);
 
-                dstCurve->addPoint(newStart, dstStartVal, startCurve);
-                dstCurve->addPoint(newStart, srcStartVal, startCurve);
+        auto isStillThere = [&liveCurve](tracktion::TimePosition t)
+        {
+            auto index = firstPointIndexAtOrAfter(*liveCurve, t);
+            return index < liveCurve->getNumPoints() && liveCurve->getPointTime(index) == t;
+        };
 
-                for (auto &point : startPoints)
-                    dstCurve->addPoint(newStart, point.value, point.curve);
+        const auto keepStart = isStillThere(region.getStart());
+        const auto keepEnd = isStillThere(region.getEnd());
 
-                for (auto &point : endPoints)
-                    dstCurve->addPoint(newEnd, point.value, point.curve);
+        for (int i = first; i <= last; ++i)
+        {
+            auto pt = result.getPoint(i);
 
-                dstCurve->addPoint(newEnd, srcEndVal, endCurve);
-                dstCurve->addPoint(newEnd, dstEndVal, endCurve);
+            // points on a bound the region didn't include were never removed
+            if ((keepStart && pt.time == region.getStart()) || (keepEnd && pt.time == region.getEnd()))
+                continue;
 
-                dstCurve->removeRedundantPoints(totalRegionWithMargin);
-            }
+            liveCurve->addPoint(pt.time, pt.value, pt.curve);
         }
     }
 
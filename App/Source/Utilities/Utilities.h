@@ -96,6 +96,7 @@ enum KeyPressCommandIDs
     duplicateSelectedTracks,
 
     renderSelectedTimeRangeToNewTrack,
+    reduceSelectedAutomation,
 
     deleteSelectedNotes,
     duplicateSelectedNotes,
@@ -271,9 +272,30 @@ enum class PluginInsertResult
     invalidInput
 };
 
-void renderEditToFile(EditViewState &evs, juce::File renderFile, tracktion::TimeRange range = {});
+// The render functions queue a job on the RenderJobQueue of the EditViewState
+// and return immediately. renderEditToFile returns the id of the job, 0 on error.
+// A sample rate of 0 renders at the device rate. renderEditToFile also writes
+// a loudness report next to the file, see RenderJobQueue::getLoudnessReportFile.
+int renderEditToFile(EditViewState &evs, juce::File renderFile, tracktion::TimeRange range = {}, double sampleRate = 0.0, int bitDepth = 24);
 bool renderCliptoNewTrack(EditViewState &evs, te::Clip::Ptr clip);
 bool renderToNewTrack(EditViewState &evs, juce::Array<tracktion_engine::Track *> tracksToRender, tracktion::TimeRange range);
+// Freezing renders the track pre-fader (clips, instrument and plugins) on the
+// render queue, then disables the track's plugins, mutes its clips and plays
+// the rendered file from a clip instead. The file is cached, freezing an
+// unchanged track again reuses it. A track that was edited while its render
+// was running isn't frozen. Unfreezing restores the previous state.
+bool freezeTrack(EditViewState &evs, te::AudioTrack &track);
+void unfreezeTrack(EditViewState &evs, te::AudioTrack &track);
+bool isTrackFrozen(const te::Track &track);
+bool isTrackFreezing(EditViewState &evs, const te::Track &track);
+// Queues one render job per track (folder tracks include their sub tracks)
+// and optionally the full mix. Jobs run in parallel. Returns the number of stems.
+int renderStemsToFolder(EditViewState &evs, const juce::File &folder, const juce::String &baseName, const juce::Array<te::Track *> &tracks, tracktion::TimeRange range, bool useFlac, bool includeMaster, double sampleRate = 0.0, int bitDepth = 24);
+// Returns the given tracks without the ones that live inside one of the given
+// folder tracks. If the list is empty, all audio and folder tracks of the edit
+// are used.
+juce::Array<te::Track *> getTracksForStemExport(te::Edit &edit, juce::Array<te::Track *> tracks);
+void registerBuiltInPlugins(te::Engine &engine);
 
 void setMidiInputFocusToSelection(EditViewState &evs);
 te::MidiInputDevice *getVirtualMidiInputDevice(te::Edit &edit);